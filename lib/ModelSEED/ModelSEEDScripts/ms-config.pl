@@ -112,7 +112,8 @@ my ($Config,$extension,$arguments,$delim,$os,$configFile);
 	foreach my $path ( 
 	    qw( Optional=dataDirectory Optimizers=includeDirectoryGLPK Optimizers=libraryDirectoryGLPK
 	        Optimizers=libraryDirectoryCPLEX Optimizers=licenseDirectoryCPLEX
-	        Optimizers=licenseDirectoryCPLEX )) {
+	        Optimizers=licenseDirectoryCPLEX Optimizers=includeDirectorySCIP
+	        Optimizers=libraryDirectorySCIP )) {
 	    my ($section, $name) = split(/=/, $path);
 	    if(defined($Config->{$section}->{$name})) {
 	        $Config->{$section}->{$name} = abs_path($Config->{$section}->{$name});
@@ -176,6 +177,7 @@ my ($Config,$extension,$arguments,$delim,$os,$configFile);
     $envSettings->{FIGMODEL_USER} = $ENV{FIGMODEL_USER};
     $envSettings->{FIGMODEL_PASSWORD} = $ENV{FIGMODEL_PASSWORD};
     $envSettings->{CPLEXAPI} = "CPLEXapiEMPTY.cpp";
+    $envSettings->{SCIPAPI} = "SCIPapi.cpp";
     $envSettings->{MFATOOLKITCCFLAGS} = "-O3 -fPIC -fexceptions -DNDEBUG -DIL_STD -DILOSTRICTPOD -DLINUX -I../Include/ -DNOSAFEMEM -DNOBLOCKMEM";    
     $envSettings->{MFATOOLKITCCLNFLAGS} = "";
     if(defined($Config->{Optimizers}->{includeDirectoryGLPK})) {
@@ -193,6 +195,14 @@ my ($Config,$extension,$arguments,$delim,$os,$configFile);
     	 	$envSettings->{MFATOOLKITCCLNFLAGS} .= " -framework CoreFoundation -framework IOKit";
     	 }
     }
+    # Linking the SCIP optimization suite runs SCIP in process instead of through the scip executable
+    if (defined($Config->{Optimizers}->{includeDirectorySCIP}) && defined($Config->{Optimizers}->{libraryDirectorySCIP})) {
+    	$envSettings->{MFATOOLKITCCFLAGS} .= " -I".$Config->{Optimizers}->{includeDirectorySCIP};
+    	$envSettings->{MFATOOLKITCCLNFLAGS} .= " -L".$Config->{Optimizers}->{libraryDirectorySCIP}." -lscipopt -lz -lgmp -lreadline";
+    	$envSettings->{SCIPAPI} = "FullSCIPapi.cpp";
+    }
+    # The error log is written by a background thread
+    $envSettings->{MFATOOLKITCCLNFLAGS} .= " -lpthread";
     my $bootstrap = "";
     foreach my $lib (@$perl5Libs) {
         $bootstrap .= "use lib '$lib';\n";
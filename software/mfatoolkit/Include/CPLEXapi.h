@@ -23,22 +23,28 @@
 
 int InitializeCPLEXVariables();
 
-int CPLEXInitialize();
+int CPLEXInitialize(SolverContext* Context);
 
-int CPLEXCleanup();
+int CPLEXCleanup(SolverContext* Context);
 
-int CPLEXClearSolver();
+int CPLEXClearSolver(SolverContext* Context);
 
-int CPLEXPrintFromSolver();
+int CPLEXPrintFromSolver(SolverContext* Context);
 
-OptSolutionData* CPLEXRunSolver(int ProbType);
+OptSolutionData* CPLEXRunSolver(SolverContext* Context, int ProbType);
 
-int CPLEXLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
+int CPLEXLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
 
-int CPLEXLoadObjective(LinEquation* InEquation, bool Max);
+int CPLEXLoadProblem(SolverContext* Context, SolverMatrix* InMatrix);
 
-int CPLEXAddConstraint(LinEquation* InEquation);
+int CPLEXLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max);
 
-int CPLEXDelConstraint(LinEquation* InEquation);
+int CPLEXAddConstraint(SolverContext* Context, LinEquation* InEquation);
+
+int CPLEXDelConstraint(SolverContext* Context, LinEquation* InEquation);
+
+int CPLEXSaveBasis(SolverContext* Context, SolverBasis* OutBasis);
+
+int CPLEXLoadBasis(SolverContext* Context, SolverBasis* InBasis);
 
 #endif
\ No newline at end of file
@@ -27,20 +27,16 @@ struct Pathway;
 class Gene;
 class GeneInterval;
 struct OptimizationParameter;
+struct ReactionCacheEntry;
 
 #include "Identity.h"
 
 class Data : public Identity  {
 private:
-	int LastSpeciesIndex;
-	int LastReactionIndex;
-	int LastGeneIndex;
-	list<Reaction*>::iterator ReactionIT;
-	list<Species*>::iterator SpeciesIT;
-	list<Gene*>::iterator GeneIT;
-	list<Reaction*> ReactionList;
-	list<Species*> SpeciesList;
-	list<Gene*> GeneList;
+	//Indexed storage so the Get functions are constant time for any access order; the objects themselves are never moved
+	vector<Reaction*> ReactionList;
+	vector<Species*> SpeciesList;
+	vector<Gene*> GeneList;
 
 	Species* HydrogenSpecies;
 
@@ -59,6 +55,22 @@ private:
 	map<string, map<string, Species*, std::less<string> >, std::less<string> > CueDatabaseLinks;
 	map<string, map<string, Gene*, std::less<string> >, std::less<string> > GeneDatabaseLinks;
 	map<string, GeneInterval*, std::less<string> > IntervalNameMap;
+
+	//Gene logic of every reaction compiled into one program; reaction i owns instructions GeneLogicStart[i] to GeneLogicStart[i+1]
+	vector<int> GeneLogicProgram;
+	vector<int> GeneLogicStart;
+	int CompiledGeneCount;
+	bool CompiledNewGeneHandling;
+	//Bumped by every change to a reaction's gene logic or to the reaction list; the compiled program is rebuilt when it no longer matches
+	int GeneLogicVersion;
+	int CompiledGeneLogicVersion;
+
+	//Processed database reactions keyed by ID; ReactionCacheFilename is empty while the cache is off
+	map<string, ReactionCacheEntry*, std::less<string> > ReactionCache;
+	string ReactionCacheFilename;
+	bool ReactionCacheChanged;
+	unsigned long long ReactionCacheKey;
+	unsigned long long ComputeReactionCacheKey();
 public:
 	Data(int InIndex);
 	~Data();
@@ -66,6 +78,16 @@ public:
 	//File input
 	int LoadSystem(string Filename, bool StructCues = false);
 	int LoadStructuralCues();
+	bool PrepareCompleteReaction(Reaction* InReaction, bool BalancedOnly, vector<string>* AllowedUnbalancedReactions);
+	void OpenReactionCache();
+	void SaveReactionCache();
+	void ClearReactionCache();
+	ReactionCacheEntry* FindCachedReaction(const string& ID);
+	void ReplayCachedReaction(ReactionCacheEntry* Entry);
+	bool RestoreCachedBalance(Reaction* InReaction, ReactionCacheEntry* Entry);
+	void RestoreCachedDirectionality(Reaction* InReaction, ReactionCacheEntry* Entry);
+	void CacheReactionInput(const string& ID, Reaction* InReaction);
+	void CacheReaction(const string& ID, Reaction* InReaction, int Status);
 
 	//Input
 	Species* AddSpecies(string Filename);
@@ -74,6 +96,8 @@ public:
 	Gene* AddGene(string Filename);
 	Species* AddSpecies(vector<string>* InHeaders, string Fileline);
 	Reaction* AddReaction(vector<string>* InHeaders, string Fileline);
+	//Adds the reactions of one model file section after fetching all of their database records together
+	void AddReactions(vector<string>* InHeaders, vector<string>& Filelines);
 	Species* AddStructuralCue(vector<string>* InHeaders, string Fileline);
 	Species* AddSpecies(Species* NewSpecies);
 	Reaction* AddReaction(Reaction* NewReaction);
@@ -96,6 +120,7 @@ public:
 	void LoadGeneIntervals();
 	void AddAlias(int Type,string One,string Two);
 	void LoadGeneDictionary();
+	void CompileGeneLogic();
 
 	//Output
 	//Structural cue query functions
@@ -126,12 +151,14 @@ public:
 	Species* FindStructuralCue(const char* DatabaseName,const char* DataID);
 	Gene* FindGene(const char* DatabaseName,const char* DataID);
 	Species* GetHydrogenSpecies();
+	void FindKnockedOutReactions(vector<bool>& GeneKO, vector<bool>& ReactionKO);
+	void GeneLogicChanged();
 
 	//Analysis functions
-	void PerformAllRequestedTasks();
+	int PerformAllRequestedTasks();
 	map<Species* , list<Pathway*> , std::less<Species*> >* FindPathways(Species* Source, vector<Species*> Targets, int MaxLength, int TimeInterval, bool AddReverseConnections, int LengthInterval, int &ClockIndex);
 	void SearchForPathways();
-	void PerformMFA();
+	int PerformMFA();
 	void PollStructuralCues();
 	void FindDeadEnds();
 	void IdentifyCompoundWithIdenticalStructures();
@@ -154,7 +181,7 @@ public:
 	void PrintStructures();
 };
 
-//This template class is required so the template remove function for lists can be used to removed marked reactions and compounds
+//This template class is required so the template remove function can be used to removed marked reactions and compounds
 template <class T>
 class RemoveMarkedFunctor {
 	public:
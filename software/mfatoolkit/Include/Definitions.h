@@ -166,6 +166,17 @@
 #define AND 0
 #define OR 1
 
+//Error log severity levels
+#define SEVERITY_DEBUG 0
+#define SEVERITY_INFO 1
+#define SEVERITY_WARNING 2
+#define SEVERITY_ERROR 3
+
+//Compiled gene logic instructions
+#define GPR_GENE 0
+#define GPR_ANY_KO 1
+#define GPR_ALL_KO 2
+
 //MFA equality types
 #define EQUAL 0
 #define GREATER 1
@@ -197,4 +208,13 @@
 #define LINDO 3
 #define SOLVER_SCIP 1
 
+//Gapfilling reaction cache
+#define REACTION_CACHE_VERSION 2
+#define REACTION_CACHE_ACCEPTED 0
+#define REACTION_CACHE_DISAPPROVED_COMPARTMENT 1
+#define REACTION_CACHE_UNBALANCED 2
+
+//Solve time histogram buckets, each ten times wider than the one before, starting below one millisecond
+#define SOLVE_TIME_BUCKETS 7
+
 #endif
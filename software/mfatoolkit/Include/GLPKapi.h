@@ -23,20 +23,26 @@
 
 int InitializeGLPKVariables();
 
-int GLPKInitialize();
+int GLPKInitialize(SolverContext* Context);
 
-int GLPKCleanup();
+int GLPKCleanup(SolverContext* Context);
 
-int GLPKClearSolver();
+int GLPKClearSolver(SolverContext* Context);
 
-int GLPKPrintFromSolver();
+int GLPKPrintFromSolver(SolverContext* Context);
 
-OptSolutionData* GLPKRunSolver(int ProbType);
+OptSolutionData* GLPKRunSolver(SolverContext* Context, int ProbType);
 
-int GLPKLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
+int GLPKLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
 
-int GLPKLoadObjective(LinEquation* InEquation, bool Max);
+int GLPKLoadProblem(SolverContext* Context, SolverMatrix* InMatrix);
 
-int GLPKAddConstraint(LinEquation* InEquation);
+int GLPKLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max);
+
+int GLPKAddConstraint(SolverContext* Context, LinEquation* InEquation);
+
+int GLPKSaveBasis(SolverContext* Context, SolverBasis* OutBasis);
+
+int GLPKLoadBasis(SolverContext* Context, SolverBasis* InBasis);
 
 #endif
\ No newline at end of file
@@ -31,6 +31,8 @@ struct ConstraintsToModify;
 struct FileBounds;
 struct OptimizationParameter;
 struct MapData;
+struct ParameterHandle;
+struct DeferredOutput;
 
 bool verbose();
 
@@ -46,6 +48,8 @@ void CloseIOFiles();
 
 int Initialize();
 
+int InitializeOutputFiles();
+
 void InitializeInternalReferences();
 
 int TranslateFileHeader(string& InHeader, int Object);
@@ -64,6 +68,8 @@ string GetParameter(const char* ParameterLabel);
 
 void SetParameter(const char* ParameterLabel,const char* NewValue);
 
+ParameterHandle* GetParameterHandle(const char* ParameterLabel);
+
 string FOutputFilepath();
 
 string FProgramPath();
@@ -76,10 +82,22 @@ string FInputParameterFile();
 
 ofstream& FLogFile();
 
-void FlushErrorFile();
+void FlushErrorFile(int Level = SEVERITY_ERROR);
+
+void LogMessage(int Level, const string& Message);
+
+void SyncErrorLog();
+
+void StopErrorLog();
 
 ostringstream& FErrorFile();
 
+void SetThreadOutput(DeferredOutput* Output);
+
+DeferredOutput* FThreadOutput();
+
+void ReplayDeferredOutput(DeferredOutput* Output);
+
 void ProduceChargedMolfiles(string MolfileDirectory);
 
 bool PrintPathways(map<Species* , list<Pathway*> , std::less<Species*> >* InPathways, Species* Source);
@@ -171,6 +189,80 @@ struct FileReferenceData {
 	int DataID;
 };
 
+//Parameter value parsed into every type once; handles are updated whenever the parameter is loaded or set, so loops can read the fields directly
+struct ParameterHandle {
+	string Value;
+	bool Bool;
+	int Int;
+	double Double;
+};
+
+//Error messages and AddLineToFile lines captured by a worker thread, replayed later by the main thread so the log order does not depend on scheduling
+struct DeferredOutput {
+	ostringstream ErrorFile;
+	vector<pair<int, string> > ErrorMessages;
+	vector<pair<string, string> > FileLines;
+};
+
+//Share of the complete model build handed to one thread; thread Worker handles reactions Worker, Worker+NumWorkers, ...
+struct CompleteModelBatch {
+	Data* Model;
+	vector<Reaction*>* Reactions;
+	vector<DeferredOutput*>* Outputs;
+	vector<int>* Accepted;
+	vector<string>* AllowedUnbalancedReactions;
+	bool BalancedOnly;
+	int Worker;
+	int NumWorkers;
+};
+
+//Result of loading, balancing and classifying one database reaction, reused by later gapfilling runs with the same database and parameters
+struct ReactionCacheEntry {
+	int Status;
+	int Type;
+	bool Unbalanced;
+	string ThermoClass;
+	string TypeData;
+	string ErrorMessage;
+	//Stoichiometry as loaded, which a cached entry must match, and the changes balancing made to it
+	vector<string> Species;
+	vector<double> Coefficients;
+	vector<int> Compartments;
+	vector<string> AddedSpecies;
+	vector<double> AddedCoefficients;
+	vector<int> AddedCompartments;
+};
+
+//Binary layout of the reaction cache file: header, reactant records, entry records, then a pool of null terminated strings addressed by offset
+struct ReactionCacheHeader {
+	char Magic[8];
+	int Version;
+	unsigned long long Key;
+	int NumEntries;
+	int NumReactants;
+	int PoolSize;
+};
+
+struct ReactionCacheRecord {
+	int ID;
+	int Status;
+	int Type;
+	int Unbalanced;
+	int ThermoClass;
+	int TypeData;
+	int ErrorMessage;
+	int FirstReactant;
+	int NumReactants;
+	int FirstAdded;
+	int NumAdded;
+};
+
+struct ReactionCacheReactant {
+	double Coefficient;
+	int Species;
+	int Compartment;
+};
+
 struct CellCompartment {
 	double DPsiConst;
 	double DPsiCoef;
@@ -236,16 +328,72 @@ struct LinEquation {
 	LinEquation* DualConstraint;
 };
 
+//Work done by the solver for one solve; counts the solver does not report are left at zero
+struct SolveStats {
+	double SolveTime;
+	int Iterations;
+	int Nodes;
+	double MIPGap;
+	int NumRows;
+	int NumColumns;
+	int NumNonzeros;
+	bool WarmStart;
+};
+
+//Solves of one problem shape within one analysis, combined for the report written at cleanup
+struct SolveStatsSummary {
+	int Solves;
+	int WarmStarts;
+	double TotalTime;
+	double MaxTime;
+	double Iterations;
+	double Nodes;
+	double MaxMIPGap;
+	int TimeBuckets[SOLVE_TIME_BUCKETS];
+};
+
 struct OptSolutionData {
 	vector<double> SolutionData;
 	int Status;
 	double Objective;
 	int NumVariables;
+	SolveStats Stats;
 
 	map<int , vector<double> , std::less<int> > ConcentrationStats;
 	string Notes;
 };
 
+//Solver state owned by a single MFAProblem; model handles are opaque here so solver headers stay out of the toolkit headers
+struct SolverContext {
+	vector<MFAVariable*> Variables;
+	void* GLPKModel;
+	void* CPLEXModel;
+	void* SCIPModel;
+	void* LINDOModel;
+	//Changes since the last solve, used to choose dual or primal simplex when the solve starts from the previous basis
+	bool BoundsChanged;
+	bool ObjectiveChanged;
+	//Filled in by the solver during each solve
+	SolveStats Stats;
+};
+
+//Simplex basis in the solver's own status codes, saved after a reference solve and restored before perturbed solves
+struct SolverBasis {
+	vector<int> ColumnStatus;
+	vector<int> RowStatus;
+};
+
+//Whole problem assembled once in compressed sparse row form so a backend can load it in a single call
+struct SolverMatrix {
+	vector<MFAVariable*> Variables;
+	vector<LinEquation*> Constraints;
+	vector<int> RowStart;
+	vector<int> Columns;
+	vector<double> Coefficients;
+	bool RelaxIntegerVariables;
+	bool UseTightBounds;
+};
+
 struct ConstraintsToAdd {
 	vector< vector<double> > VarCoef;
 	vector< vector<string> > VarName;
@@ -407,10 +555,64 @@ struct DataNode {
 	double data;
 };
 
+struct TightBoundResult {
+	int Position;
+	double Min;
+	double Max;
+};
+
+//Single knockout results are followed in the pipe by SupportSize variable indices
+struct KnockoutResult {
+	int Position;
+	double SubType;
+	double Objective;
+	int SupportSize;
+};
+
+//Optimum of a single knockout kept for higher order knockouts that block the same active variables
+struct KnockoutCacheEntry {
+	double Objective;
+	//Sorted indices of the variables blocked by the knockout
+	vector<int> Blocked;
+	//Sorted indices of the variables that are nonzero in the knockout optimum
+	vector<int> Support;
+};
+
 struct SavedBounds {
 	vector<MFAVariable*> variables;
 	vector<double> upperBounds;
 	vector<double> lowerBounds;
 };
 
+//A field of a delimited line; it points into the line buffer and is only valid until that buffer changes
+struct StringField {
+	const char* Data;
+	int Length;
+};
+
+//Reads a file in large blocks and returns each line in place in the buffer
+struct FileLineReader {
+	FILE* Input;
+	char* Buffer;
+	int Capacity;
+	int Start;
+	int End;
+	bool Finished;
+};
+
+//One timed phase of a run; Parent is the index of the enclosing phase or -1, and Duration stays -1 while the phase is open
+struct ProfileEvent {
+	const char* Name;
+	int Parent;
+	long long Start;
+	long long Duration;
+};
+
+//Times the enclosing scope when "Write run profile" is set. Name must outlive the run, so it is normally a string literal
+struct ScopedTimer {
+	int Event;
+	ScopedTimer(const char* Name);
+	~ScopedTimer();
+};
+
 #endif
@@ -34,9 +34,13 @@ private:
 	int ObjectType;
 	string Code;
 	string ErrorMessage;
-	map<string, vector<string> , std::less<string> > DatabaseLinks;
-	map<string, vector<double>, std::less<string> > DoubleData;
-	map<string, vector<string> , std::less<string> > StringData;
+	//Attributes are stored per object as small flat lists keyed by interned attribute IDs
+	vector<pair<int, vector<string> > > DatabaseLinks;
+	vector<pair<int, vector<double> > > DoubleData;
+	vector<pair<int, vector<string> > > StringData;
+
+	vector<string>* FindData(int DataKey, int Object, bool Create);
+	vector<double>* FindDoubleData(int DataKey, bool Create);
 public:
 	Identity();
 	~Identity();
@@ -59,18 +63,26 @@ public:
 	void SetObjectType(int InType);
 	void InitializeEntryIndexDatabase(int InEntry,int InIndex,string InDatabase);
 
+	//Attribute names are interned once into integer IDs shared by all objects; only writers intern, readers get -1 for unknown names
+	static int DataKey(const char* DataName);
+	static int FindDataKey(const char* DataName);
+	static const string& DataKeyName(int DataKey);
+
 	bool AddData(const char* DBName, const char* Data, int Object, bool RemoveDuplicates = true);
 	void AddData(const char* DBName, double Data, bool RemoveDuplicates = true);
 	void SetData(const char* DBName, const char* Data, int Object, int InIndex = 0);
 	void SetData(const char* DBName, double Data, int InIndex = 0);
 
-	string GetGenericData(const char* DataName, int DataIndex = 0);
-	string GetData(const char* DataName, int Object, int DataIndex = 0);
+	//Accessors return references into the object's storage and never insert on a miss
+	const string& GetGenericData(const char* DataName, int DataIndex = 0);
+	const string& GetData(const char* DataName, int Object, int DataIndex = 0);
+	const string& GetData(int DataKey, int Object, int DataIndex = 0);
 	double GetDoubleData(const char* DataName, int DataIndex = 0);
+	double GetDoubleData(int DataKey, int DataIndex = 0);
 	int GetNumData(const char* DataName,int Object);
 
-	vector<double> GetAllData(const char* DataName);
-	vector<string> GetAllData(const char* DataName, int Object);
+	const vector<double>& GetAllData(const char* DataName);
+	const vector<string>& GetAllData(const char* DataName, int Object);
 	string GetAllDataString(const char* DataName, int Object);
 	
 	string GetCombinedData(int Object);
@@ -23,12 +23,30 @@
 
 void DriverOptions();
 
-void LoadDatabaseFile(const char* DatabaseFilename);
+int LoadDatabaseFile(const char* DatabaseFilename);
 
 //Commandline functions
 //This function interprets the command line and calls the appriaprate commandline subfunction listed below
 void CommandlineInterface(vector<string> Arguments);
 
+void LoadCommandlineParameters(vector<string>& Arguments, vector<string> ParameterFiles);
+
+//Returns FAIL when any requested action fails or is missing arguments
+int RunCommandlineActions(vector<string>& Arguments);
+int RunLocalLPJobs(vector<string>& Arguments);
+
+void MoveNetworkOutput();
+
+//Server mode: loads the biochemistry once and runs every job received on a unix domain socket in a forked copy of the process
+int RunJobServer(string SocketPath);
+
+bool ReadJobRequest(int Connection, string& Request);
+
+void RunServerJob(int Connection, vector<string>& Arguments);
+
+//Sends one job to a running server and streams its output to stdout
+int RunJobClient(string SocketPath, vector<string>& Arguments);
+
 void RunWebGCM(string InputFilename,string OutputFilename);
 
 //This function converts an input smiles string or molfile into a strincode
@@ -23,20 +23,20 @@
 
 int InitializeLINDOVariables();
 
-int LINDOInitialize();
+int LINDOInitialize(SolverContext* Context);
 
-int LINDOCleanup();
+int LINDOCleanup(SolverContext* Context);
 
-int LINDOClearSolver();
+int LINDOClearSolver(SolverContext* Context);
 
-int LINDOPrintFromSolver();
+int LINDOPrintFromSolver(SolverContext* Context);
 
-OptSolutionData* LINDORunSolver(int ProbType);
+OptSolutionData* LINDORunSolver(SolverContext* Context, int ProbType);
 
-int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
+int LINDOLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
 
-int LINDOLoadObjective(LinEquation* InEquation, bool Max);
+int LINDOLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max);
 
-int LINDOAddConstraint(LinEquation* InEquation);
+int LINDOAddConstraint(SolverContext* Context, LinEquation* InEquation);
 
 #endif
\ No newline at end of file
@@ -26,6 +26,7 @@ struct MFAVariable;
 struct OptSolutionData;
 struct FileConstraints;
 struct SavedBounds;
+struct SolverContext;
 
 class MFAProblem{
 private:
@@ -48,6 +49,11 @@ private:
 	vector<OptSolutionData*> Solutions;
 	vector<ProblemState*> ProblemStates;
 	int MFAProblemClockIndex;
+	SolverContext* Context;
+	SolverBasis* ReferenceBasis;
+	OptSolutionData* ReferenceSolution;
+	map<vector<int>,KnockoutCacheEntry,std::less<vector<int> > > KnockoutCache;
+	vector<int> KnockoutRepresentative;
 public:
 	MFAProblem();
 	~MFAProblem();
@@ -111,12 +117,18 @@ public:
 	int LoadSolver(bool PrintFromSolver = true);
 	OptSolutionData* RunSolver(bool SaveSolution,bool InInputSolution,bool WriteProblem);
 	int LoadConstToSolver(int ConstraintNumber);
+	void PrepareConstForSolver(int ConstraintNumber, bool CheckPotentialFeasibility);
+	void MarkConstLoaded(int ConstraintNumber, bool CheckPotentialFeasibility);
 	int LoadAllConstToSolver() ;
+	int LoadProblemInBulk();
 	int LoadAllVariables();
 	int LoadObjective();
 	int LoadVariable(int InIndex);
 	int ResetSolver();
 	int UpdateLoadSolver();
+	int SaveReferenceBasis();
+	int RestoreReferenceBasis();
+	void ClearReferenceBasis();
 	SavedBounds* saveBounds();
 	int loadBounds(SavedBounds* inBounds,bool loadProblem = true);
 	int loadChangedBoundsIntoSolver(SavedBounds* inBounds);
@@ -128,12 +140,15 @@ public:
 	void ProcessSolution(OptSolutionData* InSolution);
 	int FindTightBounds(Data* InData,OptimizationParameter*& InParameters, bool SaveSolution, bool UseSpecifiedSearchTypes);
 	int FindTightBounds(Data* InData,OptimizationParameter*& InParameters,string Note);
+	int FindTightBoundsInWorkers(vector<int>& SearchVariables, int NumWorkers);
+	double OptimizeTightBound(MFAVariable* InVariable, bool Maximize);
 	int RecursiveMILP(Data* InData,OptimizationParameter*& InParameters, vector<int> VariableTypes,bool PrintSolutions);
 	vector<OptSolutionData*> RecursiveMILP(OptimizationParameter* InParameters, string ProblemNote,bool ForeignOnly,vector<int> VariableTypes,double MinSolution,int ClockIndex,LinEquation* OriginalObjective);
 	int CheckIndividualMetaboliteProduction(Data* InData, OptimizationParameter* InParameters, vector<Species*> Metabolites, vector<int> Compartments, bool FindTightBounds, bool MinimizeForeignReactions, bool MakeAllDrainsSimultaneously, string Note, bool SubProblem);
 	int CheckIndividualMetaboliteProduction(Data* InData, OptimizationParameter* InParameters, string InMetaboliteList, bool DoFindTightBounds, bool MinimizeForeignReactions, string Note, bool SubProblem);
 	int RunDeletionExperiments(Data* InData, OptimizationParameter* InParameters);
 	int RunMediaExperiments(Data* InData, OptimizationParameter* InParameters, double WildTypeObjective, bool DoOptimizeSingleObjective, bool DoFindTightBounds, bool MinimizeForeignReactions, bool OptimizeMetaboliteProduction);
+	int RunBatchJobs(Data* InData, OptimizationParameter* InParameters);
 	int DetermineMinimalFeasibleMedia(Data* InData,OptimizationParameter* InParameters);
 	int OptimizeSingleObjective(Data* InData, OptimizationParameter* InParameters, string InObjective, bool FindTightBounds, bool MinimizeForeignReactions, double &ObjectiveValue, string Note);
 	int OptimizeSingleObjective(Data* InData, OptimizationParameter* InParameters, bool FindTightBounds, bool MinimizeForeignReactions, double &ObjectiveValue, string Note, bool SubProblem);
@@ -164,6 +179,17 @@ public:
 	
 	//FBA extension studies
 	int CombinatorialKO(int maxDeletions,Data* InData, bool reactions);
+	double KnockoutSubPhenotype(DataNode* delTree,vector<int>& counter,double wildType);
+	void FindKnockoutVariables(Data* InData,vector<int>& counter,bool reactions,vector<MFAVariable*>& entities,vector<int>& active);
+	double SimulateKnockout(Data* InData,vector<int>& counter,bool reactions,vector<int>& Support);
+	void SolutionSupport(OptSolutionData* InSolution,vector<int>& Support);
+	void CacheSingleKnockout(vector<int>& active,vector<MFAVariable*>& entities,double Objective,vector<int>& Support);
+	bool KnockoutCacheApplies(KnockoutCacheEntry& Entry,vector<MFAVariable*>& entities);
+	bool CarriesReferenceFlux(OptSolutionData* Reference,MFAVariable* InVariable);
+	void SetReferenceSolution(OptSolutionData* InSolution);
+	void GroupGenesByFootprint(Data* InData,vector<int>& Representative);
+	int ScreenKnockouts(Data* InData,DataNode* delTree,double wildType,int size,int numEntities,bool reactions,int Offset,int Stride,int After,int Pipe,map<int,double,std::less<int> >* Recorded);
+	int ScreenKnockoutsInWorkers(Data* InData,DataNode* delTree,double wildType,int size,int numEntities,bool reactions,int NumWorkers,map<int,double,std::less<int> >& Recorded);
 
 	//File IO Functions
 	void PrintProblemReport(double SingleObjective,OptimizationParameter* InParameters, string InNote);
@@ -151,6 +151,9 @@ public:
 	int GetReactionClass();
 	int FNumGeneGroups();
 	bool CheckForKO(GeneLogicNode* InNode = NULL);
+	bool CheckLogicNodeForKO(GeneLogicNode* InNode);
+	void CompileGeneLogic(bool NewGeneHandling, vector<int>& Program);
+	void CompileLogicNode(GeneLogicNode* InNode, vector<int>& Program);
 	bool AllReactantsMarked();
 	int FCompartment();
 	bool IsBiomassReaction();
@@ -23,20 +23,29 @@
 
 int InitializeSCIPVariables();
 
-int SCIPInitialize();
+//Returns false when solves go through files shared by every process using the same output folder
+bool SCIPSolvesInProcess();
 
-int SCIPCleanup();
+int SCIPInitialize(SolverContext* Context);
 
-int SCIPClearSolver();
+int SCIPCleanup(SolverContext* Context);
 
-int SCIPPrintFromSolver();
+int SCIPClearSolver(SolverContext* Context);
 
-OptSolutionData* SCIPRunSolver(int ProbType);
+int SCIPPrintFromSolver(SolverContext* Context);
 
-int SCIPLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
+OptSolutionData* SCIPRunSolver(SolverContext* Context, int ProbType);
 
-int SCIPLoadObjective(LinEquation* InEquation, bool Max);
+int SCIPLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
 
-int SCIPAddConstraint(LinEquation* InEquation);
+int SCIPLoadProblem(SolverContext* Context, SolverMatrix* InMatrix);
+
+int SCIPLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max);
+
+int SCIPAddConstraint(SolverContext* Context, LinEquation* InEquation);
+
+int SCIPSaveBasis(SolverContext* Context, SolverBasis* OutBasis);
+
+int SCIPLoadBasis(SolverContext* Context, SolverBasis* InBasis);
 
 #endif
\ No newline at end of file
@@ -21,32 +21,60 @@
 #ifndef SOLVERINTERFACE_H
 #define SOLVERINTERFACE_H
 
-int SolverVariableSize();
+SolverContext* NewSolverContext();
 
-void AddSolverVariable(MFAVariable* InVariable);
+void DeleteSolverContext(SolverContext* Context);
 
-vector<MFAVariable*> SolverVariables();
+int SolverVariableSize(SolverContext* Context);
 
-MFAVariable* GetSolverVariable(int index);
+void AddSolverVariable(SolverContext* Context, MFAVariable* InVariable);
 
-void ClearSolverVariables();
+vector<MFAVariable*>& SolverVariables(SolverContext* Context);
+
+MFAVariable* GetSolverVariable(SolverContext* Context, int index);
+
+void ClearSolverVariables(SolverContext* Context);
 
 int SelectSolver(int Probtype, int CurrentSolver);
 
-int GlobalInitializeSolver(int Solver);
+int GlobalInitializeSolver(SolverContext* Context, int Solver);
+
+//Forked worker processes each solve their own copy of the loaded problem, which is only safe for solvers that run in this process and share no files
+bool GlobalSolverAllowsWorkers(int Solver);
+
+OptSolutionData* GlobalRunSolver(SolverContext* Context, int Solver, int ProbType);
+
+void ClearSolveStats(SolveStats& Stats);
+
+//Adds one solve to the summary for the calling analysis and the problem shape
+void RecordSolveStats(SolveStats& Stats, int ProbType);
+
+//Writes the combined solve statistics and solve time histogram to SolveStatistics.txt in the output folder
+int WriteSolveStatistics();
+
+//Worker processes start with empty summaries and send them to the parent before exiting, where they are merged into the parent's summaries
+void ClearSolveSummaries();
+
+bool SendSolveSummaries(int Pipe);
+
+bool ReceiveSolveSummaries(int Pipe);
+
+int GlobalLoadProblem(SolverContext* Context, int Solver, vector<MFAVariable*>& InVariables, vector<LinEquation*>& InConstraints, bool RelaxIntegerVariables,bool UseTightBounds);
+
+int GlobalLoadVariable(SolverContext* Context, int Solver, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
 
-OptSolutionData* GlobalRunSolver(int Solver, int ProbType);
+int GlobalResetSolver(SolverContext* Context, int Solver);
 
-int GlobalLoadVariable(int Solver, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds);
+int GlobalLoadObjective(SolverContext* Context, int Solver, LinEquation* InEquation, bool Max);
 
-int GlobalResetSolver(int Solver);
+int GlobalWriteLPFile(SolverContext* Context, int Solver);
 
-int GlobalLoadObjective(int Solver, LinEquation* InEquation, bool Max);
+int GlobalAddConstraint(SolverContext* Context, int Solver, LinEquation* InConstraint);
 
-int GlobalWriteLPFile(int Solver);
+int GlobalRemoveConstraint(SolverContext* Context, int Solver, LinEquation* InConstraint);
 
-int GlobalAddConstraint(int Solver, LinEquation* InConstraint);
+int GlobalSaveBasis(SolverContext* Context, int Solver, SolverBasis* OutBasis);
 
-int GlobalRemoveConstraint(int Solver, LinEquation* InConstraint);
+int GlobalLoadBasis(SolverContext* Context, int Solver, SolverBasis* InBasis);
 
 #endif
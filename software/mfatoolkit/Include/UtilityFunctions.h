@@ -42,6 +42,24 @@ vector<string>* GetStringsFileline(ifstream &Input, const char* Delim, bool Trea
 //Splits the input string into a vector of strings using the elements in delim as the delimiters
 vector<string>* StringToStrings(string FullString, const char* Delim, bool TreatConsecutiveDelimAsOne = true);
 
+//Splits a line into fields in a single pass. The fields point into Line and the Fields vector is reused between calls
+int SplitFields(const char* Line, int Length, const char* Delim, vector<StringField>& Fields, bool TreatConsecutiveDelimAsOne = true);
+int SplitFields(const string& Line, const char* Delim, vector<StringField>& Fields, bool TreatConsecutiveDelimAsOne = true);
+
+string FieldToString(const StringField& Field);
+
+bool FieldEquals(const StringField& Field, const char* Text);
+
+double FieldToDouble(const StringField& Field);
+
+//Opens a file for block buffered line reading
+bool OpenLineReader(FileLineReader& Reader, string Filename, int BufferSize = 1048576);
+
+//Returns the next line without its newline. The line is null terminated and stays valid until the next call
+bool ReadLine(FileLineReader& Reader, StringField& Line);
+
+void CloseLineReader(FileLineReader& Reader);
+
 //Replaces find with replace in string source
 void findandreplace(string &source, string find, string replace);
 
@@ -80,6 +98,9 @@ bool OpenOutput(ofstream& Output, string Filename, bool Append = false);
 
 bool OpenInput(ifstream& Input, string Filename);
 
+//Returns a 64 bit FNV-1a hash of the file contents in hexadecimal, or an empty string if the file cannot be read
+string HashFile(string Filename);
+
 char* ConvertStringToCString(string InString);
 
 int Sum(vector<int> InVector);
@@ -96,6 +117,9 @@ string RemoveExtension(string InFilename);
 
 string RemovePath(string InFilename);
 
+//Nanoseconds on a clock that is unaffected by changes to the system time
+long long MonotonicNanoseconds();
+
 int StartClock(int ClockIndex);
 
 bool TimedOut(int ClockIndex);
@@ -106,6 +130,12 @@ void ClearClock(int ClockIndex);
 
 double ElapsedTime(int ClockIndex);
 
+//Name of the phase that opened the innermost open phase, or "none" when there is no such phase or profiling is off
+const char* CallingProfilePhase();
+
+//Writes the phase table to Profile.txt and a Chrome trace to ProfileTrace.json in the output directory
+int WriteProfile();
+
 int GetNumberOfLinesInFile(string Filename);
 
 bool FileExists(string InFilename);
@@ -118,4 +148,31 @@ map<string, vector<string>, std::less<string> > LoadHorizontalHeadingFile(string
 
 void ClearDirectory(string Filename);
 
+//Advances a sorted combination of indices below NumEntities to the next one in lexicographic order. Returns false when the last combination has been passed
+bool NextCombination(vector<int>& Counter, int NumEntities);
+
+//Forks worker processes that each receive a private copy of the current process state. Returns the worker index in the child, where only WorkerPipes[index] is valid, and -1 in the parent
+int ForkWorkerProcesses(int NumWorkers, vector<int>& WorkerPids, vector<int>& WorkerPipes);
+
+//Writes a block of data from a worker process back to the parent process
+bool WriteToPipe(int Pipe, const void* Buffer, int Length);
+
+//Reads a block of data sent by a worker process. Returns false once the worker has closed its pipe
+bool ReadFromPipe(int Pipe, void* Buffer, int Length);
+
+//Waits until a worker pipe has data or has been closed by its worker and returns its index, or -1 once no pipes are open
+int NextReadyWorkerPipe(vector<int>& WorkerPipes);
+
+//Closes the parent end of a worker pipe once all of its data has been read
+void CloseWorkerPipe(int Pipe);
+
+//Waits for the worker processes to exit and returns the number of workers that failed
+int WaitForWorkerProcesses(vector<int>& WorkerPids);
+
+//Runs each line of a command file through the shell with at most NumWorkers commands running at once. Returns the number of commands that failed, or -1 if the file could not be read
+int RunCommandFile(string Filename, int NumWorkers);
+
+//Ends a worker process without running the exit handlers inherited from the parent
+void ExitWorkerProcess(int Pipe, int Status);
+
 #endif
@@ -21,22 +21,126 @@
 #ifndef STRINGDB_H
 #define STRINGDB_H
 
+#define STRINGDB_SNAPSHOT_VERSION 1
+#define STRINGDB_SNAPSHOT_EMPTY 0xFFFFFFFF
+
 class StringDBTable;
 class StringDBObject;
 
+//Layout of a compiled table snapshot; all offsets are byte offsets from the start of the file
+struct StringDBSnapshotHeader {
+	char magic[8];
+	long long sourceSize;
+	long long sourceModified;
+	unsigned version;
+	unsigned signature;
+	unsigned attributeCount;
+	unsigned objectCount;
+	unsigned valueCount;
+	unsigned indexCount;
+	unsigned poolSize;
+	unsigned attributeOffset;
+	unsigned objectOffset;
+	unsigned valueOffset;
+	unsigned indexOffset;
+	unsigned poolOffset;
+	unsigned totalSize;
+	unsigned reserved;
+};
+
+struct StringDBSnapshotIndex {
+	unsigned attribute;
+	unsigned slotCount;
+	unsigned slotOffset;
+	unsigned postingOffset;
+};
+
+struct StringDBSnapshotSlot {
+	unsigned key;
+	unsigned hash;
+	unsigned start;
+	unsigned count;
+};
+
+class StringDBSnapshot {
+private:
+	const char* mapped;
+	size_t mappedSize;
+	const StringDBSnapshotHeader* header;
+	const unsigned* attributeNames;
+	const unsigned* objectStarts;
+	const unsigned* values;
+	const StringDBSnapshotIndex* indexes;
+	const char* pool;
+	const char* get_string(unsigned offset,unsigned& length);
+	const StringDBSnapshotSlot* get_slots(int index);
+public:
+	StringDBSnapshot();
+	~StringDBSnapshot();
+	int open_snapshot(string filename,string sourceFilename,unsigned signature);
+	void close_snapshot();
+	static int write_snapshot(StringDBTable* table,string filename,string sourceFilename,unsigned signature);
+
+	int number_of_attributes();
+	string get_attribute(int attribute);
+	int number_of_objects();
+	int number_of_values(int object,int attribute);
+	const char* get_value(int object,int attribute,int index,unsigned& length);
+
+	int number_of_indexes();
+	int get_index_attribute(int index);
+	int number_of_slots(int index);
+	const char* get_slot_key(int index,int slot,unsigned& length);
+	int get_slot_objects(int index,int slot,const unsigned*& objectIDs);
+	int find_objects(int attribute,const string& value,const unsigned*& objectIDs,const char*& key);
+};
+
+//Result of an index lookup: a contiguous run of objects that stays valid until the key is modified
+struct StringDBObjectSpan {
+	StringDBObject* const* objects;
+	int count;
+};
+
+struct StringDBIndexEntry {
+	const char* key;
+	unsigned length;
+	unsigned hash;
+	vector<StringDBObject*> objects;
+};
+
+//Open addressing index from attribute values to objects; each key is stored once in the index arena or points into a mapped snapshot
+class StringDBIndex {
+private:
+	vector<int> slots;
+	vector<StringDBIndexEntry*> entries;
+	vector<char*> blocks;
+	unsigned blockUsed;
+	const char* intern(const char* key,unsigned length);
+	int find_slot(const char* key,unsigned length,unsigned hash);
+public:
+	StringDBIndex();
+	~StringDBIndex();
+	StringDBIndexEntry* find(const char* key,unsigned length);
+	StringDBIndexEntry* insert(const char* key,unsigned length,bool stableKey = false);
+	int number_of_entries();
+	StringDBIndexEntry* get_entry(int entry);
+};
+
 class StringDB  {
 private:
 	map<string,int,std::less<string> > tableMap;
 	vector<StringDBTable*> tables;
 	string filename;
 	string programPath;
+	bool useSnapshots;
 public:
-	StringDB(string INfilename,string INprogramPath);
+	StringDB(string INfilename,string INprogramPath,bool INuseSnapshots = true);
 	~StringDB();
 	int loadDatabase(string INfilename);
 	void print_error(string message,string function);
 	StringDBObject* get_object(string table,string attribute,string value);
-	list<StringDBObject*>* get_objects(string table,string attribute,string value);
+	StringDBObjectSpan get_objects(string table,string attribute,string value);
+	int get_objects(string table,string attribute,const vector<string>& values,vector<StringDBObject*>& results);
 	int loadDatabaseTable(string name,string type,string idColumn,string filename,string path,string delimiter,string itemDelimiter,vector<string>* indexedAttributes,bool unique = false);
 	int loadDatabaseTable(StringDBObject* tableObject);
 	int number_of_tables();
@@ -45,6 +149,7 @@ public:
 	string get_programPath();
 	int set_programPath(string input);
 	string checkFilename(string INfilename);
+	bool get_useSnapshots();
 };
 
 class StringDBTable {
@@ -55,7 +160,7 @@ private:
 	list<StringDBObject*> objects;
 	list<StringDBObject*>::iterator objectIT;
 	int currentSelection;
-	map<int,map<string,list<StringDBObject*>*,std::less<string> >*,std::less<int> > attributeHash;
+	vector<StringDBIndex*> attributeIndexes;
 	string name;
 	string filename;
 	string path;
@@ -64,11 +169,27 @@ private:
 	string itemDelimiter;
 	string idColumn;
 	vector<string>* indexed_attributes;
+	StringDBSnapshot* snapshot;
+	bool tableLoaded;
+	bool uniqueData;
+	vector<StringDBObject*> records;
+	vector<long long> recordOffsets;
+	vector<int> snapshotColumns;
+	set<int> deferredAttributes;
+	ifstream recordInput;
+	unsigned snapshot_signature(bool unique);
+	int loadFromSnapshot();
+	StringDBIndex* get_attribute_index(int attribute);
+	StringDBIndexEntry* load_deferred_key(int attribute,const string& value);
+	int complete_attribute_hash(int attribute);
 public:
 	StringDBTable(StringDB* INparentDB,string INname,string INtype,string INidColumn,string INfilename = "",string INpath = "",string INdelimiter = "",string INitemDelimiter = "",vector<string>* INindexedAttributes = NULL,bool unique = false);
 	~StringDBTable();
 	void print_error(string message,string function);
 	int loadFromFile(string INfilename = "",string INpath = "",string INdelimiter = "",string INitemDelimiter = "",vector<string>* INindexedAttributes = NULL,bool unique = false);
+	int load_table();
+	int load_record(StringDBObject* object,int record);
+	int load_all_records();
 	int resetIterator();
 
 	string get_name();
@@ -105,8 +226,9 @@ public:
 
 	StringDBObject* get_object(string attribute,string value);
 	StringDBObject* get_object(int attribute,string value);
-	list<StringDBObject*>* get_objects(string attribute,string value);
-	list<StringDBObject*>* get_objects(int attribute,string value);
+	StringDBObjectSpan get_objects(string attribute,string value);
+	StringDBObjectSpan get_objects(int attribute,string value);
+	int get_objects(int attribute,const vector<string>& values,vector<StringDBObject*>& results);
 
 	int number_of_objects();
 	StringDBObject* get_object(int index);
@@ -117,11 +239,16 @@ private:
 	StringDBTable* parentTable;
 	vector<vector<string>*> data;
 	bool loaded;
+	int record;
 public:
 	StringDBObject(StringDBTable* inParent);
+	StringDBObject(StringDBTable* inParent,int inRecord);
 	~StringDBObject();
 	int load_object_from_file(string filename);
+	int load_body();
 	bool objectLoaded();
+	//Record number of a body that has not been read yet, or -1
+	int get_record();
 	int set_loaded(bool input);
 
 	void print_error(string message,string function);
@@ -22,15 +22,13 @@
 #include "cplex.h"
 
 CPXENVptr CPLEXenv;
-CPXLPptr CPLEXModel;
 
 int InitializeCPLEXVariables() {
 	CPLEXenv = NULL;
-	CPLEXModel = NULL;
 	return SUCCESS;
 }
 
-int CPLEXInitialize() {
+int CPLEXInitialize(SolverContext* Context) {
 	int Status = 0;
 	
 	//First I open the CPLEX environment if it is not already open
@@ -77,12 +75,13 @@ int CPLEXInitialize() {
 	Status = CPXsetintparam (CPLEXenv, CPX_PARAM_MIPDISPLAY, 0);
 
 	//Next I clear out any models that currently exist
-	if (CPLEXClearSolver() != SUCCESS) {
+	if (CPLEXClearSolver(Context) != SUCCESS) {
 		return FAIL; //error message already printed	
 	}
 
 	//Now I create a new CPLEX model
-	CPLEXModel = CPXcreateprob (CPLEXenv, &Status, "LPProb");
+	CPXLPptr CPLEXModel = CPXcreateprob (CPLEXenv, &Status, "LPProb");
+	Context->CPLEXModel = CPLEXModel;
 	Status = CPXchgprobtype(CPLEXenv, CPLEXModel, CPXPROB_LP);
 	if (Status || CPLEXModel == NULL) {
 		FErrorFile() << "Failed to create new CPLEX model." << endl;
@@ -94,10 +93,11 @@ int CPLEXInitialize() {
 }
 
 
-int CPLEXCleanup() {
+int CPLEXCleanup(SolverContext* Context) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	if (CPLEXModel != NULL) {
-		if (CPLEXClearSolver() != SUCCESS) {
+		if (CPLEXClearSolver(Context) != SUCCESS) {
 			return FAIL;		
 		}
 	}
@@ -114,10 +114,12 @@ int CPLEXCleanup() {
 	return SUCCESS;
 }
 
-int CPLEXClearSolver() {
+int CPLEXClearSolver(SolverContext* Context) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	if (CPLEXModel != NULL) {
 		Status = CPXfreeprob(CPLEXenv, &CPLEXModel);
+		Context->CPLEXModel = CPLEXModel;
 	}
 
 	if (Status || CPLEXModel != NULL) {
@@ -129,7 +131,8 @@ int CPLEXClearSolver() {
 	return SUCCESS;
 }
 
-int CPLEXPrintFromSolver() {
+int CPLEXPrintFromSolver(SolverContext* Context) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	if (CPLEXenv == NULL) {
 		FErrorFile() << "Cannot print problem to file because CPLEX environment is not open." << endl;
@@ -155,11 +158,24 @@ int CPLEXPrintFromSolver() {
 	return SUCCESS;
 }
 
-OptSolutionData* CPLEXRunSolver(int ProbType) {
+OptSolutionData* CPLEXRunSolver(SolverContext* Context, int ProbType) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	OptSolutionData* NewSolution = NULL;
 	int Status = 0;
+	Context->Stats.NumColumns = CPXgetnumcols(CPLEXenv, CPLEXModel);
+	Context->Stats.NumRows = CPXgetnumrows(CPLEXenv, CPLEXModel);
+	Context->Stats.NumNonzeros = CPXgetnumnz(CPLEXenv, CPLEXModel);
+	//CPLEX drops the solution when the problem changes but keeps the basis, which is the advanced start for this solve
+	Context->Stats.WarmStart = (CPXgetbase(CPLEXenv, CPLEXModel, NULL, NULL) == 0);
 	if (ProbType == LP) {
-		Status = CPXsetintparam (CPLEXenv, CPX_PARAM_LPMETHOD, CPX_ALG_AUTOMATIC);
+		//Bound changes keep the previous basis dual feasible and objective changes keep it primal feasible
+		int Method = CPX_ALG_AUTOMATIC;
+		if (Context->BoundsChanged && !Context->ObjectiveChanged) {
+			Method = CPX_ALG_DUAL;
+		} else if (Context->ObjectiveChanged && !Context->BoundsChanged) {
+			Method = CPX_ALG_PRIMAL;
+		}
+		Status = CPXsetintparam (CPLEXenv, CPX_PARAM_LPMETHOD, Method);
 		if (Status) {
 			FErrorFile() << "Failed to set the optimization method." << endl;
 			FlushErrorFile();
@@ -201,6 +217,13 @@ OptSolutionData* CPLEXRunSolver(int ProbType) {
 	} else if(ProbType == QP) {
 		Status = CPXqpopt (CPLEXenv, CPLEXModel);
 	}
+	if(ProbType == MILP || ProbType == MIQP) {
+		Context->Stats.Iterations = CPXgetmipitcnt(CPLEXenv, CPLEXModel);
+		Context->Stats.Nodes = CPXgetnodecnt(CPLEXenv, CPLEXModel);
+		CPXgetmiprelgap(CPLEXenv, CPLEXModel, &(Context->Stats.MIPGap));
+	} else {
+		Context->Stats.Iterations = CPXgetitcnt(CPLEXenv, CPLEXModel);
+	}
 	if (Status ) {
 		cout << "Failed to optimize LP." << endl;
 		return NULL;
@@ -285,7 +308,8 @@ OptSolutionData* CPLEXRunSolver(int ProbType) {
 	return NewSolution;
 }
 
-int CPLEXLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int CPLEXLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	
 	//First I check the number of columns. If it's larger than the index, then this variable already exists and is only being changed
@@ -355,7 +379,110 @@ int CPLEXLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool
 	return SUCCESS;
 }
 
-int CPLEXLoadObjective(LinEquation* InEquation, bool Max) {
+int CPLEXLoadProblem(SolverContext* Context, SolverMatrix* InMatrix) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
+	int Status = 0;
+
+	if (CPLEXModel == NULL) {
+		FErrorFile() << "Cannot load problem because no CPLEX model exists." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	if (CPXgetnumcols(CPLEXenv, CPLEXModel) > 0 || CPXgetnumrows(CPLEXenv, CPLEXModel) > 0) {
+		FErrorFile() << "Cannot load problem in bulk because the CPLEX model is not empty." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	int NumColumns = int(InMatrix->Variables.size());
+	int NumRows = int(InMatrix->Constraints.size());
+
+	//Columns are set up exactly as CPLEXLoadVariables would for a new variable
+	if (NumColumns > 0) {
+		vector<double> LB(NumColumns);
+		vector<double> UB(NumColumns);
+		vector<double> Obj(NumColumns,0);
+		vector<char> Type(NumColumns);
+		vector<string> StrNames(NumColumns);
+		vector<char*> Names(NumColumns);
+		for (int i=0; i < NumColumns; i++) {
+			MFAVariable* CurrentVariable = InMatrix->Variables[i];
+			LB[i] = CurrentVariable->LowerBound;
+			UB[i] = CurrentVariable->UpperBound;
+			if (InMatrix->UseTightBounds) {
+				LB[i] = CurrentVariable->Min;
+				UB[i] = CurrentVariable->Max;
+			}
+			if (CurrentVariable->Binary && !InMatrix->RelaxIntegerVariables) {
+				Type[i] = CPX_BINARY;
+			} else if (CurrentVariable->Integer && !InMatrix->RelaxIntegerVariables) {
+				Type[i] = CPX_INTEGER;
+			} else {
+				Type[i] = CPX_CONTINUOUS;
+			}
+			StrNames[i] = GetMFAVariableName(CurrentVariable);
+			Names[i] = const_cast<char*>(StrNames[i].c_str());
+		}
+		Status = CPXnewcols (CPLEXenv, CPLEXModel, NumColumns, &(Obj[0]), &(LB[0]), &(UB[0]), &(Type[0]), &(Names[0]));
+		if (Status) {
+			FErrorFile() << "Could not add variables to CPLEX model." << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+	}
+
+	//Sense and right hand side follow CPLEXAddConstraint for a new row
+	if (NumRows > 0) {
+		bool CheckPotentialFeasibility = (GetParameter("Check potential constraints feasibility").compare("1") == 0);
+		vector<double> Rhs(NumRows);
+		vector<char> Sense(NumRows);
+		vector<string> StrNames(NumRows);
+		vector<char*> Names(NumRows);
+		for (int i=0; i < NumRows; i++) {
+			LinEquation* CurrentConstraint = InMatrix->Constraints[i];
+			if (CurrentConstraint->ConstraintType != LINEAR || CurrentConstraint->QuadOne.size() > 0) {
+				FErrorFile() << "Only linear constraints can be loaded into CPLEX in bulk: " << i << endl;
+				FlushErrorFile();
+				return FAIL;
+			}
+			Rhs[i] = CurrentConstraint->RightHandSide;
+			if (CurrentConstraint->EqualityType == EQUAL) {
+				Sense[i] = 'E';
+			} else if (CurrentConstraint->EqualityType == LESS) {
+				Sense[i] = 'L';
+			} else if (CurrentConstraint->EqualityType == GREATER) {
+				Sense[i] = 'G';
+			} else {
+				FErrorFile() << "Unrecognized constraint type: " << CurrentConstraint->ConstraintType << endl;
+				FlushErrorFile();
+				return FAIL;
+			}
+			if ((CurrentConstraint->ConstraintMeaning.compare("chemical potential constraint") == 0) && (CurrentConstraint->Loaded == false) && CheckPotentialFeasibility) {
+				Rhs[i] = CurrentConstraint->LoadedRightHandSide;
+				Sense[i] = 'L';
+			} else if ((CurrentConstraint->ConstraintMeaning.compare("chemical potential constraint") == 0) && (CurrentConstraint->Loaded == false) && (CurrentConstraint->RightHandSide > 0.9*FLAG)){
+				Rhs[i] = FLAG;
+				Sense[i] = 'L';
+			}
+			StrNames[i] = GetConstraintName(CurrentConstraint);
+			Names[i] = const_cast<char*>(StrNames[i].c_str());
+		}
+		//The row starts of the compressed matrix are exactly the rmatbeg array CPLEX expects
+		int NumNonzeros = int(InMatrix->Columns.size());
+		Status = CPXaddrows(CPLEXenv, CPLEXModel, 0, NumRows, NumNonzeros, &(Rhs[0]), &(Sense[0]), &(InMatrix->RowStart[0]), NumNonzeros > 0 ? &(InMatrix->Columns[0]) : NULL, NumNonzeros > 0 ? &(InMatrix->Coefficients[0]) : NULL, NULL, &(Names[0]));
+		if (Status) {
+			FErrorFile() << "Failed to add constraints to CPLEX model." << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+	}
+
+	return SUCCESS;
+}
+
+int CPLEXLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int NumCols = CPXgetnumcols(CPLEXenv, CPLEXModel);
 	int Status = 0;
 
@@ -418,7 +545,8 @@ int CPLEXLoadObjective(LinEquation* InEquation, bool Max) {
 	return SUCCESS;
 }
 
-int CPLEXAddConstraint(LinEquation* InEquation) {
+int CPLEXAddConstraint(SolverContext* Context, LinEquation* InEquation) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	
 	if (InEquation->ConstraintType != QUADRATIC && InEquation->ConstraintType != LINEAR) {
@@ -496,7 +624,8 @@ int CPLEXAddConstraint(LinEquation* InEquation) {
 			Name[0] = new char[StrName.length()+1];
 			strcpy(Name[0],StrName.data());
 
-			if ((InEquation->ConstraintMeaning.compare("chemical potential constraint") == 0) && (InEquation->Loaded == false) && (GetParameter("Check potential constraints feasibility").compare("1") == 0)) {
+			static ParameterHandle* CheckPotential = GetParameterHandle("Check potential constraints feasibility");
+			if ((InEquation->ConstraintMeaning.compare("chemical potential constraint") == 0) && (InEquation->Loaded == false) && CheckPotential->Bool) {
 				Rhs[0] = InEquation->LoadedRightHandSide;
 				Sense[0] = 'L';
 			} else if ((InEquation->ConstraintMeaning.compare("chemical potential constraint") == 0) && (InEquation->Loaded == false) && (InEquation->RightHandSide > 0.9*FLAG)){
@@ -592,7 +721,8 @@ int CPLEXAddConstraint(LinEquation* InEquation) {
 	return SUCCESS;
 }
 
-int CPLEXDelConstraint(LinEquation* InEquation) {
+int CPLEXDelConstraint(SolverContext* Context, LinEquation* InEquation) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
 	int Status = 0;
 	int rowIndex = InEquation->Index;
 	int* indexPtr;
@@ -616,4 +746,46 @@ int CPLEXDelConstraint(LinEquation* InEquation) {
 		return SUCCESS;
 	}
 	
-}
\ No newline at end of file
+}
+int CPLEXSaveBasis(SolverContext* Context, SolverBasis* OutBasis) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
+	if (CPLEXModel == NULL) {
+		return FAIL;
+	}
+
+	OutBasis->ColumnStatus.resize(CPXgetnumcols(CPLEXenv, CPLEXModel));
+	OutBasis->RowStatus.resize(CPXgetnumrows(CPLEXenv, CPLEXModel));
+	if (OutBasis->ColumnStatus.size() == 0 || OutBasis->RowStatus.size() == 0) {
+		return FAIL;
+	}
+
+	int Status = CPXgetbase(CPLEXenv, CPLEXModel, &(OutBasis->ColumnStatus[0]), &(OutBasis->RowStatus[0]));
+	if (Status) {
+		OutBasis->ColumnStatus.clear();
+		OutBasis->RowStatus.clear();
+		return FAIL;
+	}
+
+	return SUCCESS;
+}
+
+int CPLEXLoadBasis(SolverContext* Context, SolverBasis* InBasis) {
+	CPXLPptr CPLEXModel = (CPXLPptr)Context->CPLEXModel;
+	if (CPLEXModel == NULL) {
+		return FAIL;
+	}
+
+	//A basis saved before rows or columns were added no longer describes this problem
+	if (int(InBasis->ColumnStatus.size()) != CPXgetnumcols(CPLEXenv, CPLEXModel) || int(InBasis->RowStatus.size()) != CPXgetnumrows(CPLEXenv, CPLEXModel) || InBasis->ColumnStatus.size() == 0 || InBasis->RowStatus.size() == 0) {
+		return FAIL;
+	}
+
+	int Status = CPXcopybase(CPLEXenv, CPLEXModel, &(InBasis->ColumnStatus[0]), &(InBasis->RowStatus[0]));
+	if (Status) {
+		FErrorFile() << "Failed to load the saved basis into CPLEX." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	return SUCCESS;
+}
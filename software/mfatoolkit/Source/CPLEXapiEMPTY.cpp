@@ -4,38 +4,50 @@ int InitializeCPLEXVariables() {
 	return FAIL;
 }
 
-int CPLEXInitialize() {
+int CPLEXInitialize(SolverContext*) {
 	return FAIL;
 }
 
-int CPLEXCleanup() {
+int CPLEXCleanup(SolverContext*) {
 	return FAIL;
 }
 
-int CPLEXClearSolver() {
+int CPLEXClearSolver(SolverContext*) {
 	return FAIL;
 }
 
-int CPLEXPrintFromSolver() {
+int CPLEXPrintFromSolver(SolverContext*) {
 	return FAIL;
 }
 
-OptSolutionData* CPLEXRunSolver(int ProbType) {
+OptSolutionData* CPLEXRunSolver(SolverContext*, int ProbType) {
 	return NULL;
 }
 
-int CPLEXLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int CPLEXLoadVariables(SolverContext*, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
 	return FAIL;
 }
 
-int CPLEXLoadObjective(LinEquation* InEquation, bool Max) {
+int CPLEXLoadProblem(SolverContext*, SolverMatrix*) {
 	return FAIL;
 }
 
-int CPLEXAddConstraint(LinEquation* InEquation) {
+int CPLEXLoadObjective(SolverContext*, LinEquation* InEquation, bool Max) {
 	return FAIL;
 }
 
-int CPLEXDelConstraint(LinEquation* InEquation) {
+int CPLEXAddConstraint(SolverContext*, LinEquation* InEquation) {
+	return FAIL;
+}
+
+int CPLEXDelConstraint(SolverContext*, LinEquation* InEquation) {
+	return FAIL;
+}
+
+int CPLEXSaveBasis(SolverContext*, SolverBasis*) {
+	return FAIL;
+}
+
+int CPLEXLoadBasis(SolverContext*, SolverBasis*) {
 	return FAIL;
 }
\ No newline at end of file
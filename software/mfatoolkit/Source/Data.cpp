@@ -19,6 +19,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MFAToolkit.h"
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 Data::Data(int InIndex) {
 	HydrogenSpecies = NULL;
@@ -26,10 +29,12 @@ Data::Data(int InIndex) {
 	for (int i=0; i < FNumCompartments(); i++) {
 		RepresentedCompartments[i] = false;
 	}
-	LastSpeciesIndex = 0;
-	LastReactionIndex = 0;
-	ReactionIT = ReactionList.begin();
-	SpeciesIT = SpeciesList.begin();
+	CompiledGeneCount = -1;
+	CompiledNewGeneHandling = false;
+	GeneLogicVersion = 0;
+	CompiledGeneLogicVersion = -1;
+	ReactionCacheChanged = false;
+	ReactionCacheKey = 0;
 
 	//Sets the index-this is just a numerial identifier in case you have multiple datasets
 	SetIndex(InIndex);
@@ -39,6 +44,17 @@ Data::Data(int InIndex) {
 	}
 }
 
+//Thread entry for the complete model build; errors go to the reaction's deferred output
+void* PrepareCompleteReactionBatch(void* InData) {
+	CompleteModelBatch* Batch = (CompleteModelBatch*)InData;
+	for (int i=Batch->Worker; i < int(Batch->Reactions->size()); i += Batch->NumWorkers) {
+		SetThreadOutput((*Batch->Outputs)[i]);
+		(*Batch->Accepted)[i] = Batch->Model->PrepareCompleteReaction((*Batch->Reactions)[i],Batch->BalancedOnly,Batch->AllowedUnbalancedReactions);
+	}
+	SetThreadOutput(NULL);
+	return NULL;
+}
+
 Data::~Data() {
 	delete [] RepresentedCompartments;
 	
@@ -47,15 +63,426 @@ Data::~Data() {
 	ClearReactions();
 	ClearStructuralCues();
 	ClearGenes();
+	ClearReactionCache();
+}
+
+//Balances a reaction of the complete model and sets its directionality; returns true if the reaction belongs in the model
+bool Data::PrepareCompleteReaction(Reaction* InReaction, bool BalancedOnly, vector<string>* AllowedUnbalancedReactions) {
+	if (!InReaction->BalanceReaction(false,false)) {
+		InReaction->AddData("UNBALANCED","YES",STRING);
+	}
+	bool Accept = (!BalancedOnly || InReaction->GetData("UNBALANCED",STRING).length() == 0);
+	for (int j=0; !Accept && j < int(AllowedUnbalancedReactions->size()); j++) {
+		if (InReaction->GetData("DATABASE",STRING).compare((*AllowedUnbalancedReactions)[j]) == 0) {
+			Accept = true;
+		}
+	}
+	if (Accept) {
+		InReaction->SetType(InReaction->CalculateDirectionalityFromThermo());
+	}
+	return Accept;
+}
+
+//FNV-1a over raw bytes; used to key the reaction cache
+unsigned long long ReactionCacheHash(const void* InData, int Length, unsigned long long Hash) {
+	const unsigned char* Bytes = (const unsigned char*)InData;
+	for (int i=0; i < Length; i++) {
+		Hash ^= Bytes[i];
+		Hash *= 1099511628211ULL;
+	}
+	return Hash;
+}
+
+unsigned long long ReactionCacheHash(const string& InString, unsigned long long Hash) {
+	//The length is hashed too so adjacent strings cannot run together
+	int Length = int(InString.length());
+	Hash = ReactionCacheHash(&Length,sizeof(Length),Hash);
+	return ReactionCacheHash(InString.data(),Length,Hash);
+}
+
+//Everything that decides how a database reaction is balanced, filtered and classified: the reaction and compound tables, the parameters read while processing them, and the compartments
+unsigned long long Data::ComputeReactionCacheKey() {
+	unsigned long long Key = 14695981039346656037ULL;
+	int Version = REACTION_CACHE_VERSION;
+	Key = ReactionCacheHash(&Version,sizeof(Version),Key);
+	const char* Tables[] = {"reaction","compound"};
+	for (int i=0; i < 2; i++) {
+		StringDBTable* Table = GetStringDB()->get_table(Tables[i]);
+		if (Table == NULL) {
+			continue;
+		}
+		Key = ReactionCacheHash(Table->get_filename(),Key);
+		struct stat SourceStat;
+		if (stat(Table->get_filename().data(),&SourceStat) == 0) {
+			long long Size = (long long)SourceStat.st_size;
+			long long Modified = (long long)SourceStat.st_mtime;
+			Key = ReactionCacheHash(&Size,sizeof(Size),Key);
+			Key = ReactionCacheHash(&Modified,sizeof(Modified),Key);
+		}
+	}
+	const char* Parameters[] = {"Allowable unbalanced reactions","dissapproved compartments","Balanced reactions in gap filling only","Always reversible reactions","Always forward reactions","Low energy compounds","Use directionality rules of thumb","Temperature","pH","Min external pH","Max external pH","minimum pKa","maximum pKa","balance reactions","automatically add H to balance","automatically add electrons to balance","calculate group change","calculate energy from groups","calculate directionality from thermodynamics","Calculations:Reactions:transported atoms",NULL};
+	for (int i=0; Parameters[i] != NULL; i++) {
+		Key = ReactionCacheHash(GetParameter(Parameters[i]),Key);
+	}
+	for (int i=0; i < FNumCompartments(); i++) {
+		CellCompartment* Current = GetCompartment(i);
+		double Values[] = {Current->DPsiConst,Current->DPsiCoef,Current->pH,Current->IonicStrength,Current->MaxConc,Current->MinConc};
+		Key = ReactionCacheHash(Current->Abbreviation,Key);
+		Key = ReactionCacheHash(Values,sizeof(Values),Key);
+		for (map<string, double*, std::less<string> >::iterator MapIT = Current->SpecialConcRanges.begin(); MapIT != Current->SpecialConcRanges.end(); MapIT++) {
+			if (MapIT->second != NULL) {
+				Key = ReactionCacheHash(MapIT->first,Key);
+				Key = ReactionCacheHash(MapIT->second,2*sizeof(double),Key);
+			}
+		}
+	}
+	return Key;
+}
+
+//Loads the reaction cache matching the current database and parameters; one file is kept per key in the ReactionCache folder of the output root
+void Data::OpenReactionCache() {
+	static ParameterHandle* UseCache = GetParameterHandle("Use gapfilling reaction cache");
+	StringDBTable* rxntbl = NULL;
+	if (GetStringDB() != NULL) {
+		rxntbl = GetStringDB()->get_table("reaction");
+	}
+	//Group contribution energies change reactions in ways the cache does not record
+	if (!UseCache->Bool || rxntbl == NULL || GetParameter("load compound structure").compare("1") == 0) {
+		SaveReactionCache();
+		ClearReactionCache();
+		return;
+	}
+	unsigned long long Key = ComputeReactionCacheKey();
+	char KeyText[32];
+	sprintf(KeyText,"%016llx",Key);
+	string Filename = GetDatabaseDirectory(false)+"ReactionCache/"+KeyText+".reactioncache";
+	if (Filename.compare(ReactionCacheFilename) == 0) {
+		return;
+	}
+	SaveReactionCache();
+	ClearReactionCache();
+	ReactionCacheFilename = Filename;
+	ReactionCacheKey = Key;
+
+	FILE* Input = fopen(Filename.data(),"rb");
+	if (Input == NULL) {
+		return;
+	}
+	vector<char> Buffer;
+	if (fseek(Input,0,SEEK_END) == 0) {
+		long Size = ftell(Input);
+		if (Size > 0 && fseek(Input,0,SEEK_SET) == 0) {
+			Buffer.resize(Size);
+			if (fread(&Buffer[0],1,Size,Input) != size_t(Size)) {
+				Buffer.clear();
+			}
+		}
+	}
+	fclose(Input);
+	if (Buffer.size() < sizeof(ReactionCacheHeader)) {
+		return;
+	}
+	ReactionCacheHeader Header;
+	memcpy(&Header,&Buffer[0],sizeof(Header));
+	long long Expected = (long long)sizeof(Header)+(long long)Header.NumEntries*sizeof(ReactionCacheRecord)+(long long)Header.NumReactants*sizeof(ReactionCacheReactant)+Header.PoolSize;
+	if (memcmp(Header.Magic,"RXNCACH",8) != 0 || Header.Version != REACTION_CACHE_VERSION || Header.Key != Key || Header.NumEntries < 0 || Header.NumReactants < 0 || Header.PoolSize <= 0 || Expected != (long long)Buffer.size()) {
+		FErrorFile() << "Ignoring invalid reaction cache " << Filename << endl;
+		FlushErrorFile(SEVERITY_WARNING);
+		return;
+	}
+	//The reactant records come first so their doubles stay aligned
+	const ReactionCacheReactant* Reactants = (const ReactionCacheReactant*)(&Buffer[0]+sizeof(Header));
+	const ReactionCacheRecord* Records = (const ReactionCacheRecord*)(Reactants+Header.NumReactants);
+	const char* Pool = (const char*)(Records+Header.NumEntries);
+	if (Pool[Header.PoolSize-1] != 0) {
+		return;
+	}
+	for (int i=0; i < Header.NumEntries; i++) {
+		const ReactionCacheRecord& Record = Records[i];
+		if (Record.FirstReactant < 0 || Record.NumReactants < 0 || Record.FirstReactant+Record.NumReactants > Header.NumReactants) {
+			continue;
+		}
+		if (Record.FirstAdded < 0 || Record.NumAdded < 0 || Record.FirstAdded+Record.NumAdded > Header.NumReactants) {
+			continue;
+		}
+		int Offsets[] = {Record.ID,Record.ThermoClass,Record.TypeData,Record.ErrorMessage};
+		bool Valid = true;
+		for (int j=0; j < 4; j++) {
+			Valid = Valid && Offsets[j] >= 0 && Offsets[j] < Header.PoolSize;
+		}
+		for (int j=Record.FirstReactant; j < Record.FirstReactant+Record.NumReactants; j++) {
+			Valid = Valid && Reactants[j].Species >= 0 && Reactants[j].Species < Header.PoolSize;
+		}
+		for (int j=Record.FirstAdded; j < Record.FirstAdded+Record.NumAdded; j++) {
+			Valid = Valid && Reactants[j].Species >= 0 && Reactants[j].Species < Header.PoolSize;
+		}
+		if (!Valid) {
+			continue;
+		}
+		ReactionCacheEntry*& Entry = ReactionCache[Pool+Record.ID];
+		if (Entry == NULL) {
+			Entry = new ReactionCacheEntry;
+		}
+		Entry->Status = Record.Status;
+		Entry->Type = Record.Type;
+		Entry->Unbalanced = (Record.Unbalanced != 0);
+		Entry->ThermoClass.assign(Pool+Record.ThermoClass);
+		Entry->TypeData.assign(Pool+Record.TypeData);
+		Entry->ErrorMessage.assign(Pool+Record.ErrorMessage);
+		Entry->Species.resize(Record.NumReactants);
+		Entry->Coefficients.resize(Record.NumReactants);
+		Entry->Compartments.resize(Record.NumReactants);
+		for (int j=0; j < Record.NumReactants; j++) {
+			Entry->Species[j].assign(Pool+Reactants[Record.FirstReactant+j].Species);
+			Entry->Coefficients[j] = Reactants[Record.FirstReactant+j].Coefficient;
+			Entry->Compartments[j] = Reactants[Record.FirstReactant+j].Compartment;
+		}
+		Entry->AddedSpecies.resize(Record.NumAdded);
+		Entry->AddedCoefficients.resize(Record.NumAdded);
+		Entry->AddedCompartments.resize(Record.NumAdded);
+		for (int j=0; j < Record.NumAdded; j++) {
+			Entry->AddedSpecies[j].assign(Pool+Reactants[Record.FirstAdded+j].Species);
+			Entry->AddedCoefficients[j] = Reactants[Record.FirstAdded+j].Coefficient;
+			Entry->AddedCompartments[j] = Reactants[Record.FirstAdded+j].Compartment;
+		}
+	}
+}
+
+//Writes the cache through a temporary file so concurrent jobs never read a partial cache
+void Data::SaveReactionCache() {
+	if (!ReactionCacheChanged || ReactionCacheFilename.length() == 0) {
+		return;
+	}
+	ReactionCacheChanged = false;
+	//Species IDs repeat across reactions, so every string is stored once in the pool
+	string Pool(1,'\0');
+	map<string, int, std::less<string> > PoolOffsets;
+	PoolOffsets[""] = 0;
+	vector<ReactionCacheRecord> Records;
+	vector<ReactionCacheReactant> Reactants;
+	for (map<string, ReactionCacheEntry*, std::less<string> >::iterator MapIT = ReactionCache.begin(); MapIT != ReactionCache.end(); MapIT++) {
+		ReactionCacheEntry* Entry = MapIT->second;
+		const string* Strings[] = {&MapIT->first,&Entry->ThermoClass,&Entry->TypeData,&Entry->ErrorMessage};
+		int Offsets[4];
+		for (int j=0; j < 4; j++) {
+			int& Offset = PoolOffsets[*Strings[j]];
+			if (Offset == 0 && Strings[j]->length() > 0) {
+				Offset = int(Pool.length());
+				Pool.append(Strings[j]->data(),Strings[j]->length()+1);
+			}
+			Offsets[j] = Offset;
+		}
+		ReactionCacheRecord Record;
+		Record.ID = Offsets[0];
+		Record.Status = Entry->Status;
+		Record.Type = Entry->Type;
+		Record.Unbalanced = Entry->Unbalanced;
+		Record.ThermoClass = Offsets[1];
+		Record.TypeData = Offsets[2];
+		Record.ErrorMessage = Offsets[3];
+		Record.FirstReactant = int(Reactants.size());
+		Record.NumReactants = int(Entry->Species.size());
+		Record.FirstAdded = Record.FirstReactant+Record.NumReactants;
+		Record.NumAdded = int(Entry->AddedSpecies.size());
+		Records.push_back(Record);
+		//The loaded stoichiometry and the balancing changes share the reactant records, one run after the other
+		for (int k=0; k < 2; k++) {
+			vector<string>& SpeciesIDs = (k == 0) ? Entry->Species : Entry->AddedSpecies;
+			vector<double>& Coefficients = (k == 0) ? Entry->Coefficients : Entry->AddedCoefficients;
+			vector<int>& Compartments = (k == 0) ? Entry->Compartments : Entry->AddedCompartments;
+			for (int j=0; j < int(SpeciesIDs.size()); j++) {
+				int& Offset = PoolOffsets[SpeciesIDs[j]];
+				if (Offset == 0 && SpeciesIDs[j].length() > 0) {
+					Offset = int(Pool.length());
+					Pool.append(SpeciesIDs[j].data(),SpeciesIDs[j].length()+1);
+				}
+				ReactionCacheReactant Reactant;
+				Reactant.Coefficient = Coefficients[j];
+				Reactant.Species = Offset;
+				Reactant.Compartment = Compartments[j];
+				Reactants.push_back(Reactant);
+			}
+		}
+	}
+	ReactionCacheHeader Header;
+	memset(&Header,0,sizeof(Header));
+	strcpy(Header.Magic,"RXNCACH");
+	Header.Version = REACTION_CACHE_VERSION;
+	Header.Key = ReactionCacheKey;
+	Header.NumEntries = int(Records.size());
+	Header.NumReactants = int(Reactants.size());
+	Header.PoolSize = int(Pool.length());
+
+	ostringstream TempName;
+	TempName << ReactionCacheFilename << "." << getpid() << ".tmp";
+	FILE* Output = fopen(TempName.str().data(),"wb");
+	if (Output == NULL) {
+		MakeDirectory(ReactionCacheFilename.data());
+		Output = fopen(TempName.str().data(),"wb");
+	}
+	if (Output == NULL) {
+		FErrorFile() << "Could not write reaction cache " << ReactionCacheFilename << endl;
+		FlushErrorFile(SEVERITY_WARNING);
+		return;
+	}
+	bool Written = (fwrite(&Header,sizeof(Header),1,Output) == 1);
+	if (Written && Reactants.size() > 0) {
+		Written = (fwrite(&Reactants[0],sizeof(ReactionCacheReactant),Reactants.size(),Output) == Reactants.size());
+	}
+	if (Written && Records.size() > 0) {
+		Written = (fwrite(&Records[0],sizeof(ReactionCacheRecord),Records.size(),Output) == Records.size());
+	}
+	if (Written) {
+		Written = (fwrite(Pool.data(),1,Pool.length(),Output) == Pool.length());
+	}
+	Written = (fclose(Output) == 0) && Written;
+	if (!Written || rename(TempName.str().data(),ReactionCacheFilename.data()) != 0) {
+		remove(TempName.str().data());
+		FErrorFile() << "Could not write reaction cache " << ReactionCacheFilename << endl;
+		FlushErrorFile(SEVERITY_WARNING);
+	}
+}
+
+void Data::ClearReactionCache() {
+	for (map<string, ReactionCacheEntry*, std::less<string> >::iterator MapIT = ReactionCache.begin(); MapIT != ReactionCache.end(); MapIT++) {
+		delete MapIT->second;
+	}
+	ReactionCache.clear();
+	ReactionCacheFilename.clear();
+	ReactionCacheChanged = false;
+}
+
+ReactionCacheEntry* Data::FindCachedReaction(const string& ID) {
+	if (ReactionCacheFilename.length() == 0) {
+		return NULL;
+	}
+	map<string, ReactionCacheEntry*, std::less<string> >::iterator MapIT = ReactionCache.find(ID);
+	if (MapIT == ReactionCache.end()) {
+		return NULL;
+	}
+	return MapIT->second;
+}
+
+//A rejected reaction is never built from the cache, but building it used to create its species and mark their compartments, so that part is repeated here
+void Data::ReplayCachedReaction(ReactionCacheEntry* Entry) {
+	for (int k=0; k < 2; k++) {
+		vector<string>& SpeciesIDs = (k == 0) ? Entry->Species : Entry->AddedSpecies;
+		vector<int>& Compartments = (k == 0) ? Entry->Compartments : Entry->AddedCompartments;
+		for (int i=0; i < int(SpeciesIDs.size()); i++) {
+			Species* Reactant = FindSpecies("DATABASE",SpeciesIDs[i].data());
+			if (Reactant == NULL) {
+				Reactant = AddSpecies(SpeciesIDs[i]);
+			}
+			if (Reactant != NULL) {
+				AddCompartment(Compartments[i]);
+				Reactant->AddCompartment(Compartments[i]);
+			}
+		}
+	}
+}
+
+//Applies the cached balance result if the freshly loaded reaction has the cached stoichiometry as loaded; returns false if the entry is stale
+bool Data::RestoreCachedBalance(Reaction* InReaction, ReactionCacheEntry* Entry) {
+	if (InReaction->FNumReactants() != int(Entry->Species.size())) {
+		return false;
+	}
+	for (int i=0; i < InReaction->FNumReactants(); i++) {
+		if (InReaction->GetReactantCoef(i) != Entry->Coefficients[i] || InReaction->GetReactantCompartment(i) != Entry->Compartments[i] || InReaction->GetReactant(i)->GetData("DATABASE",STRING).compare(Entry->Species[i]) != 0) {
+			return false;
+		}
+	}
+	for (int i=0; i < int(Entry->AddedSpecies.size()); i++) {
+		Species* Reactant = FindSpecies("DATABASE",Entry->AddedSpecies[i].data());
+		if (Reactant == NULL) {
+			Reactant = AddSpecies(Entry->AddedSpecies[i]);
+		}
+		if (Reactant != NULL) {
+			InReaction->AddReactant(Reactant,Entry->AddedCoefficients[i],Entry->AddedCompartments[i]);
+		}
+	}
+	if (Entry->Unbalanced && InReaction->GetData("UNBALANCED",STRING).length() == 0) {
+		InReaction->AddData("UNBALANCED","YES",STRING);
+	}
+	vector<string>* Messages = StringToStrings(Entry->ErrorMessage,"|");
+	for (int i=0; i < int(Messages->size()); i++) {
+		InReaction->AddErrorMessage((*Messages)[i].data());
+	}
+	delete Messages;
+	return true;
+}
+
+void Data::RestoreCachedDirectionality(Reaction* InReaction, ReactionCacheEntry* Entry) {
+	if (Entry->TypeData.length() > 0) {
+		InReaction->SetData("REACTION_TYPE_DATA",Entry->TypeData.data(),STRING);
+	}
+	if (Entry->ThermoClass.length() > 0) {
+		InReaction->SetData("THERMO_CLASS",Entry->ThermoClass.data(),STRING);
+	}
+	InReaction->SetType(Entry->Type);
+}
+
+//Records the stoichiometry of a freshly loaded reaction, before anything balances it; CacheReaction later stores what changed
+void Data::CacheReactionInput(const string& ID, Reaction* InReaction) {
+	if (ReactionCacheFilename.length() == 0) {
+		return;
+	}
+	ReactionCacheEntry*& Entry = ReactionCache[ID];
+	if (Entry == NULL) {
+		Entry = new ReactionCacheEntry;
+	}
+	Entry->Species.resize(InReaction->FNumReactants());
+	Entry->Coefficients.resize(InReaction->FNumReactants());
+	Entry->Compartments.resize(InReaction->FNumReactants());
+	for (int i=0; i < InReaction->FNumReactants(); i++) {
+		Entry->Species[i] = InReaction->GetReactant(i)->GetData("DATABASE",STRING);
+		Entry->Coefficients[i] = InReaction->GetReactantCoef(i);
+		Entry->Compartments[i] = InReaction->GetReactantCompartment(i);
+	}
+}
+
+//Records a processed reaction recorded earlier by CacheReactionInput; the cache is written by SaveReactionCache
+void Data::CacheReaction(const string& ID, Reaction* InReaction, int Status) {
+	if (ReactionCacheFilename.length() == 0) {
+		return;
+	}
+	map<string, ReactionCacheEntry*, std::less<string> >::iterator MapIT = ReactionCache.find(ID);
+	if (MapIT == ReactionCache.end()) {
+		return;
+	}
+	ReactionCacheEntry* Entry = MapIT->second;
+	Entry->Status = Status;
+	Entry->Type = InReaction->FType();
+	Entry->Unbalanced = (InReaction->GetData("UNBALANCED",STRING).length() > 0);
+	Entry->ThermoClass = InReaction->GetData("THERMO_CLASS",STRING);
+	Entry->TypeData = InReaction->GetData("REACTION_TYPE_DATA",STRING);
+	Entry->ErrorMessage = InReaction->FErrorMessage();
+	map<pair<string,int>, double, std::less<pair<string,int> > > Changes;
+	for (int i=0; i < int(Entry->Species.size()); i++) {
+		Changes[pair<string,int>(Entry->Species[i],Entry->Compartments[i])] -= Entry->Coefficients[i];
+	}
+	for (int i=0; i < InReaction->FNumReactants(); i++) {
+		Changes[pair<string,int>(InReaction->GetReactant(i)->GetData("DATABASE",STRING),InReaction->GetReactantCompartment(i))] += InReaction->GetReactantCoef(i);
+	}
+	Entry->AddedSpecies.clear();
+	Entry->AddedCoefficients.clear();
+	Entry->AddedCompartments.clear();
+	for (map<pair<string,int>, double, std::less<pair<string,int> > >::iterator ChangeIT = Changes.begin(); ChangeIT != Changes.end(); ChangeIT++) {
+		if (ChangeIT->second != 0) {
+			Entry->AddedSpecies.push_back(ChangeIT->first.first);
+			Entry->AddedCoefficients.push_back(ChangeIT->second);
+			Entry->AddedCompartments.push_back(ChangeIT->first.second);
+		}
+	}
+	ReactionCacheChanged = true;
 }
 
 //File Input
 int Data::LoadSystem(string Filename, bool StructCues) {
+	ScopedTimer Timer("Load model");
 	if (Filename.compare("NONE") == 0 || Filename.compare("") == 0) {
 		return FAIL;
 	}
 	
-	ifstream Input;
 	SetData("FILENAME",RemovePath(Filename).data(),STRING);
 	
 	cout << "Loading System: "<<Filename<<endl;
@@ -74,9 +501,27 @@ int Data::LoadSystem(string Filename, bool StructCues) {
 			if (GetParameter("dissapproved compartments").compare("none") != 0) {
 				DissapprovedCompartments = StringToStrings(GetParameter("dissapproved compartments"),";");
 			}
-			//Iterating through the list and loading any reaction that is not already present in the model
+			//Reactions are constructed serially because loading them creates shared species
+			OpenReactionCache();
+			vector<Reaction*> Candidates;
+			vector<int> Accepted;
+			vector<int> Pending;
+			vector<string> PendingIDs;
 			for (int i=0; i < int (ReactionList.size()); i++) {
+				//Reactions the cache knows are rejected are never built
+				ReactionCacheEntry* Cached = FindCachedReaction(ReactionList[i]);
+				if (Cached != NULL && Cached->Status != REACTION_CACHE_ACCEPTED) {
+					ReplayCachedReaction(Cached);
+					continue;
+				}
 				Reaction* NewReaction = new Reaction(ReactionList[i],this);
+				if (Cached != NULL && RestoreCachedBalance(NewReaction,Cached)) {
+					RestoreCachedDirectionality(NewReaction,Cached);
+					Candidates.push_back(NewReaction);
+					Accepted.push_back(1);
+					continue;
+				}
+				CacheReactionInput(ReactionList[i],NewReaction);
 				//Checking that only approved compartments are involved in the reaction
 				bool ContainsDissapprovedCompartments = false;
 				if (DissapprovedCompartments != NULL) {
@@ -88,25 +533,112 @@ int Data::LoadSystem(string Filename, bool StructCues) {
 						}
 					}
 				}
+				if (ContainsDissapprovedCompartments) {
+					CacheReaction(ReactionList[i],NewReaction,REACTION_CACHE_DISAPPROVED_COMPARTMENT);
+				} else {
+					Pending.push_back(int(Candidates.size()));
+					PendingIDs.push_back(ReactionList[i]);
+					Candidates.push_back(NewReaction);
+					Accepted.push_back(0);
+				}
+			}
 
-				if (!ContainsDissapprovedCompartments) {
-					//Checking if the reaction is balanced
-					if (!NewReaction->BalanceReaction(false,false)) {
-						NewReaction->AddData("UNBALANCED","YES",STRING);
+			//Balancing and thermodynamic directionality only change the reaction itself, so they run on worker threads
+			static ParameterHandle* BuildThreads = GetParameterHandle("Complete model build threads");
+			bool BalancedOnly = (GetParameter("Balanced reactions in gap filling only").compare("0") != 0);
+			vector<Reaction*> PendingReactions(Pending.size());
+			vector<int> PendingAccepted(Pending.size(),0);
+			for (int i=0; i < int(Pending.size()); i++) {
+				PendingReactions[i] = Candidates[Pending[i]];
+			}
+			int NumWorkers = BuildThreads->Int;
+			//Group contribution energies touch the shared structural cues, so that case stays serial
+			if (GetParameter("load compound structure").compare("1") == 0 || NumWorkers > int(PendingReactions.size())) {
+				NumWorkers = 1;
+			}
+			if (NumWorkers <= 1) {
+				for (int i=0; i < int(PendingReactions.size()); i++) {
+					PendingAccepted[i] = PrepareCompleteReaction(PendingReactions[i],BalancedOnly,AllowedUnbalancedReactions);
+				}
+			} else {
+				//Everything the workers could otherwise create lazily is created here first: atoms of every reactant and the data keys they set
+				for (int i=0; i < int(PendingReactions.size()); i++) {
+					for (int j=0; j < PendingReactions[i]->FNumReactants(); j++) {
+						if (PendingReactions[i]->GetReactant(j)->FNumAtoms() == 0) {
+							PendingReactions[i]->GetReactant(j)->TranslateFormulaToAtoms();
+						}
+					}
+				}
+				//Automatic balancing adds H+ and e- in the reaction compartment, so those species compartments must already exist
+				Species* HSpecies = NULL;
+				Species* ESpecies = NULL;
+				for (int i=0; i < FNumSpecies(); i++) {
+					if (HSpecies == NULL && GetSpecies(i)->FFormula().compare("H") == 0) {
+						HSpecies = GetSpecies(i);
+					} else if (ESpecies == NULL && GetSpecies(i)->FFormula().compare("E") == 0) {
+						ESpecies = GetSpecies(i);
 					}
-					if (GetParameter("Balanced reactions in gap filling only").compare("0") == 0 || NewReaction->GetData("UNBALANCED",STRING).length() == 0) {
-						NewReaction->SetType(NewReaction->CalculateDirectionalityFromThermo());
-						AddReaction(NewReaction);
+				}
+				if (HSpecies == NULL) {
+					HSpecies = FindSpecies("NAME","H+");
+				}
+				if (ESpecies == NULL) {
+					ESpecies = FindSpecies("NAME","e-");
+				}
+				for (int i=0; i < int(PendingReactions.size()); i++) {
+					AddCompartment(PendingReactions[i]->FCompartment());
+					if (HSpecies != NULL) {
+						HSpecies->AddCompartment(PendingReactions[i]->FCompartment());
+					}
+					if (ESpecies != NULL) {
+						ESpecies->AddCompartment(PendingReactions[i]->FCompartment());
+					}
+				}
+				Identity::DataKey("UNBALANCED");
+				Identity::DataKey("REACTION_TYPE_DATA");
+				Identity::DataKey("THERMO_CLASS");
+				vector<DeferredOutput*> Outputs(PendingReactions.size(),(DeferredOutput*)NULL);
+				for (int i=0; i < int(PendingReactions.size()); i++) {
+					Outputs[i] = new DeferredOutput;
+				}
+				vector<CompleteModelBatch> Batches(NumWorkers);
+				vector<pthread_t> Threads(NumWorkers);
+				vector<bool> Started(NumWorkers,false);
+				for (int i=0; i < NumWorkers; i++) {
+					Batches[i].Model = this;
+					Batches[i].Reactions = &PendingReactions;
+					Batches[i].Outputs = &Outputs;
+					Batches[i].Accepted = &PendingAccepted;
+					Batches[i].AllowedUnbalancedReactions = AllowedUnbalancedReactions;
+					Batches[i].BalancedOnly = BalancedOnly;
+					Batches[i].Worker = i;
+					Batches[i].NumWorkers = NumWorkers;
+					Started[i] = (pthread_create(&Threads[i],NULL,PrepareCompleteReactionBatch,&Batches[i]) == 0);
+				}
+				//A thread that could not be started has its share run here instead
+				for (int i=0; i < NumWorkers; i++) {
+					if (Started[i]) {
+						pthread_join(Threads[i],NULL);
 					} else {
-						for (int j=0; j < int(AllowedUnbalancedReactions->size()); j++) {
-							if (NewReaction->GetData("DATABASE",STRING).compare((*AllowedUnbalancedReactions)[j]) == 0) {
-								NewReaction->SetType(NewReaction->CalculateDirectionalityFromThermo());
-								AddReaction(NewReaction);
-								break;
-							}
-						}
+						PrepareCompleteReactionBatch(&Batches[i]);
 					}
 				}
+				for (int i=0; i < int(PendingReactions.size()); i++) {
+					ReplayDeferredOutput(Outputs[i]);
+					delete Outputs[i];
+				}
+			}
+			for (int i=0; i < int(Pending.size()); i++) {
+				Accepted[Pending[i]] = PendingAccepted[i];
+				CacheReaction(PendingIDs[i],PendingReactions[i],PendingAccepted[i] ? REACTION_CACHE_ACCEPTED : REACTION_CACHE_UNBALANCED);
+			}
+			SaveReactionCache();
+
+			//Reactions are added in database order so the model is identical for any number of threads
+			for (int i=0; i < int(Candidates.size()); i++) {
+				if (Accepted[i]) {
+					AddReaction(Candidates[i]);
+				}
 			}
 			delete DissapprovedCompartments;
 			delete AllowedUnbalancedReactions;
@@ -121,7 +653,8 @@ int Data::LoadSystem(string Filename, bool StructCues) {
 			Filename = GetDatabaseDirectory(true) + Filename;
 		}
 
-		if (!OpenInput(Input,Filename)) {
+		FileLineReader Input;
+		if (!OpenLineReader(Input,Filename)) {
 			return FAIL;
 		}
 
@@ -138,37 +671,29 @@ int Data::LoadSystem(string Filename, bool StructCues) {
 		bool CalcFormula = GetParameter("determine formula from structure file").compare("1") == 0;
 
 		vector<string>* Headers = NULL; 
-		do {
-			string Fileline = GetFileLine(Input);
-			if (Fileline.length() > 0) {
-				if (Fileline.compare("REACTIONS") == 0) {
-					if (Headers != NULL) {
-						delete Headers;
-					}
-					Headers = GetStringsFileline(Input,";");
+		vector<string> ReactionLines;
+		StringField Line;
+		vector<StringField> Fields;
+		while (ReadLine(Input,Line)) {
+			if (Line.Length > 0) {
+				bool HeaderLine = true;
+				if (FieldEquals(Line,"REACTIONS")) {
 					Reactions = true;
 					Compounds = false;
 					StructuralCues = false;
-				} else if (Fileline.compare("COMPOUNDS") == 0) {
-					if (Headers != NULL) {
-						delete Headers;
-					}
-					Headers = GetStringsFileline(Input,";");
+				} else if (FieldEquals(Line,"COMPOUNDS")) {
 					Reactions = false;
 					Compounds = true;
 					StructuralCues = false;
-				} else if (Fileline.compare("STRUCTURAL_CUES") == 0) {
-					if (Headers != NULL) {
-						delete Headers;
-					}
-					Headers = GetStringsFileline(Input,";");
+				} else if (FieldEquals(Line,"STRUCTURAL_CUES")) {
 					Reactions = false;
 					Compounds = false;
 					StructuralCues = true;
 				} else {
+					HeaderLine = false;
+					string Fileline(Line.Data,Line.Length);
 					if (Reactions) {
-						Reaction* Temp = AddReaction(Headers,Fileline);
-						Temp->PerformAllCalculations();
+						ReactionLines.push_back(Fileline);
 					} else if (Compounds) {
 						Species* Temp = AddSpecies(Headers,Fileline);
 						Temp->PerformAllCalculations(LabelAtoms,Stringcode,FindCycles,CalcProperties,CalcFormula);
@@ -176,8 +701,24 @@ int Data::LoadSystem(string Filename, bool StructCues) {
 						AddStructuralCue(Headers,Fileline);
 					} 
 				}
+				//Each section marker is followed by the header line for that section
+				if (HeaderLine) {
+					AddReactions(Headers,ReactionLines);
+					if (Headers != NULL) {
+						delete Headers;
+					}
+					Headers = new vector<string>;
+					if (ReadLine(Input,Line)) {
+						SplitFields(Line.Data,Line.Length,";",Fields);
+						for (int i=0; i < int(Fields.size()); i++) {
+							Headers->push_back(FieldToString(Fields[i]));
+						}
+					}
+				}
 			}
-		} while(!Input.eof());
+		}
+		CloseLineReader(Input);
+		AddReactions(Headers,ReactionLines);
 
 		if (Headers != NULL) {
 			delete Headers;
@@ -252,8 +793,6 @@ Species* Data::AddSpecies(string Filename) {
 		Temp->SetIndex(FNumSpecies());
 		InsertSpeciesDatabaseLinks(Temp);
 		SpeciesList.push_back(Temp);
-		SpeciesIT = SpeciesList.begin();
-		LastSpeciesIndex = 0;
 	}
 
 	return Temp;
@@ -274,8 +813,7 @@ Reaction* Data::AddReaction(string Filename) {
 		Temp->SetIndex(FNumReactions());
 		InsertReactionDatabaseLinks(Temp);
 		ReactionList.push_back(Temp);
-		ReactionIT = ReactionList.begin();
-		LastReactionIndex = 0;
+		GeneLogicChanged();
 	}
 
 	return Temp;
@@ -314,8 +852,6 @@ Gene* Data::AddGene(string Filename) {
 		Temp->SetIndex(FNumGenes());
 		InsertGeneDatabaseLinks(Temp);
 		GeneList.push_back(Temp);
-		GeneIT = GeneList.begin();
-		LastGeneIndex = 0;
 	}
 
 	return Temp;
@@ -333,6 +869,36 @@ Reaction* Data::AddReaction(vector<string>* InHeaders, string Fileline) {
 	return AddReaction(NewReaction);
 }
 
+void Data::AddReactions(vector<string>* InHeaders, vector<string>& Filelines) {
+	if (Filelines.size() == 0) {
+		return;
+	}
+	//Reactions loaded from the database by ID are fetched in one call, which reads their records in file order instead of one seek per reaction
+	int LoadColumn = -1;
+	for (int i=0; i < int(InHeaders->size()); i++) {
+		if ((*InHeaders)[i].compare("LOAD") == 0) {
+			LoadColumn = i;
+		}
+	}
+	StringDBTable* rxntbl = (LoadColumn == -1 || GetStringDB() == NULL) ? NULL : GetStringDB()->get_table("reaction");
+	if (rxntbl != NULL) {
+		vector<string> IDs;
+		vector<StringField> Fields;
+		for (int i=0; i < int(Filelines.size()); i++) {
+			if (SplitFields(Filelines[i],";",Fields,false) > LoadColumn) {
+				IDs.push_back(FieldToString(Fields[LoadColumn]));
+			}
+		}
+		vector<StringDBObject*> Objects;
+		rxntbl->get_objects(rxntbl->find_attribute(rxntbl->get_id_column()),IDs,Objects);
+	}
+	for (int i=0; i < int(Filelines.size()); i++) {
+		Reaction* Temp = AddReaction(InHeaders,Filelines[i]);
+		Temp->PerformAllCalculations();
+	}
+	Filelines.clear();
+}
+
 Species* Data::AddStructuralCue(vector<string>* InHeaders, string Fileline) {
 	Species* NewSpecies = new Species(InHeaders, Fileline,this,true);
 
@@ -351,8 +917,6 @@ Species* Data::AddSpecies(Species* NewSpecies) {
 		NewSpecies->SetIndex(FNumSpecies());
 		InsertSpeciesDatabaseLinks(NewSpecies);
 		SpeciesList.push_back(NewSpecies);
-		SpeciesIT = SpeciesList.begin();
-		LastSpeciesIndex = 0;
 	} else {
 		delete NewSpecies;
 	}
@@ -372,8 +936,7 @@ Reaction* Data::AddReaction(Reaction* NewReaction) {
 		NewReaction->SetIndex(FNumReactions());
 		InsertReactionDatabaseLinks(NewReaction);
 		ReactionList.push_back(NewReaction);
-		ReactionIT = ReactionList.begin();
-		LastReactionIndex = 0;
+		GeneLogicChanged();
 	} else {
 		if (Temp->FCompartment() != NewReaction->FCompartment()) {
 			NewReaction->SetData("DATABASE",(ID+"["+GetCompartment(NewReaction->FCompartment())->Abbreviation+"]").data(),STRING);
@@ -422,8 +985,7 @@ void Data::ClearGenes(int DeleteThem) {
 
 	GeneDatabaseLinks.clear();
 	GeneList.clear();
-	GeneIT = GeneList.begin();
-	LastGeneIndex = 0;
+	GeneLogicChanged();
 }
 
 void Data::ClearCompounds(int DeleteThem) {
@@ -435,8 +997,6 @@ void Data::ClearCompounds(int DeleteThem) {
 
 	CpdDatabaseLinks.clear();
 	SpeciesList.clear();
-	SpeciesIT = SpeciesList.begin();
-	LastSpeciesIndex = 0;
 }
 
 void Data::ClearReactions(int DeleteThem) {
@@ -448,8 +1008,7 @@ void Data::ClearReactions(int DeleteThem) {
 
 	RxnDatabaseLinks.clear();
 	ReactionList.clear();
-	ReactionIT = ReactionList.begin();
-	LastReactionIndex = 0;
+	GeneLogicChanged();
 }
 
 void Data::ClearStructuralCues() {
@@ -495,7 +1054,8 @@ void Data::ResetAllBools(bool NewMark, bool ResetMark, bool NewKill, bool ResetK
 }
 
 void Data::AddCompartment(int InIndex) {
-	if (InIndex > 0 && InIndex < FNumCompartments()) {
+	//Only the first call writes, so worker threads repeating a compartment the main thread already added just read the flag
+	if (InIndex > 0 && InIndex < FNumCompartments() && !RepresentedCompartments[InIndex]) {
 		RepresentedCompartments[InIndex] = true;
 	}
 }
@@ -503,13 +1063,14 @@ void Data::AddCompartment(int InIndex) {
 void Data::RemoveMarkedReactions(bool DeleteThem) {
 	RemoveMarkedFunctor<Reaction> RemovalFunctor;
 	RemovalFunctor.DeleteThem = DeleteThem;
-	ReactionList.remove_if(RemovalFunctor);
+	ReactionList.erase(remove_if(ReactionList.begin(),ReactionList.end(),RemovalFunctor),ReactionList.end());
+	GeneLogicChanged();
 }
 
 void Data::RemoveMarkedSpecies(bool DeleteThem) {
 	RemoveMarkedFunctor<Species> RemovalFunctor;
 	RemovalFunctor.DeleteThem = DeleteThem;
-	SpeciesList.remove_if(RemovalFunctor);
+	SpeciesList.erase(remove_if(SpeciesList.begin(),SpeciesList.end(),RemovalFunctor),SpeciesList.end());
 }
 
 void Data::InsertSpeciesDatabaseLinks(Species* InSpecies) {
@@ -590,6 +1151,7 @@ void Data::ReindexReactions() {
 	for (int i=0; i < FNumReactions(); i++) {
 		GetReaction(i)->SetIndex(i);
 	}
+	GeneLogicChanged();
 }
 
 void Data::ClearSpeciesDatabaseLinks() {
@@ -717,6 +1279,20 @@ void Data::LoadGeneDictionary() {
 	}
 };
 
+//Compiles the gene logic of every reaction into a single flat program so knockouts can be evaluated without walking the logic trees or reading gene marks
+void Data::CompileGeneLogic() {
+	CompiledNewGeneHandling = GetParameterHandle("new gene handling")->Bool;
+	CompiledGeneCount = FNumGenes();
+	CompiledGeneLogicVersion = GeneLogicVersion;
+	GeneLogicProgram.clear();
+	GeneLogicStart.clear();
+	for (int i=0; i < FNumReactions(); i++) {
+		GeneLogicStart.push_back(int(GeneLogicProgram.size()));
+		ReactionList[i]->CompileGeneLogic(CompiledNewGeneHandling,GeneLogicProgram);
+	}
+	GeneLogicStart.push_back(int(GeneLogicProgram.size()));
+}
+
 //Output
 Species* Data::GetStructuralCue(int InIndex) {
 	return StructuralCues[InIndex];
@@ -727,16 +1303,7 @@ int Data::FNumStructuralCues() {
 };
 
 Species* Data::GetSpecies(int InIndex) {
-	if (InIndex < LastSpeciesIndex) {
-		LastSpeciesIndex = 0;
-		SpeciesIT = SpeciesList.begin();
-	}
-	
-	for (int i = LastSpeciesIndex; i < InIndex; i++) {
-		SpeciesIT++;
-		LastSpeciesIndex++;
-	}
-	return (*SpeciesIT);
+	return SpeciesList[InIndex];
 };
 
 int Data::FNumSpecies() {
@@ -744,16 +1311,7 @@ int Data::FNumSpecies() {
 };
 
 Reaction* Data::GetReaction(int InIndex) {
-	if (InIndex < LastReactionIndex || InIndex == 0 || LastReactionIndex == 0) {
-		LastReactionIndex = 0;
-		ReactionIT = ReactionList.begin();
-	}
-	
-	for (int i = LastReactionIndex; i < InIndex; i++) {
-		ReactionIT++;
-		LastReactionIndex++;
-	}
-	return (*ReactionIT);
+	return ReactionList[InIndex];
 };
 
 int Data::FNumReactions() {
@@ -761,16 +1319,7 @@ int Data::FNumReactions() {
 };
 
 Gene* Data::GetGene(int InIndex) {
-	if (InIndex < LastGeneIndex || InIndex == 0 || LastGeneIndex == 0) {
-		LastGeneIndex = 0;
-		GeneIT = GeneList.begin();
-	}
-	
-	for (int i = LastGeneIndex; i < InIndex; i++) {
-		GeneIT++;
-		LastGeneIndex++;
-	}
-	return (*GeneIT);
+	return GeneList[InIndex];
 };	
 
 int Data::FNumGenes() {
@@ -822,10 +1371,15 @@ Species* Data::FindSpecies(const char* DatabaseName,const char* DataID) {
 	string StrDBName(DatabaseName);
 	vector<string>* Strings = StringToStrings(StrDBName,";");
 	for (int i=0; i < int(Strings->size()); i++) {
-		Species* Temp = CpdDatabaseLinks[(*Strings)[i]][StrDataID];
-		if (Temp != NULL) {
+		//Lookups never insert, so the complete model build can search species from its worker threads
+		map<string, map<string, Species*, std::less<string> >, std::less<string> >::iterator DatabaseIT = CpdDatabaseLinks.find((*Strings)[i]);
+		if (DatabaseIT == CpdDatabaseLinks.end()) {
+			continue;
+		}
+		map<string, Species*, std::less<string> >::iterator SpeciesIT = DatabaseIT->second.find(StrDataID);
+		if (SpeciesIT != DatabaseIT->second.end() && SpeciesIT->second != NULL) {
 			delete Strings;
-			return Temp;
+			return SpeciesIT->second;
 		}
 	}
 	delete Strings;
@@ -890,8 +1444,48 @@ Species* Data::GetHydrogenSpecies() {
 	return HydrogenSpecies;
 }
 
+//Sets ReactionKO[i] for every reaction i disabled when the genes flagged in GeneKO (indexed like GetGene) are knocked out
+void Data::FindKnockedOutReactions(vector<bool>& GeneKO, vector<bool>& ReactionKO) {
+	static ParameterHandle* NewGeneHandling = GetParameterHandle("new gene handling");
+	if (CompiledGeneLogicVersion != GeneLogicVersion || CompiledGeneCount != FNumGenes() || int(GeneLogicStart.size()) != FNumReactions()+1 || CompiledNewGeneHandling != NewGeneHandling->Bool) {
+		CompileGeneLogic();
+	}
+	int NumReactions = int(GeneLogicStart.size())-1;
+	ReactionKO.assign(NumReactions,false);
+	vector<char> Stack(GeneLogicProgram.size()/2+1);
+	for (int i=0; i < NumReactions; i++) {
+		int Top = 0;
+		for (int j=GeneLogicStart[i]; j < GeneLogicStart[i+1]; j += 2) {
+			int Argument = GeneLogicProgram[j+1];
+			if (GeneLogicProgram[j] == GPR_GENE) {
+				Stack[Top] = (Argument < int(GeneKO.size()) && GeneKO[Argument]);
+				Top++;
+			} else {
+				//Collapsing the operands of a logic node into its own knockout state
+				bool Result = (GeneLogicProgram[j] == GPR_ALL_KO);
+				for (int k=Top-Argument; k < Top; k++) {
+					if (GeneLogicProgram[j] == GPR_ALL_KO) {
+						Result = Result && Stack[k];
+					} else {
+						Result = Result || Stack[k];
+					}
+				}
+				Top -= Argument;
+				Stack[Top] = Result;
+				Top++;
+			}
+		}
+		ReactionKO[i] = (Top > 0 && Stack[Top-1]);
+	}
+}
+
+void Data::GeneLogicChanged() {
+	GeneLogicVersion++;
+}
+
 //Analysis functions
-void Data::PerformAllRequestedTasks() {
+int Data::PerformAllRequestedTasks() {
+	int Status = SUCCESS;
 	if (GetParameter("Generate subnetwork").compare("1") == 0) {
 		GenerateBNICESubnetwork();
 	}
@@ -902,7 +1496,7 @@ void Data::PerformAllRequestedTasks() {
 		SequenceGenes();
 	}
 	if (GetParameter("perform MFA").compare("1") == 0) {
-		PerformMFA();
+		Status = PerformMFA();
 	}
 	if (GetParameter("poll structural cues").compare("1") == 0) {
 		PollStructuralCues();
@@ -917,6 +1511,7 @@ void Data::PerformAllRequestedTasks() {
 		LabelKEGGCofactorPairs();
 		PrintReactionNetwork();
 	}
+	return Status;
 }
 
 //This function is necessary for sorting the cycles by size
@@ -1180,7 +1775,7 @@ void Data::SearchForPathways() {
 	}
 }
 
-void Data::PerformMFA() {
+int Data::PerformMFA() {
 	MakeDirectory((FOutputFilepath()+"MFAOutput/").data());
 	
 	//Reading in the user-set parameters for the MFA
@@ -1192,46 +1787,46 @@ void Data::PerformMFA() {
 
 	//Running the gap generation
 	if (GetParameter("Perform gap generation").compare("1") == 0) {
-		NewProblem->GapGeneration(this,NewParameters);
+		int Status = NewProblem->GapGeneration(this,NewParameters);
 		ClearParameters(NewParameters);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
 	//Running the solution reconciliation
 	if (GetParameter("Perform solution reconciliation").compare("1") == 0) {
-		NewProblem->SolutionReconciliation(this,NewParameters);
+		int Status = NewProblem->SolutionReconciliation(this,NewParameters);
 		ClearParameters(NewParameters);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
 	//Fitting microarray data
 	if (GetParameter("Microarray assertions").length() > 0 && GetParameter("Microarray assertions").compare("NONE") != 0) {
-		NewProblem->FitMicroarrayAssertions(this);
+		int Status = NewProblem->FitMicroarrayAssertions(this);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
 	//Fitting gimme data
 	if (GetParameter("Gene Inactivity Moderated by Metabolism and Expression").length() > 0 && GetParameter("Gene Inactivity Moderated by Metabolism and Expression").compare("NONE") != 0) {
-		NewProblem->FitGIMME(this);
+		int Status = NewProblem->FitGIMME(this);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
 	//Do soft constraint, then report flux.
 	if (GetParameter("Soft Constraint").length() > 0 && GetParameter("Soft Constraint").compare("NONE") != 0) {
-		NewProblem->SoftConstraint(this);
+		int Status = NewProblem->SoftConstraint(this);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
 	//Generating pathways to objective
 	if (GetParameter("Generate pathways to objective").compare("1") == 0) {
-		NewProblem->GenerateMinimalReactionLists(this);
+		int Status = NewProblem->GenerateMinimalReactionLists(this);
 		delete NewProblem;
-		return;
+		return Status;
 	}	
 
 	//Running the gap filling
@@ -1250,12 +1845,13 @@ void Data::PerformMFA() {
 		SetParameter("Reactions knocked out in gap filling","none");
 		
 		//Running the gap filling algorithm
+		int Status = SUCCESS;
 		if (GetParameter("Complete gap filling").compare("1") == 0) {
-			NewProblem->CompleteGapFilling(this,NewParameters);
+			Status = NewProblem->CompleteGapFilling(this,NewParameters);
 			ClearParameters(NewParameters);
 			delete NewProblem;
 		} else if (GetParameter("Gap filling runs").compare("none") == 0) {
-			NewProblem->GapFilling(this,NewParameters);
+			Status = NewProblem->GapFilling(this,NewParameters);
 			ClearParameters(NewParameters);
 			delete NewProblem;
 		} else {
@@ -1275,7 +1871,9 @@ void Data::PerformMFA() {
 						}
 					}
 					//Running the gap filling
-					NewProblem->GapFilling(this,NewParameters,(*RunData)[0]);
+					if (NewProblem->GapFilling(this,NewParameters,(*RunData)[0]) == FAIL) {
+						Status = FAIL;
+					}
 					//Deleting the vectors
 					delete ReactionList;
 					delete RunData;
@@ -1284,70 +1882,103 @@ void Data::PerformMFA() {
 				} else {
 					FErrorFile() << "Could not load media " << (*RunData)[1] << endl;
 					FlushErrorFile();
+					Status = FAIL;
 				}
 			}
 			ClearParameters(NewParameters);
 			delete NewProblem;
 			delete Runs;
 		}
-		return;
+		return Status;
 	}
 	//Building MFA object based on user settings and database
-	NewProblem->BuildMFAProblem(this,NewParameters);
+	if (NewProblem->BuildMFAProblem(this,NewParameters) == FAIL) {
+		ClearParameters(NewParameters);
+		delete NewProblem;
+		return FAIL;
+	}
 
 	double ObjectiveValue = FLAG;
 	if (GetParameter("run media experiments").compare("1") == 0) {
-		NewProblem->RunMediaExperiments(this,NewParameters,ObjectiveValue,GetParameter("maximize single objective").compare("1") == 0,GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0);	
+		int Status = NewProblem->RunMediaExperiments(this,NewParameters,ObjectiveValue,GetParameter("maximize single objective").compare("1") == 0,GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0);	
 		ClearParameters(NewParameters);
 		delete NewProblem;
-		return;
+		return Status;
 	}
 
+	if (GetParameter("Batch job file").compare("none") != 0) {
+		int Status = NewProblem->RunBatchJobs(this,NewParameters);
+		ClearParameters(NewParameters);
+		delete NewProblem;
+		return Status;
+	}
+
+	//Each requested analysis still runs when an earlier one fails, but the failure is reported to the caller
+	int Status = SUCCESS;
 	if (NewParameters->DoRecursiveMILPStudy && GetParameter("maximize single objective").compare("1") != 0) {
-		NewProblem->RecursiveMILPStudy(this,NewParameters,false);
+		if (NewProblem->RecursiveMILPStudy(this,NewParameters,false) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (GetParameter("identify type 3 pathways").compare("1") == 0) {
-		NewProblem->IdentifyReactionLoops(this,NewParameters);
+		if (NewProblem->IdentifyReactionLoops(this,NewParameters) == FAIL) {
+			Status = FAIL;
+		}
 	}
 	
 	if (GetParameter("maximize single objective").compare("1") == 0) {
 		string Note;
 		NewParameters->RelaxIntegerVariables = (GetParameter("relax integer variables when possible").compare("1") == 0);
-		NewProblem->OptimizeSingleObjective(this,NewParameters,GetParameter("objective"),GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,ObjectiveValue,Note);	
+		if (NewProblem->OptimizeSingleObjective(this,NewParameters,GetParameter("objective"),GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,ObjectiveValue,Note) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (GetParameter("run reaction addition experiments").compare("1") == 0) {
-		NewProblem->OptimizeIndividualForeignReactions(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0);
+		if (NewProblem->OptimizeIndividualForeignReactions(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (GetParameter("maximize single objective").compare("1") == 0 && GetParameter("run exploration experiments").compare("1") == 0) {
-		NewProblem->ExploreSplittingRatios(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0);	
+		if (NewProblem->ExploreSplittingRatios(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	//Finding tight bounds if the user has requested
 	if (GetParameter("find tight bounds").compare("1") == 0 && GetParameter("maximize single objective").compare("1") != 0) {
 		string Note;
-		NewProblem->FindTightBounds(this,NewParameters,Note);
+		if (NewProblem->FindTightBounds(this,NewParameters,Note) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (NewParameters->DoFluxCouplingAnalysis && GetParameter("run media experiments").compare("1") != 0 && GetParameter("maximize single objective").compare("1") != 0) {
 		string Note;
-		NewProblem->FluxCouplingAnalysis(this,NewParameters,true,Note,false);
+		if (NewProblem->FluxCouplingAnalysis(this,NewParameters,true,Note,false) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (GetParameter("maximize individual metabolite production").compare("1") == 0) {
 		string Note;
-		NewProblem->CheckIndividualMetaboliteProduction(this,NewParameters,GetParameter("metabolites to optimize"),GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,Note,false);
+		if (NewProblem->CheckIndividualMetaboliteProduction(this,NewParameters,GetParameter("metabolites to optimize"),GetParameter("find tight bounds").compare("1") == 0,GetParameter("Minimize the number of foreign reactions").compare("1") == 0,Note,false) == FAIL) {
+			Status = FAIL;
+		}
 	}
 
 	if (GetParameter("optimize individual foreign reactions").compare("1") == 0 && GetParameter("Load foreign reaction database").compare("1") == 0) {
 		string Note;
-		NewProblem->OptimizeIndividualForeignReactions(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0);
+		if (NewProblem->OptimizeIndividualForeignReactions(this,NewParameters,GetParameter("find tight bounds").compare("1") == 0,GetParameter("maximize individual metabolite production").compare("1") == 0) == FAIL) {
+			Status = FAIL;
+		}
 	}
 	//Clearing memmory
 	ClearParameters(NewParameters);
 	delete NewProblem;
+	return Status;
 }
 
 void Data::PollStructuralCues() {
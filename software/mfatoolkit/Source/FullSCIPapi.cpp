@@ -2,241 +2,421 @@
 #include "objscip/objscipdefplugins.h"
 #include "MFAToolkit.h"
 
-SCIP* scippointer;
-vector<SCIP_VAR*> SCIPVars;
-vector<SCIP_CONS*> SCIPCons;
-bool ScipSenseMax = false;
+//SCIP state held in SolverContext::SCIPModel
+//The problem stays in memory between solves; SCIP only accepts changes to the original problem, so the transformed problem is freed before any change
+struct SCIPProblemData {
+	SCIP* scippointer;
+	vector<SCIP_VAR*> SCIPVars;
+	vector<SCIP_CONS*> SCIPCons;
+	bool Transformed;
+};
 
-int InitializeSCIPVariables() {
-	scippointer = NULL;
+bool SCIPCallFailed(SCIP_RETCODE Code, const char* Action) {
+	if (Code != SCIP_OKAY) {
+		FErrorFile() << "SCIP failed to " << Action << ". Return code: " << int(Code) << endl;
+		FlushErrorFile();
+		return true;
+	}
+	return false;
+}
 
+int SCIPPrepareForChange(SCIPProblemData* Problem) {
+	if (Problem == NULL || Problem->scippointer == NULL) {
+		FErrorFile() << "Cannot change SCIP problem because it does not exist." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+	if (Problem->Transformed) {
+		if (SCIPCallFailed(SCIPfreeTransform(Problem->scippointer),"free the transformed problem")) {
+			return FAIL;
+		}
+		Problem->Transformed = false;
+	}
 	return SUCCESS;
 }
 
-int SCIPInitialize() {
-	if (scippointer == NULL) {
-		SCIP_CALL( SCIPcreate(&scippointer) );
-		SCIP_CALL( SCIPincludeDefaultPlugins(scippointer) );
+int SCIPCreateConstraint(SCIPProblemData* Problem, LinEquation* InEquation, int Index, int NumVariables, SCIP_VAR** vars, SCIP_Real* coefs, SCIP_CONS** NewConstraint) {
+	SCIP_Real lhs;
+	SCIP_Real rhs;
+	if (InEquation->EqualityType == EQUAL) {
+		lhs = InEquation->RightHandSide;
+		rhs = InEquation->RightHandSide;
+	} else if (InEquation->EqualityType == LESS) {
+		lhs = -SCIPinfinity(Problem->scippointer);
+		rhs = InEquation->RightHandSide;
+	} else if (InEquation->EqualityType == GREATER) {
+		lhs = InEquation->RightHandSide;
+		rhs = SCIPinfinity(Problem->scippointer);
 	} else {
-		SCIPClearSolver();
+		FErrorFile() << "Unrecognized constraint type: " << InEquation->ConstraintType << endl;
+		FlushErrorFile();
+		return FAIL;
 	}
 
-	// initialize SCIP 
-	SCIP_CALL( SCIPcreateProb(scippointer, "ProblemOne", 0, 0, 0, 0, 0, 0) );
+	if (SCIPCallFailed(SCIPcreateConsBasicLinear(Problem->scippointer, NewConstraint, itoa(Index), NumVariables, vars, coefs, lhs, rhs),"create constraint")) {
+		return FAIL;
+	}
+	if (SCIPCallFailed(SCIPaddCons(Problem->scippointer, *NewConstraint),"add constraint")) {
+		return FAIL;
+	}
+	return SUCCESS;
+}
 
+int InitializeSCIPVariables() {
 	return SUCCESS;
 }
 
+bool SCIPSolvesInProcess() {
+	return true;
+}
 
-int SCIPCleanup() {
-	if (scippointer != NULL) {
-		SCIP_CALL( SCIPfreeProb(scippointer) );
-		SCIP_CALL( SCIPfree(&scippointer) );
-		scippointer = NULL;
-		//I may need to delete the variables as well, but I'm not sure
-		SCIPVars.clear();
-		SCIPCons.clear();
+int SCIPInitialize(SolverContext* Context) {
+	SCIPClearSolver(Context);
+	SCIPProblemData* Problem = new SCIPProblemData;
+	Problem->scippointer = NULL;
+	Problem->Transformed = false;
+	Context->SCIPModel = Problem;
+	if (SCIPCallFailed(SCIPcreate(&Problem->scippointer),"create SCIP environment")) {
+		return FAIL;
+	}
+	if (SCIPCallFailed(SCIPincludeDefaultPlugins(Problem->scippointer),"include default plugins")) {
+		return FAIL;
 	}
+	// initialize SCIP
+	if (SCIPCallFailed(SCIPcreateProbBasic(Problem->scippointer, "ProblemOne"),"create problem")) {
+		return FAIL;
+	}
+	SCIPsetIntParam(Problem->scippointer, "display/verblevel", 0);
 
 	return SUCCESS;
 }
 
-int SCIPClearSolver() {
-	if (scippointer != NULL) {
-		SCIP_CALL( SCIPfreeProb(scippointer) );
-		//I may need to delete the variables as well, but I'm not sure
-		SCIPVars.clear();
-		SCIPCons.clear();
+int SCIPCleanup(SolverContext* Context) {
+	return SCIPClearSolver(Context);
+}
+
+int SCIPClearSolver(SolverContext* Context) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (Problem == NULL) {
+		return SUCCESS;
+	}
+	Context->SCIPModel = NULL;
+	int Status = SUCCESS;
+	if (Problem->scippointer != NULL) {
+		//Releasing the references held here lets SCIPfree release the variables and constraints with the problem
+		for (int i=0; i < int(Problem->SCIPCons.size()); i++) {
+			if (Problem->SCIPCons[i] != NULL && SCIPCallFailed(SCIPreleaseCons(Problem->scippointer,&(Problem->SCIPCons[i])),"release constraint")) {
+				Status = FAIL;
+			}
+		}
+		for (int i=0; i < int(Problem->SCIPVars.size()); i++) {
+			if (SCIPCallFailed(SCIPreleaseVar(Problem->scippointer,&(Problem->SCIPVars[i])),"release variable")) {
+				Status = FAIL;
+			}
+		}
+		if (SCIPCallFailed(SCIPfree(&Problem->scippointer),"free SCIP environment")) {
+			Status = FAIL;
+		}
 	}
+	delete Problem;
 
-	return SUCCESS;
+	return Status;
 }
 
-int SCIPPrintFromSolver() {
-	int Status = 0;
-	if (scippointer == NULL) {
+int SCIPPrintFromSolver(SolverContext* Context) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (Problem == NULL || Problem->scippointer == NULL) {
 		FErrorFile() << "Cannot print problem to file because SCIP environment is not open." << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
 
-	if (SCIPVars.size() == 0) {
+	if (Problem->SCIPVars.size() == 0) {
 		FErrorFile() << "Cannot print problem to file because no SCIP model exists." << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
-	
-	cout << GetParameter("LP filename").data() << endl;
-	SCIP_CALL(SCIPprintOrigProblem(scippointer, 0));
-	//SCIP_CALL( SCIPwriteLP(scippointer,GetParameter("LP filename").data()));
+
+	string Filename = CheckFilename(FOutputFilepath()+GetParameter("LP filename"));
+	if (SCIPCallFailed(SCIPwriteOrigProblem(Problem->scippointer,Filename.data(),"lp",FALSE),"write problem to file")) {
+		return FAIL;
+	}
 
 	return SUCCESS;
 }
 
-OptSolutionData* SCIPRunSolver(int ProbType) {
-	SCIPsolve(scippointer);
-	
-	SCIP_SOL* NewScipSolution = SCIPgetBestSol(scippointer);
-	if (NewScipSolution == NULL) {
+OptSolutionData* SCIPRunSolver(SolverContext* Context, int ProbType) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (Problem == NULL || Problem->scippointer == NULL) {
+		FErrorFile() << "Cannot optimize because SCIP problem does not exist." << endl;
+		FlushErrorFile();
 		return NULL;
 	}
 
-	OptSolutionData* NewSolution = new OptSolutionData;;
-	NewSolution->Status = SUCCESS;
-	SCIP_VAR** vars = new SCIP_VAR*[SCIPVars.size()];
-	SCIP_Real* vals = new SCIP_Real[SCIPVars.size()];
-	for (int i=0; i < int(SCIPVars.size()); i++) {
-		vars[i] = SCIPVars[i];
+	//A solve left over from an earlier call must be discarded so SCIP starts from the current problem
+	if (SCIPPrepareForChange(Problem) != SUCCESS) {
+		return NULL;
 	}
 
-	SCIPgetVarSols(scippointer,int(SCIPVars.size()),vars,vals);
+	if (GetParameter("CPLEX solver time limit").length() > 0 && GetParameter("CPLEX solver time limit").compare("none") != 0) {
+		if (SCIPCallFailed(SCIPsetRealParam(Problem->scippointer,"limits/time",atof(GetParameter("CPLEX solver time limit").data())),"set time limit")) {
+			return NULL;
+		}
+	}
 
-	NewSolution->NumVariables = int(SCIPVars.size());
-	NewSolution->SolutionData.resize(int(SCIPVars.size()));
-	for (int i=0; i < int(SCIPVars.size()); i++) {
-		NewSolution->SolutionData[i] = vals[i];
+	Context->Stats.NumColumns = SCIPgetNVars(Problem->scippointer);
+	Context->Stats.NumRows = SCIPgetNConss(Problem->scippointer);
+	Problem->Transformed = true;
+	if (SCIPCallFailed(SCIPsolve(Problem->scippointer),"optimize problem")) {
+		return NULL;
 	}
-	delete [] vars;
-	delete [] vals;
+	Context->Stats.Iterations = int(SCIPgetNLPIterations(Problem->scippointer));
+	Context->Stats.Nodes = int(SCIPgetNNodes(Problem->scippointer));
+	Context->Stats.MIPGap = SCIPgetGap(Problem->scippointer);
 
-	NewSolution->Objective = SCIPgetLPObjval(scippointer);
+	OptSolutionData* NewSolution = new OptSolutionData;
+	SCIP_STATUS ScipStatus = SCIPgetStatus(Problem->scippointer);
+	SCIP_SOL* NewScipSolution = SCIPgetBestSol(Problem->scippointer);
+	if (ScipStatus == SCIP_STATUS_UNBOUNDED) {
+		cout << "Model is unbounded" << endl;
+		FErrorFile() << "Model is unbounded" << endl;
+		FlushErrorFile();
+		NewSolution->Status = UNBOUNDED;
+		return NewSolution;
+	} else if (ScipStatus == SCIP_STATUS_INFEASIBLE) {
+		cout << "Model is infeasible" << endl;
+		FErrorFile() << "Model is infeasible" << endl;
+		FlushErrorFile();
+		NewSolution->Status = INFEASIBLE;
+		return NewSolution;
+	} else if (ScipStatus == SCIP_STATUS_INFORUNBD) {
+		cout << "Model is infeasible or unbounded" << endl;
+		FErrorFile() << "Model is infeasible or unbounded" << endl;
+		FlushErrorFile();
+		NewSolution->Status = INFEASIBLE;
+		return NewSolution;
+	} else if (NewScipSolution == NULL) {
+		//A limit was hit before any feasible solution was found
+		cout << "No solution found before SCIP stopped" << endl;
+		NewSolution->Status = INFEASIBLE;
+		return NewSolution;
+	}
+	NewSolution->Status = SUCCESS;
 
-	if (ScipSenseMax) {
-		NewSolution->Objective = -NewSolution->Objective;
+	NewSolution->NumVariables = int(Problem->SCIPVars.size());
+	NewSolution->SolutionData.resize(Problem->SCIPVars.size());
+	for (int i=0; i < int(Problem->SCIPVars.size()); i++) {
+		NewSolution->SolutionData[i] = SCIPgetSolVal(Problem->scippointer,NewScipSolution,Problem->SCIPVars[i]);
 	}
+	//The objective of the original problem already carries the right sense
+	NewSolution->Objective = SCIPgetSolOrigObj(Problem->scippointer,NewScipSolution);
 
 	cout << "Objective value: " << NewSolution->Objective << endl;
 
 	return NewSolution;
 }
 
-int SCIPLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
-	int Status = 0;
-	
+int SCIPLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (SCIPPrepareForChange(Problem) != SUCCESS) {
+		return FAIL;
+	}
+
 	double UpperBound = InVariable->UpperBound;
 	double LowerBound = InVariable->LowerBound;
 	if (UseTightBounds) {
 		UpperBound = InVariable->Max;
-		LowerBound = InVariable->Max;
+		LowerBound = InVariable->Min;
+	}
+
+	SCIP_VARTYPE Type = SCIP_VARTYPE_CONTINUOUS;
+	if (InVariable->Binary && !RelaxIntegerVariables) {
+		Type = SCIP_VARTYPE_BINARY;
+	} else if (InVariable->Integer && !RelaxIntegerVariables) {
+		Type = SCIP_VARTYPE_INTEGER;
 	}
 
 	//First I check the number of columns. If it's larger than the index, then this variable already exists and is only being changed
-	int NumberColumns = int(SCIPVars.size());
+	int NumberColumns = int(Problem->SCIPVars.size());
 	if (NumberColumns <= InVariable->Index) {
 		string StrName("x");
 		StrName.append(itoa(InVariable->Index+1));
 
 		SCIP_VAR* NewVariable;
-		
-		if (InVariable->Binary && !RelaxIntegerVariables) { 
-			SCIP_CALL( SCIPcreateVar(scippointer,&NewVariable,StrName.data(),LowerBound,UpperBound,0.0,SCIP_VARTYPE_BINARY,true,false,NULL,NULL,NULL,NULL));
-		} else if (InVariable->Integer && !RelaxIntegerVariables) {
-			SCIP_CALL( SCIPcreateVar(scippointer,&NewVariable,StrName.data(),LowerBound,UpperBound,0.0,SCIP_VARTYPE_INTEGER ,true,false,NULL,NULL,NULL,NULL));
-		} else {
-			SCIP_CALL( SCIPcreateVar(scippointer,&NewVariable,StrName.data(),LowerBound,UpperBound,0.0,SCIP_VARTYPE_CONTINUOUS,true,false,NULL,NULL,NULL,NULL));
-		}
-		
-		SCIP_CALL( SCIPcaptureVar(scippointer, NewVariable) );
-		SCIP_CALL( SCIPaddVar(scippointer, NewVariable) );
-		
-		SCIPVars.push_back(NewVariable);
+		if (SCIPCallFailed(SCIPcreateVarBasic(Problem->scippointer,&NewVariable,StrName.data(),LowerBound,UpperBound,0.0,Type),"create variable")) {
+			return FAIL;
+		}
+		if (SCIPCallFailed(SCIPaddVar(Problem->scippointer, NewVariable),"add variable")) {
+			return FAIL;
+		}
+		Problem->SCIPVars.push_back(NewVariable);
 	} else {
-		SCIP_CALL( SCIPchgVarLb(scippointer, SCIPVars[InVariable->Index], LowerBound) );
-		SCIP_CALL( SCIPchgVarUb(scippointer, SCIPVars[InVariable->Index], UpperBound) );
-		
-		if (InVariable->Binary && !RelaxIntegerVariables) { 
-			SCIP_CALL( SCIPchgVarType(scippointer, SCIPVars[InVariable->Index], SCIP_VARTYPE_BINARY));
-		} else if (InVariable->Integer && !RelaxIntegerVariables) {
-			SCIP_CALL( SCIPchgVarType(scippointer, SCIPVars[InVariable->Index], SCIP_VARTYPE_INTEGER));
-		} else {
-			SCIP_CALL( SCIPchgVarType(scippointer, SCIPVars[InVariable->Index], SCIP_VARTYPE_CONTINUOUS));
+		SCIP_VAR* CurrentVariable = Problem->SCIPVars[InVariable->Index];
+		if (SCIPCallFailed(SCIPchgVarLb(Problem->scippointer, CurrentVariable, LowerBound),"change variable lower bound")) {
+			return FAIL;
+		}
+		if (SCIPCallFailed(SCIPchgVarUb(Problem->scippointer, CurrentVariable, UpperBound),"change variable upper bound")) {
+			return FAIL;
+		}
+		SCIP_Bool Infeasible = FALSE;
+		if (SCIPCallFailed(SCIPchgVarType(Problem->scippointer, CurrentVariable, Type, &Infeasible),"change variable type")) {
+			return FAIL;
 		}
 	}
 
 	return SUCCESS;
 }
 
-int SCIPLoadObjective(LinEquation* InEquation, bool Max) {
-	int NumCols = int(SCIPVars.size());
+int SCIPLoadProblem(SolverContext* Context, SolverMatrix* InMatrix) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (Problem == NULL || Problem->SCIPVars.size() > 0 || Problem->SCIPCons.size() > 0) {
+		FErrorFile() << "Cannot load problem in bulk because the SCIP problem does not exist or is not empty." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	//SCIP has no call for adding many variables at once, so columns still go through SCIPLoadVariables
+	for (int i=0; i < int(InMatrix->Variables.size()); i++) {
+		if (SCIPLoadVariables(Context,InMatrix->Variables[i],InMatrix->RelaxIntegerVariables,InMatrix->UseTightBounds) != SUCCESS) {
+			return FAIL;
+		}
+	}
+
+	//Rows are built straight from the compressed matrix, reusing one pair of buffers
+	int MaxRowLength = 0;
+	for (int i=0; i < int(InMatrix->Constraints.size()); i++) {
+		if (InMatrix->RowStart[i+1]-InMatrix->RowStart[i] > MaxRowLength) {
+			MaxRowLength = InMatrix->RowStart[i+1]-InMatrix->RowStart[i];
+		}
+	}
+	vector<SCIP_VAR*> vars(MaxRowLength+1);
+	vector<SCIP_Real> coefs(MaxRowLength+1);
+	for (int i=0; i < int(InMatrix->Constraints.size()); i++) {
+		LinEquation* CurrentConstraint = InMatrix->Constraints[i];
+		if (CurrentConstraint->ConstraintType != LINEAR) {
+			FErrorFile() << "This constraint type is not supported in SCIP: " << CurrentConstraint->ConstraintType << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+		int Length = 0;
+		for (int j=InMatrix->RowStart[i]; j < InMatrix->RowStart[i+1]; j++) {
+			vars[Length] = Problem->SCIPVars[InMatrix->Columns[j]];
+			coefs[Length] = InMatrix->Coefficients[j];
+			Length++;
+		}
+		SCIP_CONS* NewConstraint = NULL;
+		if (SCIPCreateConstraint(Problem,CurrentConstraint,i,Length,&(vars[0]),&(coefs[0]),&NewConstraint) != SUCCESS) {
+			return FAIL;
+		}
+		Problem->SCIPCons.push_back(NewConstraint);
+	}
+
+	return SUCCESS;
+}
+
+int SCIPLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (SCIPPrepareForChange(Problem) != SUCCESS) {
+		return FAIL;
+	}
+
+	if (InEquation->QuadCoeff.size() > 0) {
+		FErrorFile() << "SCIP interface cannot accept quadratic objectives." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
 
 	if (Max) {
-		SCIP_CALL( SCIPsetObjsense(scippointer, SCIP_OBJSENSE_MAXIMIZE) );
-		ScipSenseMax = true;
+		if (SCIPCallFailed(SCIPsetObjsense(Problem->scippointer, SCIP_OBJSENSE_MAXIMIZE),"set objective sense")) {
+			return FAIL;
+		}
 	} else {
-		SCIP_CALL( SCIPsetObjsense(scippointer, SCIP_OBJSENSE_MINIMIZE) );
-		ScipSenseMax = false;
+		if (SCIPCallFailed(SCIPsetObjsense(Problem->scippointer, SCIP_OBJSENSE_MINIMIZE),"set objective sense")) {
+			return FAIL;
+		}
 	}
-	
-	for (int i=0; i < int(SCIPVars.size()); i++) {
-		SCIP_CALL( SCIPchgVarObj(scippointer, SCIPVars[i],0));
+
+	for (int i=0; i < int(Problem->SCIPVars.size()); i++) {
+		if (SCIPCallFailed(SCIPchgVarObj(Problem->scippointer, Problem->SCIPVars[i],0),"reset objective coefficient")) {
+			return FAIL;
+		}
 	}
-	
+
 	for (int i=0; i < int(InEquation->Variables.size()); i++) {
-		if (InEquation->Variables[i]->Index >= int(SCIPVars.size())) {
+		if (InEquation->Variables[i]->Index >= int(Problem->SCIPVars.size())) {
 			FErrorFile() << "Objective variable index out of the range of variable indecies currently loaded into the solver." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
-		SCIP_CALL( SCIPchgVarObj(scippointer, SCIPVars[InEquation->Variables[i]->Index], InEquation->Coefficient[i]));
+		if (SCIPCallFailed(SCIPchgVarObj(Problem->scippointer, Problem->SCIPVars[InEquation->Variables[i]->Index], InEquation->Coefficient[i]),"set objective coefficient")) {
+			return FAIL;
+		}
 	}
-	
+
 	return SUCCESS;
 }
 
-int SCIPAddConstraint(LinEquation* InEquation) {
-	int Status = 0;
-	
+int SCIPAddConstraint(SolverContext* Context, LinEquation* InEquation) {
+	SCIPProblemData* Problem = (SCIPProblemData*)Context->SCIPModel;
+	if (SCIPPrepareForChange(Problem) != SUCCESS) {
+		return FAIL;
+	}
+
 	if (InEquation->ConstraintType != LINEAR) {
 		FErrorFile() << "This constraint type is not supported in SCIP: " << InEquation->ConstraintType << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
 
-	//First I check the number of rows. If it's larger than the index, then this constraint already exists and is only being changed
-	int NumberRows = int(SCIPCons.size());
-	if (NumberRows <= InEquation->Index) {
-		SCIP_Real lhs;
-		SCIP_Real rhs;
-		
-		if (InEquation->EqualityType == EQUAL) {
-			lhs = InEquation->RightHandSide;
-			rhs = InEquation->RightHandSide;
-		} else if (InEquation->EqualityType == LESS) {
-			lhs = -SCIPinfinity(scippointer);
-			rhs = InEquation->RightHandSide;
-		} else if (InEquation->EqualityType == GREATER) {
-			lhs = InEquation->RightHandSide;
-			rhs = SCIPinfinity(scippointer);
-		} else {
-			FErrorFile() << "Unrecognized constraint type: " << InEquation->ConstraintType << endl;
+	int NumberRows = int(Problem->SCIPCons.size());
+	if (NumberRows < InEquation->Index) {
+		FErrorFile() << "Constraint index is beyond the end of the constraints currently loaded into the solver." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	vector<SCIP_VAR*> vars(InEquation->Variables.size()+1);
+	vector<SCIP_Real> coefs(InEquation->Variables.size()+1);
+	for (int i=0; i < int(InEquation->Variables.size()); i++) {
+		if (InEquation->Variables[i]->Index >= int(Problem->SCIPVars.size())) {
+			FErrorFile() << "Constraint variable index out of the range of variable indecies currently loaded into the solver." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
-		
-		SCIP_VAR** vars = new SCIP_VAR*[InEquation->Variables.size()];
-		SCIP_Real* coefs = new SCIP_Real[InEquation->Variables.size()];
-		for (int i=0; i < int(InEquation->Variables.size()); i++) {
-			if (InEquation->Variables[i]->Index >= int(SCIPVars.size())) {
-				delete [] vars;
-				delete [] coefs;
-				FErrorFile() << "Constraint variable index out of the range of variable indecies currently loaded into the solver." << endl;
-				FlushErrorFile();
-				return FAIL;
-			}
-			coefs[i] = InEquation->Coefficient[i];
-			vars[i] = SCIPVars[InEquation->Variables[i]->Index];
-		}
-		
-		SCIP_CONS* NewConstraint;
-		SCIP_CALL( SCIPcreateConsLinear(scippointer, &NewConstraint, itoa(InEquation->Index), int(InEquation->Variables.size()), vars, coefs, lhs, rhs,TRUE, TRUE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE, FALSE, FALSE));
-		SCIP_CALL( SCIPaddCons(scippointer, NewConstraint) );
-		SCIPCons.push_back(NewConstraint);
-		
-		delete [] vars;
-		delete [] coefs;
+		coefs[i] = InEquation->Coefficient[i];
+		vars[i] = Problem->SCIPVars[InEquation->Variables[i]->Index];
+	}
+
+	//An existing constraint is replaced in place, so coefficients, sense and right hand side can all change
+	if (NumberRows > InEquation->Index) {
+		SCIP_CONS* OldConstraint = Problem->SCIPCons[InEquation->Index];
+		if (SCIPCallFailed(SCIPdelCons(Problem->scippointer, OldConstraint),"delete constraint")) {
+			return FAIL;
+		}
+		if (SCIPCallFailed(SCIPreleaseCons(Problem->scippointer, &OldConstraint),"release constraint")) {
+			return FAIL;
+		}
+		Problem->SCIPCons[InEquation->Index] = NULL;
+	}
+
+	SCIP_CONS* NewConstraint = NULL;
+	if (SCIPCreateConstraint(Problem,InEquation,InEquation->Index,int(InEquation->Variables.size()),&(vars[0]),&(coefs[0]),&NewConstraint) != SUCCESS) {
+		return FAIL;
+	}
+	if (NumberRows > InEquation->Index) {
+		Problem->SCIPCons[InEquation->Index] = NewConstraint;
 	} else {
-		//TODO
+		Problem->SCIPCons.push_back(NewConstraint);
 	}
 
 	return SUCCESS;
-}
\ No newline at end of file
+}
+
+//SCIP does not expose a simplex basis through its problem interface, so warm starts are left to SCIP itself
+int SCIPSaveBasis(SolverContext*, SolverBasis*) {
+	return FAIL;
+}
+
+int SCIPLoadBasis(SolverContext*, SolverBasis*) {
+	return FAIL;
+}
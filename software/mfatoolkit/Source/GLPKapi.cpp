@@ -24,41 +24,40 @@ extern "C" {
 #include "glpk.h"
 }
 
-LPX* GLPKModel;
-
 int InitializeGLPKVariables() {
-	GLPKModel = NULL;
 	return SUCCESS;
 }
 
-int GLPKInitialize() {
-	if (GLPKModel != NULL) {
-		if (GLPKClearSolver() == FAIL) {
+int GLPKInitialize(SolverContext* Context) {
+	if (Context->GLPKModel != NULL) {
+		if (GLPKClearSolver(Context) == FAIL) {
 			return FAIL;	
 		}
 	}
 
-	GLPKModel = lpx_create_prob();
+	LPX* GLPKModel = lpx_create_prob();
+	Context->GLPKModel = GLPKModel;
 	//lpx_set_int_parm(GLPKModel, LPX_K_BFTYPE,3);
 	lpx_set_class(GLPKModel, LPX_LP);
 	
 	return SUCCESS;
 }
 
-int GLPKCleanup() {
-	return GLPKClearSolver();
+int GLPKCleanup(SolverContext* Context) {
+	return GLPKClearSolver(Context);
 }
 
-int GLPKClearSolver() {
-	if (GLPKModel != NULL) {
-		lpx_delete_prob(GLPKModel);
-		GLPKModel = NULL;
+int GLPKClearSolver(SolverContext* Context) {
+	if (Context->GLPKModel != NULL) {
+		lpx_delete_prob((LPX*)Context->GLPKModel);
+		Context->GLPKModel = NULL;
 	}
 
 	return SUCCESS;
 }
 
-int GLPKPrintFromSolver() {
+int GLPKPrintFromSolver(SolverContext* Context) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
 	if (GLPKModel == NULL) {
 		FErrorFile() << "Cannot print problem because problem does not exist." << endl;
 		FlushErrorFile();
@@ -77,10 +76,16 @@ int GLPKPrintFromSolver() {
 	return SUCCESS;
 }
 
-OptSolutionData* GLPKRunSolver(int ProbType) {
+OptSolutionData* GLPKRunSolver(SolverContext* Context, int ProbType) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
 	OptSolutionData* NewSolution = NULL;
 
 	int NumVariables = lpx_get_num_cols(GLPKModel);
+	Context->Stats.NumColumns = NumVariables;
+	Context->Stats.NumRows = lpx_get_num_rows(GLPKModel);
+	Context->Stats.NumNonzeros = lpx_get_num_nz(GLPKModel);
+	//The iteration count is kept across solves, so the work of this solve is the change in it
+	int StartIterations = lpx_get_int_parm(GLPKModel, LPX_K_ITCNT);
 
 	int Status = 0;
 	if (ProbType == MILP) {
@@ -91,6 +96,7 @@ OptSolutionData* GLPKRunSolver(int ProbType) {
 			return NULL;
 		}
 		Status = lpx_integer(GLPKModel);
+		Context->Stats.Iterations = lpx_get_int_parm(GLPKModel, LPX_K_ITCNT)-StartIterations;
 		if (Status != LPX_E_OK) {
 			FErrorFile() << "Failed to optimize problem." << endl;
 			FlushErrorFile();
@@ -121,10 +127,17 @@ OptSolutionData* GLPKRunSolver(int ProbType) {
 			NewSolution->SolutionData[i] = lpx_mip_col_val(GLPKModel, i+1);
 		}
 	} else if (ProbType == LP) {
-		//First we check the basis matrix to ensure it is not sigular
-		if (lpx_warm_up(GLPKModel) != LPX_E_OK) {
+		//The basis left by the previous solve is kept; only a missing or sigular basis is rebuilt
+		Context->Stats.WarmStart = (lpx_is_b_avail(GLPKModel) != 0);
+		if (!Context->Stats.WarmStart && lpx_warm_up(GLPKModel) != LPX_E_OK) {
 			lpx_adv_basis(GLPKModel);
 		}
+		//After bound changes alone the previous basis stays dual feasible, so dual simplex restarts from it
+		if (Context->BoundsChanged && !Context->ObjectiveChanged) {
+			lpx_set_int_parm(GLPKModel, LPX_K_DUAL, 1);
+		} else {
+			lpx_set_int_parm(GLPKModel, LPX_K_DUAL, 0);
+		}
 		Status = lpx_simplex(GLPKModel);
 		if (Status == LPX_E_FAULT) {
 			Status = lpx_warm_up(GLPKModel);
@@ -133,6 +146,7 @@ OptSolutionData* GLPKRunSolver(int ProbType) {
 				Status = lpx_simplex(GLPKModel);
 			}
 		}
+		Context->Stats.Iterations = lpx_get_int_parm(GLPKModel, LPX_K_ITCNT)-StartIterations;
 		if (Status != LPX_E_OK) {
 			FErrorFile() << "Failed to optimize problem." << endl;
 			FlushErrorFile();
@@ -177,7 +191,8 @@ OptSolutionData* GLPKRunSolver(int ProbType) {
 	return NewSolution;
 }
 
-int GLPKLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int GLPKLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
 	if (GLPKModel == NULL) {
 		FErrorFile() << "Could not add variable because GLPK object does not exist." << endl;
 		FlushErrorFile();
@@ -215,7 +230,92 @@ int GLPKLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool U
 	return SUCCESS;
 }
 
-int GLPKLoadObjective(LinEquation* InEquation, bool Max) {
+int GLPKLoadProblem(SolverContext* Context, SolverMatrix* InMatrix) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
+	if (GLPKModel == NULL) {
+		FErrorFile() << "Could not load problem because GLPK object does not exist." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	if (lpx_get_num_cols(GLPKModel) > 0 || lpx_get_num_rows(GLPKModel) > 0) {
+		FErrorFile() << "Could not load problem in bulk because the GLPK object is not empty." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+
+	int NumColumns = int(InMatrix->Variables.size());
+	int NumRows = int(InMatrix->Constraints.size());
+
+	//Columns are set up exactly as GLPKLoadVariables would for a new variable
+	if (NumColumns > 0) {
+		lpx_add_cols(GLPKModel, NumColumns);
+	}
+	for (int i=0; i < NumColumns; i++) {
+		MFAVariable* CurrentVariable = InMatrix->Variables[i];
+		lpx_set_col_name(GLPKModel,i+1,GetMFAVariableName(CurrentVariable).data());
+		double LowerBound = CurrentVariable->LowerBound;
+		double UpperBound = CurrentVariable->UpperBound;
+		if (InMatrix->UseTightBounds) {
+			LowerBound = CurrentVariable->Min;
+			UpperBound = CurrentVariable->Max;
+		}
+		if (LowerBound != UpperBound) {
+			lpx_set_col_bnds(GLPKModel, i+1, LPX_DB, CurrentVariable->LowerBound, CurrentVariable->UpperBound);
+		} else {
+			lpx_set_col_bnds(GLPKModel, i+1, LPX_FX, CurrentVariable->LowerBound, CurrentVariable->UpperBound);
+		}
+		if (CurrentVariable->Binary && !InMatrix->RelaxIntegerVariables) {
+			lpx_set_class(GLPKModel, LPX_MIP);
+			lpx_set_col_kind(GLPKModel, i+1,LPX_IV);
+		}
+	}
+
+	//Row bounds follow GLPKAddConstraint
+	if (NumRows > 0) {
+		lpx_add_rows(GLPKModel, NumRows);
+	}
+	for (int i=0; i < NumRows; i++) {
+		LinEquation* CurrentConstraint = InMatrix->Constraints[i];
+		if (CurrentConstraint->QuadCoeff.size() > 0) {
+			FErrorFile() << "GLPK solver cannot accept quadratic constraints." << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+		if (CurrentConstraint->EqualityType == EQUAL) {
+			lpx_set_row_bnds(GLPKModel, i+1, LPX_FX, CurrentConstraint->RightHandSide, CurrentConstraint->RightHandSide);
+		} else if (CurrentConstraint->EqualityType == GREATER) {
+			lpx_set_row_bnds(GLPKModel, i+1, LPX_LO, CurrentConstraint->RightHandSide, CurrentConstraint->RightHandSide);
+		} else if (CurrentConstraint->EqualityType == LESS) {
+			lpx_set_row_bnds(GLPKModel, i+1, LPX_UP, CurrentConstraint->RightHandSide, CurrentConstraint->RightHandSide);
+		} else {
+			FErrorFile() << "Could not add constraint because the constraint type was not recognized." << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+	}
+
+	//The whole matrix goes in with one call; GLPK wants one-based triplets with element zero unused
+	int NumNonzeros = int(InMatrix->Columns.size());
+	if (NumNonzeros > 0) {
+		vector<int> RowIndecies(NumNonzeros+1);
+		vector<int> ColumnIndecies(NumNonzeros+1);
+		vector<double> Coeff(NumNonzeros+1);
+		for (int i=0; i < NumRows; i++) {
+			for (int j=InMatrix->RowStart[i]; j < InMatrix->RowStart[i+1]; j++) {
+				RowIndecies[j+1] = i+1;
+				ColumnIndecies[j+1] = InMatrix->Columns[j]+1;
+				Coeff[j+1] = InMatrix->Coefficients[j];
+			}
+		}
+		lpx_load_matrix(GLPKModel, NumNonzeros, &(RowIndecies[0]), &(ColumnIndecies[0]), &(Coeff[0]));
+	}
+
+	return SUCCESS;
+}
+
+int GLPKLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
 	if (InEquation->QuadCoeff.size() > 0) {
 		FErrorFile() << "GLPK solver cannot accept quadratic objectives." << endl;
 		FlushErrorFile();
@@ -252,7 +352,8 @@ int GLPKLoadObjective(LinEquation* InEquation, bool Max) {
 	return SUCCESS;
 }
 
-int GLPKAddConstraint(LinEquation* InEquation) {
+int GLPKAddConstraint(SolverContext* Context, LinEquation* InEquation) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
 	if (InEquation->QuadCoeff.size() > 0) {
 		FErrorFile() << "GLPK solver cannot accept quadratic constraints." << endl;
 		FlushErrorFile();
@@ -304,4 +405,46 @@ int GLPKAddConstraint(LinEquation* InEquation) {
 	delete [] Coeff;
 
 	return SUCCESS;
-}
\ No newline at end of file
+}
+int GLPKSaveBasis(SolverContext* Context, SolverBasis* OutBasis) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
+	if (GLPKModel == NULL || !lpx_is_b_avail(GLPKModel)) {
+		return FAIL;
+	}
+
+	int NumColumns = lpx_get_num_cols(GLPKModel);
+	int NumRows = lpx_get_num_rows(GLPKModel);
+	OutBasis->ColumnStatus.resize(NumColumns);
+	OutBasis->RowStatus.resize(NumRows);
+	for (int i=0; i < NumColumns; i++) {
+		OutBasis->ColumnStatus[i] = lpx_get_col_stat(GLPKModel, i+1);
+	}
+	for (int i=0; i < NumRows; i++) {
+		OutBasis->RowStatus[i] = lpx_get_row_stat(GLPKModel, i+1);
+	}
+
+	return SUCCESS;
+}
+
+int GLPKLoadBasis(SolverContext* Context, SolverBasis* InBasis) {
+	LPX* GLPKModel = (LPX*)Context->GLPKModel;
+	if (GLPKModel == NULL) {
+		return FAIL;
+	}
+
+	//A basis saved before rows or columns were added no longer describes this problem
+	int NumColumns = lpx_get_num_cols(GLPKModel);
+	int NumRows = lpx_get_num_rows(GLPKModel);
+	if (int(InBasis->ColumnStatus.size()) != NumColumns || int(InBasis->RowStatus.size()) != NumRows) {
+		return FAIL;
+	}
+
+	for (int i=0; i < NumColumns; i++) {
+		lpx_set_col_stat(GLPKModel, i+1, InBasis->ColumnStatus[i]);
+	}
+	for (int i=0; i < NumRows; i++) {
+		lpx_set_row_stat(GLPKModel, i+1, InBasis->RowStatus[i]);
+	}
+
+	return SUCCESS;
+}
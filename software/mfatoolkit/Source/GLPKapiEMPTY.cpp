@@ -4,34 +4,46 @@ int InitializeGLPKVariables() {
 	return FAIL;
 }
 
-int GLPKInitialize() {
+int GLPKInitialize(SolverContext*) {
 	return FAIL;
 }
 
-int GLPKCleanup() {
+int GLPKCleanup(SolverContext*) {
 	return FAIL;
 }
 
-int GLPKClearSolver() {
+int GLPKClearSolver(SolverContext*) {
 	return FAIL;
 }
 
-int GLPKPrintFromSolver() {
+int GLPKPrintFromSolver(SolverContext*) {
 	return FAIL;
 }
 
-OptSolutionData* GLPKRunSolver(int ProbType) {
+OptSolutionData* GLPKRunSolver(SolverContext*, int ProbType) {
 	return NULL;
 }
 
-int GLPKLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int GLPKLoadVariables(SolverContext*, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
 	return FAIL;
 }
 
-int GLPKLoadObjective(LinEquation* InEquation, bool Max) {
+int GLPKLoadProblem(SolverContext*, SolverMatrix*) {
 	return FAIL;
 }
 
-int GLPKAddConstraint(LinEquation* InEquation) {
+int GLPKLoadObjective(SolverContext*, LinEquation* InEquation, bool Max) {
+	return FAIL;
+}
+
+int GLPKAddConstraint(SolverContext*, LinEquation* InEquation) {
+	return FAIL;
+}
+
+int GLPKSaveBasis(SolverContext*, SolverBasis*) {
+	return FAIL;
+}
+
+int GLPKLoadBasis(SolverContext*, SolverBasis*) {
 	return FAIL;
 }
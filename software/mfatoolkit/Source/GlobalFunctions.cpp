@@ -19,6 +19,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MFAToolkit.h"
+#include <pthread.h>
 
 ofstream OuputLog;
 
@@ -26,6 +27,8 @@ StringDB* stringDatabase;
 
 //These are all of the global data that is available throughout the program through the access functions listed here
 map<string , string , std::less<string> > Parameters;
+//Handles are stored by value so their addresses stay valid as more are added
+map<string , ParameterHandle , std::less<string> > ParameterHandles;
 
 vector<FileReferenceData*> FileReferences;
 
@@ -60,7 +63,6 @@ vector<int> PrimeNumbers;
 
 string ProgramPath;
 string InputParameters;
-string CompleteErrors;
 
 ostringstream ErrorFile;
 
@@ -163,7 +165,7 @@ int LoadStringDB() {
 	if (verbose()) {
 		cout<< "Loading Database Table "<< filename <<endl;
 	}
-	stringDatabase = new StringDB(filename,FProgramPath());
+	stringDatabase = new StringDB(filename,FProgramPath(),GetParameter("Use StringDB snapshots").compare("0") != 0);
 	return SUCCESS;
 }
 
@@ -171,9 +173,8 @@ StringDB* GetStringDB() {
 	return stringDatabase;
 }
 
-//This function is reponsible for reading in all of the global data
-int Initialize() {
-	LoadStringDB();
+//Creates the error log and output log in the current output folder; server jobs call this again after changing the output folder
+int InitializeOutputFiles() {
 	string OutputIndex = GetParameter("output index");
 	string Filename(FOutputFilepath());
 	Filename.append("ErrorLog");
@@ -188,11 +189,22 @@ int Initialize() {
 	Filename.append("Output");
 	Filename.append(OutputIndex);
 	Filename.append(".txt");
+	if (OuputLog.is_open()) {
+		OuputLog.close();
+	}
 	if (!OpenOutput(OuputLog,Filename)) {
 		return FAIL;	
 	}
+	return SUCCESS;
+}
+
+//This function is reponsible for reading in all of the global data
+int Initialize() {
+	LoadStringDB();
+	if (InitializeOutputFiles() == FAIL) {
+		return FAIL;
+	}
 
-	ClearSolverVariables();
 	InitializeInternalReferences();
 	InitializeGLPKVariables();
 	InitializeCPLEXVariables();
@@ -372,7 +384,10 @@ int LoadFileReferences() {
 }
 
 void Cleanup() {
+	WriteProfile();
+	WriteSolveStatistics();
 	FlushErrorFile();
+	StopErrorLog();
 	OuputLog.close();
 	
 	for (int i=0; i < int(FileReferences.size()); i++) {
@@ -394,8 +409,8 @@ void Cleanup() {
 }
 
 int LoadParameterFile(string Filename) {
-	ifstream Input;
-	if (!OpenInput(Input, Filename)) {
+	FileLineReader Input;
+	if (!OpenLineReader(Input, Filename)) {
 		return FAIL;
 	}
 
@@ -404,31 +419,38 @@ int LoadParameterFile(string Filename) {
 	}
 
 	//Read in the parameters and store them
-	do {
-		vector<string>* Strings = GetStringsFileline(Input, "|",false);
-		if (Strings->size() >= 2) {
-			if(Parameters[ (*Strings)[0] ].length()==0){
+	StringField Line;
+	vector<StringField> Fields;
+	while (ReadLine(Input,Line)) {
+		if (SplitFields(Line.Data,Line.Length,"|",Fields,false) >= 2) {
+			string Name = FieldToString(Fields[0]);
+			string Value = FieldToString(Fields[1]);
+			if(Parameters[Name].length()==0){
 			  if (verbose()) {
-				  cout << "Reading parameter: "<<(*Strings)[0]<<" with value: "<<(*Strings)[1]<<" from file: "<<Filename<<endl;
+				  cout << "Reading parameter: "<<Name<<" with value: "<<Value<<" from file: "<<Filename<<endl;
 			  }
 			}else{
 			  if (verbose()) {
-				  cout << "Overwriting parameter: "<<(*Strings)[0]<<" with value: "<<(*Strings)[1]<<" from file: "<<Filename<<endl;
+				  cout << "Overwriting parameter: "<<Name<<" with value: "<<Value<<" from file: "<<Filename<<endl;
 			  }
 			}
-			Parameters[ (*Strings)[0] ] = (*Strings)[1];
+			SetParameter(Name.data(),Value.data());
 		}
-		delete Strings;
-	} while(!Input.eof());
+	}
 
 	//Close the input parameters file
-	Input.close();
+	CloseLineReader(Input);
 	return SUCCESS;
 }
 
 string GetParameter(const char* ParameterLabel) {
 	string Label(ParameterLabel);
-	string Result = Parameters[Label];
+	//Lookups never insert, so worker threads can read parameters while nothing sets them
+	string Result;
+	map<string , string , std::less<string> >::iterator MapIT = Parameters.find(Label);
+	if (MapIT != Parameters.end()) {
+		Result = MapIT->second;
+	}
 	if (Result.length() == 0) {
 		FErrorFile() << "Could not find parameter: " << Label << endl;
 		FlushErrorFile();
@@ -440,6 +462,31 @@ void SetParameter(const char* ParameterLabel,const char* NewValue) {
 	string NewValueString(NewValue);
 	string Label(ParameterLabel);
 	Parameters[Label] = NewValueString;
+	map<string , ParameterHandle , std::less<string> >::iterator MapIT = ParameterHandles.find(Label);
+	if (MapIT != ParameterHandles.end()) {
+		MapIT->second.Value = NewValueString;
+		MapIT->second.Bool = (NewValueString.compare("1") == 0);
+		MapIT->second.Int = atoi(NewValueString.data());
+		MapIT->second.Double = atof(NewValueString.data());
+	}
+}
+
+ParameterHandle* GetParameterHandle(const char* ParameterLabel) {
+	string Label(ParameterLabel);
+	map<string , ParameterHandle , std::less<string> >::iterator MapIT = ParameterHandles.find(Label);
+	if (MapIT != ParameterHandles.end()) {
+		return &(MapIT->second);
+	}
+	ParameterHandle& NewHandle = ParameterHandles[Label];
+	//Fields are cleared first because a missing parameter is reported through the error log, which reads its own handles
+	NewHandle.Bool = false;
+	NewHandle.Int = 0;
+	NewHandle.Double = 0;
+	NewHandle.Value = GetParameter(ParameterLabel);
+	NewHandle.Bool = (NewHandle.Value.compare("1") == 0);
+	NewHandle.Int = atoi(NewHandle.Value.data());
+	NewHandle.Double = atof(NewHandle.Value.data());
+	return &NewHandle;
 }
 
 string FOutputFilepath() {
@@ -483,16 +530,209 @@ ofstream& FLogFile() {
 	return OuputLog;
 }
 
+//Set only on worker threads; the main thread always has no deferred output
+__thread DeferredOutput* ThreadOutput = NULL;
+
 ostringstream& FErrorFile() {
+	if (ThreadOutput != NULL) {
+		return ThreadOutput->ErrorFile;
+	}
 	return ErrorFile;
 }
 
-void FlushErrorFile() {
-	CompleteErrors.append(ErrorFile.str());
-	ofstream Output(GetParameter("Error filename").data(),ios::app);
-	Output << ErrorFile.str();
-	Output.close();
+void SetThreadOutput(DeferredOutput* Output) {
+	ThreadOutput = Output;
+}
+
+DeferredOutput* FThreadOutput() {
+	return ThreadOutput;
+}
+
+void ReplayDeferredOutput(DeferredOutput* Output) {
+	for (int i=0; i < int(Output->ErrorMessages.size()); i++) {
+		LogMessage(Output->ErrorMessages[i].first,Output->ErrorMessages[i].second);
+	}
+	for (int i=0; i < int(Output->FileLines.size()); i++) {
+		AddLineToFile(Output->FileLines[i].first.data(),Output->FileLines[i].second);
+	}
+}
+
+//The error log is written by a background flusher thread through one persistent file handle. Messages are queued in a bounded buffer; once the buffer is full the caller writes it out itself
+pthread_mutex_t ErrorLogMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t ErrorLogSignal = PTHREAD_COND_INITIALIZER;
+pthread_cond_t ErrorLogIdle = PTHREAD_COND_INITIALIZER;
+pthread_t ErrorLogThread;
+bool ErrorLogThreadRunning = false;
+bool ErrorLogWriting = false;
+bool ErrorLogStopping = false;
+bool ErrorLogForkHandlersSet = false;
+FILE* ErrorLogHandle = NULL;
+string ErrorLogFilename;
+string ErrorLogPending;
+map<string, int, std::less<string> > ErrorLogRepeats;
+
+//Writes the queued messages to the open error file once the flusher has finished its current batch. The caller must hold ErrorLogMutex
+void WriteErrorLogPending(bool Flush = false) {
+	while (ErrorLogWriting) {
+		pthread_cond_wait(&ErrorLogIdle,&ErrorLogMutex);
+	}
+	if (ErrorLogPending.length() > 0 && ErrorLogHandle != NULL) {
+		fwrite(ErrorLogPending.data(),1,ErrorLogPending.length(),ErrorLogHandle);
+	}
+	ErrorLogPending.clear();
+	if (Flush && ErrorLogHandle != NULL) {
+		fflush(ErrorLogHandle);
+	}
+}
+
+//The flusher takes the whole queue and writes it without the lock, so threads logging meanwhile only append to a fresh queue
+void* ErrorLogFlusher(void*) {
+	string Batch;
+	pthread_mutex_lock(&ErrorLogMutex);
+	while (!ErrorLogStopping) {
+		if (ErrorLogPending.length() == 0) {
+			timespec Deadline;
+			clock_gettime(CLOCK_REALTIME,&Deadline);
+			Deadline.tv_sec += 1;
+			pthread_cond_timedwait(&ErrorLogSignal,&ErrorLogMutex,&Deadline);
+		}
+		if (ErrorLogPending.length() == 0 || ErrorLogHandle == NULL) {
+			continue;
+		}
+		Batch.swap(ErrorLogPending);
+		FILE* Handle = ErrorLogHandle;
+		ErrorLogWriting = true;
+		pthread_mutex_unlock(&ErrorLogMutex);
+		fwrite(Batch.data(),1,Batch.length(),Handle);
+		Batch.clear();
+		pthread_mutex_lock(&ErrorLogMutex);
+		ErrorLogWriting = false;
+		pthread_cond_broadcast(&ErrorLogIdle);
+	}
+	pthread_mutex_unlock(&ErrorLogMutex);
+	return NULL;
+}
+
+//Fork handlers keep the mutex consistent across fork; the child has no flusher thread and writes its messages synchronously
+void ErrorLogPrepareFork() {
+	pthread_mutex_lock(&ErrorLogMutex);
+	WriteErrorLogPending(true);
+}
+
+void ErrorLogParentFork() {
+	pthread_mutex_unlock(&ErrorLogMutex);
+}
+
+void ErrorLogChildFork() {
+	pthread_mutex_init(&ErrorLogMutex,NULL);
+	pthread_cond_init(&ErrorLogSignal,NULL);
+	pthread_cond_init(&ErrorLogIdle,NULL);
+	ErrorLogThreadRunning = false;
+	ErrorLogStopping = true;
+}
+
+void LogMessage(int Level, const string& Message) {
+	if (Message.length() == 0) {
+		return;
+	}
+	static ParameterHandle* MinimumLevel = NULL;
+	static ParameterHandle* RepeatLimit = NULL;
+	static ParameterHandle* BufferSize = NULL;
+	static ParameterHandle* Filename = NULL;
+	static bool Resolving = false;
+	if (Filename == NULL) {
+		//A missing log parameter is itself reported through this function, so that report goes straight to stderr
+		if (Resolving) {
+			cerr << Message;
+			return;
+		}
+		Resolving = true;
+		MinimumLevel = GetParameterHandle("Minimum error log level");
+		RepeatLimit = GetParameterHandle("Error log repeat limit");
+		BufferSize = GetParameterHandle("Error log buffer size");
+		Filename = GetParameterHandle("Error filename");
+		Resolving = false;
+	}
+	if (Level < MinimumLevel->Int) {
+		return;
+	}
+
+	pthread_mutex_lock(&ErrorLogMutex);
+	//Rate limiting identical messages, which usually come from one failure repeated inside a loop
+	if (RepeatLimit->Int > 0) {
+		if (ErrorLogRepeats.size() > 10000) {
+			ErrorLogRepeats.clear();
+		}
+		int& Count = ErrorLogRepeats[Message];
+		Count++;
+		if (Count > RepeatLimit->Int) {
+			pthread_mutex_unlock(&ErrorLogMutex);
+			return;
+		}
+	}
+	//Switching files when the error filename parameter changes
+	if (ErrorLogHandle == NULL || ErrorLogFilename.compare(Filename->Value) != 0) {
+		WriteErrorLogPending();
+		if (ErrorLogHandle != NULL) {
+			fclose(ErrorLogHandle);
+		}
+		ErrorLogFilename = Filename->Value;
+		ErrorLogHandle = fopen(ErrorLogFilename.data(),"a");
+	}
+	ErrorLogPending.append(Message);
+	if (RepeatLimit->Int > 0 && ErrorLogRepeats[Message] == RepeatLimit->Int) {
+		ErrorLogPending.append("Further repeats of the message above are suppressed.\n");
+	}
+	if (!ErrorLogForkHandlersSet) {
+		pthread_atfork(ErrorLogPrepareFork,ErrorLogParentFork,ErrorLogChildFork);
+		ErrorLogForkHandlersSet = true;
+		atexit(StopErrorLog);
+	}
+	if (!ErrorLogThreadRunning && !ErrorLogStopping) {
+		ErrorLogThreadRunning = (pthread_create(&ErrorLogThread,NULL,ErrorLogFlusher,NULL) == 0);
+	}
+	if (!ErrorLogThreadRunning || int(ErrorLogPending.length()) >= BufferSize->Int) {
+		WriteErrorLogPending();
+	} else {
+		pthread_cond_signal(&ErrorLogSignal);
+	}
+	pthread_mutex_unlock(&ErrorLogMutex);
+}
+
+void FlushErrorFile(int Level) {
+	if (ThreadOutput != NULL) {
+		ThreadOutput->ErrorMessages.push_back(pair<int, string>(Level,ThreadOutput->ErrorFile.str()));
+		ThreadOutput->ErrorFile.str("");
+		return;
+	}
+	string Message = ErrorFile.str();
 	ErrorFile.str("");
+	LogMessage(Level,Message);
+}
+
+void SyncErrorLog() {
+	pthread_mutex_lock(&ErrorLogMutex);
+	WriteErrorLogPending(true);
+	pthread_mutex_unlock(&ErrorLogMutex);
+}
+
+void StopErrorLog() {
+	pthread_mutex_lock(&ErrorLogMutex);
+	bool Running = ErrorLogThreadRunning;
+	ErrorLogStopping = true;
+	pthread_cond_signal(&ErrorLogSignal);
+	pthread_mutex_unlock(&ErrorLogMutex);
+	if (Running) {
+		pthread_join(ErrorLogThread,NULL);
+	}
+	pthread_mutex_lock(&ErrorLogMutex);
+	ErrorLogThreadRunning = false;
+	WriteErrorLogPending(true);
+	if (ErrorLogHandle != NULL) {
+		fclose(ErrorLogHandle);
+		ErrorLogHandle = NULL;
+	}
+	pthread_mutex_unlock(&ErrorLogMutex);
 }
 
 void ProduceChargedMolfiles(string MolfileDirectory) {
@@ -789,7 +1029,11 @@ int FNumAtomTypes() {
 
 CellCompartment* GetCompartment(const char* Abbrev) {
 	string Temp(Abbrev);
-	return CompartmentsByAbbrev[Temp];
+	map<string , CellCompartment* , std::less<string> >::iterator MapIT = CompartmentsByAbbrev.find(Temp);
+	if (MapIT == CompartmentsByAbbrev.end()) {
+		return NULL;
+	}
+	return MapIT->second;
 }
 
 CellCompartment* GetCompartment(int InIndex) {
@@ -913,93 +1157,75 @@ int ReadConstraints(const char* ConstraintFilename, struct ConstraintsToAdd* Add
 		ConstraintsFilename = GetDatabaseDirectory(true)+GetParameter("user constraints filename");
 	}
 
-	ifstream Input;
-	if (!OpenInput(Input,ConstraintsFilename)) {
+	FileLineReader Input;
+	if (!OpenLineReader(Input,ConstraintsFilename)) {
 		delete AddConstraints;
 		delete ModConstraints;
 		return FAIL;
 	}
 		
 	//Reading in file header
-	string Temp = GetFileLine(Input);
+	StringField Line;
+	ReadLine(Input,Line);
 	//Reading each constraint
-	int Count = 0;
-	do {
-		vector<string>* Strings = GetStringsFileline(Input,";");
-		if (Strings->size() > 0) {
-			string action = (*Strings)[0].data();
-
-			if (action.compare("Add") == 0) {
-				if (Strings->size() > 2) {
-					AddConstraints->RHS.push_back(atof((*Strings)[2].data()));
-					if ((*Strings)[3].compare("<") == 0) {
+	vector<StringField> Fields;
+	vector<StringField> Terms;
+	while (ReadLine(Input,Line)) {
+		if (SplitFields(Line.Data,Line.Length,";",Fields) > 0) {
+			if (FieldEquals(Fields[0],"Add")) {
+				if (Fields.size() > 2) {
+					AddConstraints->RHS.push_back(FieldToDouble(Fields[2]));
+					if (Fields.size() > 3 && FieldEquals(Fields[3],"<")) {
 						AddConstraints->EqualityType.push_back(GREATER);
-					} else if ((*Strings)[3].compare(">") == 0) {
+					} else if (Fields.size() > 3 && FieldEquals(Fields[3],">")) {
 						AddConstraints->EqualityType.push_back(LESS);
 					} else {
 						AddConstraints->EqualityType.push_back(EQUAL);
 					}
-					vector<double> NewVector;
-					AddConstraints->VarCoef.push_back(NewVector);
-					vector<string> NewVectorTwo;
-					AddConstraints->VarName.push_back(NewVectorTwo);
-					vector<string> NewVectorThree;
-					AddConstraints->VarCompartment.push_back(NewVectorThree);
-					vector<int> NewVectorFour;
-					AddConstraints->VarType.push_back(NewVectorFour);
-					for (int i=2; i < int(Strings->size()); i++) {
-						vector<string>* StringsTwo = StringToStrings((*Strings)[i],"|");
-						if (StringsTwo->size() >= 4) {
-							AddConstraints->VarName[Count].push_back((*StringsTwo)[0]);
-							AddConstraints->VarCoef[Count].push_back(atof((*StringsTwo)[1].data()));
-							AddConstraints->VarCompartment[Count].push_back((*StringsTwo)[2]);
-							AddConstraints->VarType[Count].push_back(ConvertVariableType((*StringsTwo)[3]));
+					AddConstraints->VarCoef.push_back(vector<double>());
+					AddConstraints->VarName.push_back(vector<string>());
+					AddConstraints->VarCompartment.push_back(vector<string>());
+					AddConstraints->VarType.push_back(vector<int>());
+					for (int i=2; i < int(Fields.size()); i++) {
+						if (SplitFields(Fields[i].Data,Fields[i].Length,"|",Terms) >= 4) {
+							AddConstraints->VarName.back().push_back(FieldToString(Terms[0]));
+							AddConstraints->VarCoef.back().push_back(FieldToDouble(Terms[1]));
+							AddConstraints->VarCompartment.back().push_back(FieldToString(Terms[2]));
+							AddConstraints->VarType.back().push_back(ConvertVariableType(FieldToString(Terms[3])));
 						}
-						delete StringsTwo;
 					}
-					
-					Count++;
 				}
-				delete Strings;
-			} else if (action.compare("Modify") == 0) {
-				if (Strings->size() > 2) {
-					ModConstraints->ConstraintName.push_back((*Strings)[1].data());
-					ModConstraints->RHS.push_back(atof((*Strings)[2].data()));
-					if ((*Strings)[3].compare("<") == 0) {
+			} else if (FieldEquals(Fields[0],"Modify")) {
+				if (Fields.size() > 2) {
+					ModConstraints->ConstraintName.push_back(FieldToString(Fields[1]));
+					ModConstraints->RHS.push_back(FieldToDouble(Fields[2]));
+					if (Fields.size() > 3 && FieldEquals(Fields[3],"<")) {
 						ModConstraints->EqualityType.push_back(GREATER);
-					} else if ((*Strings)[3].compare(">") == 0) {
+					} else if (Fields.size() > 3 && FieldEquals(Fields[3],">")) {
 						ModConstraints->EqualityType.push_back(LESS);
 					} else {
 						ModConstraints->EqualityType.push_back(EQUAL);
 					}
-					vector<double> NewVector;
-					ModConstraints->VarCoef.push_back(NewVector);
-					vector<string> NewVectorTwo;
-					ModConstraints->VarName.push_back(NewVectorTwo);
-					vector<string> NewVectorThree;
-					ModConstraints->VarCompartment.push_back(NewVectorThree);
-					vector<int> NewVectorFour;
-					ModConstraints->VarType.push_back(NewVectorFour);
-					for (int i=2; i < int(Strings->size()); i++) {
-						vector<string>* StringsTwo = StringToStrings((*Strings)[i],"|");
-						if (StringsTwo->size() >= 4) {
-							ModConstraints->VarName[Count].push_back((*StringsTwo)[0]);
-							ModConstraints->VarCoef[Count].push_back(atof((*StringsTwo)[1].data()));
-							ModConstraints->VarCompartment[Count].push_back((*StringsTwo)[2]);
-							ModConstraints->VarType[Count].push_back(ConvertVariableType((*StringsTwo)[3]));
+					ModConstraints->VarCoef.push_back(vector<double>());
+					ModConstraints->VarName.push_back(vector<string>());
+					ModConstraints->VarCompartment.push_back(vector<string>());
+					ModConstraints->VarType.push_back(vector<int>());
+					for (int i=2; i < int(Fields.size()); i++) {
+						if (SplitFields(Fields[i].Data,Fields[i].Length,"|",Terms) >= 4) {
+							ModConstraints->VarName.back().push_back(FieldToString(Terms[0]));
+							ModConstraints->VarCoef.back().push_back(FieldToDouble(Terms[1]));
+							ModConstraints->VarCompartment.back().push_back(FieldToString(Terms[2]));
+							ModConstraints->VarType.back().push_back(ConvertVariableType(FieldToString(Terms[3])));
 						}
-						delete StringsTwo;
-					}		
-					Count++;
+					}
 				}
 			} else {
-				FErrorFile() << action << " not recognized." << endl;
+				FErrorFile() << FieldToString(Fields[0]) << " not recognized." << endl;
 			}
 		}
-		delete Strings;
-	} while (!Input.eof());
+	}
 
-	Input.close();
+	CloseLineReader(Input);
 
 	return SUCCESS;
 }
@@ -2334,8 +2560,8 @@ string GetConstraintName(LinEquation* InEquation) {
 
 OptSolutionData* ParseSCIPSolution(string Filename,vector<MFAVariable*> Variables) {
 	//Parsing the output file generated by SCIP
-	ifstream Input;
-	if (!OpenInput(Input,(FOutputFilepath()+Filename).data())) {
+	FileLineReader Input;
+	if (!OpenLineReader(Input,FOutputFilepath()+Filename)) {
 		cout << "Could not open scip output file!" << endl;
 		return NULL;
 	}
@@ -2349,29 +2575,35 @@ OptSolutionData* ParseSCIPSolution(string Filename,vector<MFAVariable*> Variable
 	}
 	
 	NewSolution->Status = FAIL;
-	while(!Input.eof()) {
-		vector<string>* Strings = GetStringsFileline(Input," ",true);
+	StringField Line;
+	vector<StringField> Fields;
+	while (ReadLine(Input,Line)) {
+		SplitFields(Line.Data,Line.Length," ",Fields,true);
 		if (!ReadingSolution) {
-			if (Strings->size() >= 9 && (*Strings)[0].compare("SCIP") == 0 && (*Strings)[1].compare("Status") == 0) {
-				if (((*Strings)[2]+(*Strings)[3]+(*Strings)[4]+(*Strings)[5]+(*Strings)[6]+(*Strings)[7]+(*Strings)[8]).compare(":problemissolved[optimalsolutionfound]") == 0) {
+			if (Fields.size() >= 9 && FieldEquals(Fields[0],"SCIP") && FieldEquals(Fields[1],"Status")) {
+				string Status;
+				for (int i=2; i < 9; i++) {
+					Status.append(Fields[i].Data,Fields[i].Length);
+				}
+				if (Status.compare(":problemissolved[optimalsolutionfound]") == 0) {
 					NewSolution->Status = SUCCESS;
 				}
-			} else if (Strings->size() >= 3 && (*Strings)[0].compare("objective") == 0 && (*Strings)[1].compare("value:") == 0) {
-				NewSolution->Objective = atof((*Strings)[2].data());
+			} else if (Fields.size() >= 3 && FieldEquals(Fields[0],"objective") && FieldEquals(Fields[1],"value:")) {
+				NewSolution->Objective = FieldToDouble(Fields[2]);
 				ReadingSolution = true;
 			}
 		} else {
-			if (Strings->size() == 0 || (*Strings)[0].length() == 0) {
+			if (Fields.size() == 0 || Fields[0].Length == 0) {
 				break;
-			} else if (Strings->size() >= 2 && (*Strings)[0].substr(0,1).compare("x") == 0) {
-				int VarIndex = atoi((*Strings)[0].substr(1).data());
+			} else if (Fields.size() >= 2 && Fields[0].Data[0] == 'x') {
+				int VarIndex = atoi(FieldToString(Fields[0]).substr(1).data());
 				if (VarIndex <= int(NewSolution->SolutionData.size())) {
-					NewSolution->SolutionData[VarIndex-1] = atof((*Strings)[1].data());
+					NewSolution->SolutionData[VarIndex-1] = FieldToDouble(Fields[1]);
 				}
 			}
 		}
-		delete Strings;
 	}
+	CloseLineReader(Input);
 	return NewSolution;
 }
 
@@ -20,6 +20,27 @@
 
 #include "MFAToolkit.h"
 
+struct DataKeyLess {
+	bool operator()(const char* One, const char* Two) const {
+		return strcmp(One,Two) < 0;
+	}
+};
+
+//Interned attribute names: the map keys point into the heap allocated names, which are never freed or modified
+static map<const char*, int, DataKeyLess>& DataKeyMap() {
+	static map<const char*, int, DataKeyLess> Keys;
+	return Keys;
+}
+
+static vector<string*>& DataKeyNames() {
+	static vector<string*> Names;
+	return Names;
+}
+
+static const string EmptyString;
+static const vector<string> EmptyStrings;
+static const vector<double> EmptyDoubles;
+
 Identity::Identity() {
 	Kill = false;
 	Mark = false;
@@ -98,6 +119,71 @@ void Identity::InitializeEntryIndexDatabase(int InEntry,int InIndex,string InDat
 	AddData("DATABASE",InDatabase.data(),STRING);
 }
 
+int Identity::DataKey(const char* DataName) {
+	map<const char*, int, DataKeyLess>& Keys = DataKeyMap();
+	map<const char*, int, DataKeyLess>::iterator KeyIT = Keys.find(DataName);
+	if (KeyIT != Keys.end()) {
+		return KeyIT->second;
+	}
+	vector<string*>& Names = DataKeyNames();
+	string* NewName = new string(DataName);
+	int NewKey = int(Names.size());
+	Names.push_back(NewName);
+	Keys[NewName->c_str()] = NewKey;
+	return NewKey;
+}
+
+int Identity::FindDataKey(const char* DataName) {
+	map<const char*, int, DataKeyLess>& Keys = DataKeyMap();
+	map<const char*, int, DataKeyLess>::iterator KeyIT = Keys.find(DataName);
+	if (KeyIT == Keys.end()) {
+		return -1;
+	}
+	return KeyIT->second;
+}
+
+const string& Identity::DataKeyName(int DataKey) {
+	vector<string*>& Names = DataKeyNames();
+	if (DataKey < 0 || DataKey >= int(Names.size())) {
+		return EmptyString;
+	}
+	return *Names[DataKey];
+}
+
+vector<string>* Identity::FindData(int DataKey, int Object, bool Create) {
+	vector<pair<int, vector<string> > >* Data = NULL;
+	if (Object == STRING) {
+		Data = &StringData;
+	} else if (Object == DATABASE_LINK) {
+		Data = &DatabaseLinks;
+	} else {
+		return NULL;
+	}
+	for (int i=0; i < int(Data->size()); i++) {
+		if ((*Data)[i].first == DataKey) {
+			return &((*Data)[i].second);
+		}
+	}
+	if (!Create) {
+		return NULL;
+	}
+	Data->push_back(pair<int, vector<string> >(DataKey,vector<string>()));
+	return &(Data->back().second);
+}
+
+vector<double>* Identity::FindDoubleData(int DataKey, bool Create) {
+	for (int i=0; i < int(DoubleData.size()); i++) {
+		if (DoubleData[i].first == DataKey) {
+			return &(DoubleData[i].second);
+		}
+	}
+	if (!Create) {
+		return NULL;
+	}
+	DoubleData.push_back(pair<int, vector<double> >(DataKey,vector<double>()));
+	return &(DoubleData.back().second);
+}
+
 void Identity::SetCode(string InCode) {
 	if (InCode.compare("Unknown") == 0 || InCode.compare("None") == 0) {
 		InCode.assign("");
@@ -106,13 +192,12 @@ void Identity::SetCode(string InCode) {
 };
 
 bool Identity::AddData(const char* DBName, const char* DBID, int Object, bool RemoveDuplicates) {
-	string StrDBName(DBName);
-	string StrDBID(DBID);
+	int Key = DataKey(DBName);
 	vector<string>* Strings = StringToStrings(DBID,"|\t");
 	bool OneAdded = false;
 
 	bool SecondDB = false;
-	if (StrDBName.compare("STRUCTURE_FILE") == 0) {
+	if (strcmp(DBName,"STRUCTURE_FILE") == 0) {
 		SecondDB = true;
 	}	
 
@@ -127,7 +212,7 @@ bool Identity::AddData(const char* DBName, const char* DBID, int Object, bool Re
 			if ((*Strings)[j].length() > 0 && (*Strings)[j].substr((*Strings)[j].length()-1,1).compare(" ") == 0) {
 				(*Strings)[j] = (*Strings)[j].substr(0,(*Strings)[j].length()-1);
 			}
-			vector<string>& CurrentData = StringData[StrDBName];
+			vector<string>& CurrentData = *FindData(Key,STRING,true);
 			if (RemoveDuplicates) {
 				for (int i=0; i < int(CurrentData.size()); i++) {
 					if (CurrentData[i].compare((*Strings)[j]) == 0) {
@@ -156,7 +241,7 @@ bool Identity::AddData(const char* DBName, const char* DBID, int Object, bool Re
 	} else if (Object == DATABASE_LINK) {
 		bool Add = true;
 		for (int j=0; j < int(Strings->size()); j++) {
-			vector<string>& CurrentData = DatabaseLinks[StrDBName];
+			vector<string>& CurrentData = *FindData(Key,DATABASE_LINK,true);
 			//I eliminate spaces that might be at the beginning or ending of a data item
 			if ((*Strings)[j].substr(0,1).compare(" ") == 0) {
 				(*Strings)[j] = (*Strings)[j].substr(1,(*Strings)[j].length()-1);
@@ -181,7 +266,7 @@ bool Identity::AddData(const char* DBName, const char* DBID, int Object, bool Re
 		bool Add = true;
 		for (int j=0; j < int(Strings->size()); j++) {
 			double CurrentDouble = atof((*Strings)[j].data());	
-			vector<double>& CurrentData = DoubleData[StrDBName];
+			vector<double>& CurrentData = *FindDoubleData(Key,true);
 			if (RemoveDuplicates) {
 				for (int i=0; i < int(CurrentData.size()); i++) {
 					if (CurrentData[i] == CurrentDouble) {
@@ -201,9 +286,7 @@ bool Identity::AddData(const char* DBName, const char* DBID, int Object, bool Re
 };
 
 void Identity::AddData(const char* DBName, double Data, bool RemoveDuplicates) {
-	string StrDataName(DBName);
-
-	vector<double>& CurrentData = DoubleData[StrDataName];
+	vector<double>& CurrentData = *FindDoubleData(DataKey(DBName),true);
 	if (RemoveDuplicates) {
 		for (int i=0; i < int(CurrentData.size()); i++) {
 			if (CurrentData[i] == Data) {
@@ -215,101 +298,86 @@ void Identity::AddData(const char* DBName, double Data, bool RemoveDuplicates) {
 };
 
 void Identity::SetData(const char* DBName, const char* Data, int Object, int InIndex) {
-	if (Object == STRING) {
-		vector<string>& CurrentData = StringData[DBName];
-		for (int i=int(CurrentData.size()); i < InIndex+1; i++) {
-			CurrentData.push_back("");
-		}
-		CurrentData[InIndex].assign(Data);
-	} else if (Object == DATABASE_LINK) {
-		vector<string>& CurrentData = DatabaseLinks[DBName];
-		for (int i=int(CurrentData.size()); i < InIndex+1; i++) {
-			CurrentData.push_back("");
-		}
-		CurrentData[InIndex].assign(Data);
-	} else {
+	if (Object != STRING && Object != DATABASE_LINK) {
 		return;
 	}
+	vector<string>& CurrentData = *FindData(DataKey(DBName),Object,true);
+	for (int i=int(CurrentData.size()); i < InIndex+1; i++) {
+		CurrentData.push_back("");
+	}
+	CurrentData[InIndex].assign(Data);
 }
 
 void Identity::SetData(const char* DBName, double Data, int InIndex) {
-	vector<double>& CurrentData = DoubleData[DBName];
+	vector<double>& CurrentData = *FindDoubleData(DataKey(DBName),true);
 	for (int i=int(CurrentData.size()); i < InIndex+1; i++) {
 		CurrentData.push_back(FLAG);
 	}
 	CurrentData[InIndex] = Data;
 }
 
-string Identity::GetGenericData(const char* DataName, int DataIndex) {
-	string Temp = GetData(DataName,STRING,DataIndex);
+const string& Identity::GetGenericData(const char* DataName, int DataIndex) {
+	int Key = FindDataKey(DataName);
+	const string& Temp = GetData(Key,STRING,DataIndex);
 	if (Temp.length() == 0) {
-		Temp = GetData(DataName,DATABASE_LINK,DataIndex);
+		return GetData(Key,DATABASE_LINK,DataIndex);
 	}
 
 	return Temp;
 }
 
-string Identity::GetData(const char* DataName, int Object, int DataIndex) {
-	string StrDataName(DataName);
-
-	vector<string> CurrentData;
-	if (Object == STRING) {
-		CurrentData = StringData[StrDataName];
-	} else if (Object == DATABASE_LINK) {
-		CurrentData = DatabaseLinks[StrDataName];
-	} 
+const string& Identity::GetData(const char* DataName, int Object, int DataIndex) {
+	return GetData(FindDataKey(DataName),Object,DataIndex);
+};
 
-	if (DataIndex >= int(CurrentData.size())) {
-		StrDataName.clear();
-		return StrDataName;
+const string& Identity::GetData(int DataKey, int Object, int DataIndex) {
+	vector<string>* CurrentData = FindData(DataKey,Object,false);
+	if (CurrentData == NULL || DataIndex >= int(CurrentData->size())) {
+		return EmptyString;
 	}
-	return CurrentData[DataIndex];
+	return (*CurrentData)[DataIndex];
 };
 
 double Identity::GetDoubleData(const char* DataName, int DataIndex) {
-	string StrDataName(DataName);
-
-	vector<double> CurrentData = DoubleData[StrDataName];
+	return GetDoubleData(FindDataKey(DataName),DataIndex);
+};
 
-	if (DataIndex >= int(CurrentData.size())) {
+double Identity::GetDoubleData(int DataKey, int DataIndex) {
+	vector<double>* CurrentData = FindDoubleData(DataKey,false);
+	if (CurrentData == NULL || DataIndex >= int(CurrentData->size())) {
 		return FLAG;
 	}
-	return CurrentData[DataIndex];
+	return (*CurrentData)[DataIndex];
 };
 
 int Identity::GetNumData(const char* DataName,int Object) {
-	if (Object == STRING) {
-		return int(StringData[DataName].size());
-	} else if (Object == DATABASE_LINK) {
-		return int(DatabaseLinks[DataName].size());
-	} else {
-		return int(DoubleData[DataName].size());
+	if (Object == DOUBLE) {
+		return int(GetAllData(DataName).size());
 	}
+	return int(GetAllData(DataName,Object).size());
 };
 
-vector<double> Identity::GetAllData(const char* DataName) {
-	string StrDataName(DataName);
-	return DoubleData[StrDataName];
+const vector<double>& Identity::GetAllData(const char* DataName) {
+	vector<double>* CurrentData = FindDoubleData(FindDataKey(DataName),false);
+	if (CurrentData == NULL) {
+		return EmptyDoubles;
+	}
+	return *CurrentData;
 };
 
-vector<string> Identity::GetAllData(const char* DataName, int Object) {
-	string StrDataName(DataName);
-	
-	if (Object == STRING) {
-		return StringData[StrDataName];
-	} else if (Object == DATABASE_LINK) {
-		return DatabaseLinks[StrDataName];
+const vector<string>& Identity::GetAllData(const char* DataName, int Object) {
+	vector<string>* CurrentData = FindData(FindDataKey(DataName),Object,false);
+	if (CurrentData == NULL) {
+		return EmptyStrings;
 	}
-
-	vector<string> Temp;
-	return Temp;
+	return *CurrentData;
 };
 
 string Identity::GetAllDataString(const char* DataName, int Object) {
 	string Combined;
 
 	if (Object == DOUBLE) {
-		vector<double> Data = GetAllData(DataName);
+		const vector<double>& Data = GetAllData(DataName);
 		for (int i=0; i < int(Data.size()); i++) {
 			Combined.append(dtoa(Data[i]));
 			if (i < int(Data.size()-1)) {
@@ -317,7 +385,7 @@ string Identity::GetAllDataString(const char* DataName, int Object) {
 			}
 		}
 	} else {
-		vector<string> Data = GetAllData(DataName, Object);
+		const vector<string>& Data = GetAllData(DataName, Object);
 		for (int i=0; i < int(Data.size()); i++) {
 			Combined.append(Data[i]);
 			if (i < int(Data.size()-1)) {
@@ -330,12 +398,8 @@ string Identity::GetAllDataString(const char* DataName, int Object) {
 };
 
 string Identity::GetCombinedData(int Object) {
-	map<string, vector<string> , std::less<string> >::iterator MapITLink = DatabaseLinks.begin();
-	map<string, vector<double> , std::less<string> >::iterator MapITDoub = DoubleData.begin();
-	map<string, vector<string> , std::less<string> >::iterator MapITString = StringData.begin();
-	
-	string Combined;
-	
+	//Attributes are written in alphabetical order of their names so the output does not depend on interning order
+	map<string, int, std::less<string> > Order;
 	int Mapsize = 0;
 	if (Object == STRING) {
 		Mapsize = int(StringData.size());
@@ -344,34 +408,38 @@ string Identity::GetCombinedData(int Object) {
 	} else if (Object == DOUBLE) {
 		Mapsize = int(DoubleData.size());
 	}
-
-	for(int i=0; i < Mapsize; i++) {
+	for (int i=0; i < Mapsize; i++) {
+		if (Object == STRING) {
+			Order[DataKeyName(StringData[i].first)] = i;
+		} else if (Object == DATABASE_LINK) {
+			Order[DataKeyName(DatabaseLinks[i].first)] = i;
+		} else if (Object == DOUBLE) {
+			Order[DataKeyName(DoubleData[i].first)] = i;
+		}
+	}
+	
+	string Combined;
+	for (map<string, int, std::less<string> >::iterator MapIT = Order.begin(); MapIT != Order.end(); MapIT++) {
+		int Position = MapIT->second;
 		int DataSize = 0;
 		if (Object == STRING) {
-			DataSize = int(MapITString->second.size());
+			DataSize = int(StringData[Position].second.size());
 		} else if (Object == DATABASE_LINK) {
-			DataSize = int(MapITLink->second.size());
+			DataSize = int(DatabaseLinks[Position].second.size());
 		} else if (Object == DOUBLE) {
-			DataSize = int(MapITDoub->second.size());
+			DataSize = int(DoubleData[Position].second.size());
 		}
 		
 		if (DataSize > 0) {
-			if (Object == STRING) {
-				Combined.append(MapITString->first);
-			} else if (Object == DATABASE_LINK) {
-				Combined.append(MapITLink->first);
-			} else if (Object == DOUBLE) {
-				Combined.append(MapITDoub->first);
-			}
-
+			Combined.append(MapIT->first);
 			Combined.append(":");
 			for (int j=0; j < DataSize; j++) {
 				if (Object == STRING) {
-					Combined.append(MapITString->second[j]);
+					Combined.append(StringData[Position].second[j]);
 				} else if (Object == DATABASE_LINK) {
-					Combined.append(MapITLink->second[j]);
+					Combined.append(DatabaseLinks[Position].second[j]);
 				} else if (Object == DOUBLE) {
-					Combined.append(dtoa(MapITDoub->second[j]));
+					Combined.append(dtoa(DoubleData[Position].second[j]));
 				}
 
 				if (j < DataSize-1) {
@@ -380,14 +448,6 @@ string Identity::GetCombinedData(int Object) {
 			}
 			Combined.append("\t");
 		}
-		
-		if (Object == STRING) {
-			MapITString++;
-		} else if (Object == DATABASE_LINK) {
-			MapITLink++;
-		} else if (Object == DOUBLE) {
-			MapITDoub++;
-		}
 	}
 
 	if (Combined.length() > 0 && Combined.substr(Combined.length()-1,1).compare("\t") == 0) {
@@ -417,13 +477,15 @@ void Identity::ParseCombinedData(string InData, int Object, bool Reverse) {
 }
 
 void Identity::ClearData(const char* DatabaseName, int Object) {
-	string StrDatabaseName(DatabaseName);
-
-	if (Object == STRING) {
-		StringData[StrDatabaseName].clear();
-	} else if (Object == DATABASE_LINK) {
-		DatabaseLinks[StrDatabaseName].clear();
-	} else if (Object == DOUBLE) {
-		DoubleData[StrDatabaseName].clear();
-	} 
+	if (Object == DOUBLE) {
+		vector<double>* CurrentData = FindDoubleData(FindDataKey(DatabaseName),false);
+		if (CurrentData != NULL) {
+			CurrentData->clear();
+		}
+		return;
+	}
+	vector<string>* CurrentData = FindData(FindDataKey(DatabaseName),Object,false);
+	if (CurrentData != NULL) {
+		CurrentData->clear();
+	}
 };
\ No newline at end of file
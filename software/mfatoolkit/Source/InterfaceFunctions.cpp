@@ -19,10 +19,40 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MFAToolkit.h"
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
 
 void CommandlineInterface(vector<string> Arguments) {
 	vector<string> ParameterFiles;
 	ParameterFiles.push_back("../etc/Defaults.txt");
+	LoadCommandlineParameters(Arguments,ParameterFiles);
+	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+	if (Initialize() != SUCCESS) {
+		return;
+	}
+	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+	for (int i=0; i < int(Arguments.size()); i++) {
+		if (Arguments[i].compare("server") == 0) {
+			if (int(Arguments.size()) < i+2) {
+				cout << "Insufficient arguments" << endl;
+				FErrorFile() << "Insufficient arguments" << endl;
+				FlushErrorFile();
+			} else {
+				RunJobServer(Arguments[i+1]);
+			}
+			return;
+		}
+	}
+	RunCommandlineActions(Arguments);
+}
+
+void LoadCommandlineParameters(vector<string>& Arguments, vector<string> ParameterFiles) {
 	for (int i=0; i < int(Arguments.size()); i++) {
 		if (Arguments[i].compare("parameterfile") == 0) {
 			if (int(Arguments.size()) >= i+2) {
@@ -45,17 +75,17 @@ void CommandlineInterface(vector<string> Arguments) {
 			}
 		} 
 	}
-	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
-	if (Initialize() != SUCCESS) {
-		return;
-	}
-	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+}
+
+int RunCommandlineActions(vector<string>& Arguments) {
+	int Status = SUCCESS;
 	for (int i=0; i < int(Arguments.size()); i++) {
 		if (Arguments[i].compare("stringcode") == 0) {
 			if (int(Arguments.size()) < i+3) {
 				cout << "Insufficient arguments" << endl;
 				FErrorFile() << "Insufficient arguments" << endl;
 				FlushErrorFile();
+				Status = FAIL;
 			} else {
 				CreateStringCode(Arguments[i+1],Arguments[i+2]);
 				i += 2;
@@ -65,14 +95,18 @@ void CommandlineInterface(vector<string> Arguments) {
 				cout << "Insufficient arguments" << endl;
 				FErrorFile() << "Insufficient arguments" << endl;
 				FlushErrorFile();
+				Status = FAIL;
 			} else {
-				LoadDatabaseFile(Arguments[i+1].data());		
+				if (LoadDatabaseFile(Arguments[i+1].data()) == FAIL) {
+					Status = FAIL;
+				}
 			}
 		} else if (Arguments[i].compare("metabolites") == 0) {
 			if (int(Arguments.size()) < i+2) {
 				cout << "Insufficient arguments" << endl;
 				FErrorFile() << "Insufficient arguments" << endl;
 				FlushErrorFile();
+				Status = FAIL;
 			} else {
 				SetParameter("metabolites to optimize",Arguments[i+1].data());		
 			}
@@ -81,6 +115,7 @@ void CommandlineInterface(vector<string> Arguments) {
 				cout << "Insufficient arguments" << endl;
 				FErrorFile() << "Insufficient arguments" << endl;
 				FlushErrorFile();
+				Status = FAIL;
 			} else {
 				RunWebGCM(Arguments[i+1].data(),Arguments[i+2].data());		
 			}
@@ -89,6 +124,7 @@ void CommandlineInterface(vector<string> Arguments) {
 				cout << "Insufficient arguments" << endl;
 				FErrorFile() << "Insufficient arguments" << endl;
 				FlushErrorFile();
+				Status = FAIL;
 			} else {
 				ProcessMolfileDirectory(Arguments[i+1].data(),Arguments[i+2].data());		
 			}
@@ -96,6 +132,35 @@ void CommandlineInterface(vector<string> Arguments) {
 			ProcessMolfiles();
 		}
 	}
+	if (RunLocalLPJobs(Arguments) == FAIL) {
+		Status = FAIL;
+	}
+	return Status;
+}
+
+//When LP files were printed rather than solved, this runs the job file on a local pool of solver processes
+//The actions are then repeated with the solver outputs standing in for the solver; a solve whose problem differs from the printed one is solved directly
+int RunLocalLPJobs(vector<string>& Arguments) {
+	int NumWorkers = atoi(GetParameter("Local LP job workers").data());
+	if (NumWorkers <= 0 || GetParameter("print lp files rather than solve").compare("1") != 0 || GetParameter("LP file index").length() == 0) {
+		return SUCCESS;
+	}
+	int NumJobs = atoi(GetParameter("LP file index").data());
+	cout << "Running " << NumJobs << " LP jobs on " << NumWorkers << " local workers" << endl;
+	int Failures = RunCommandFile(FOutputFilepath()+"MFAOutput/LPFiles/JobFile.txt",NumWorkers);
+	if (Failures != 0) {
+		//Replaying with missing or partial output files would hand analyses the wrong solutions
+		FErrorFile() << "Local LP job run failed for " << Failures << " jobs; not replaying the solver outputs." << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+	SetParameter("print lp files rather than solve","0");
+	SetParameter("use solver output files","1");
+	SetParameter("LP file index","");
+	int Status = RunCommandlineActions(Arguments);
+	SetParameter("use solver output files","0");
+	SetParameter("print lp files rather than solve","1");
+	return Status;
 }
 
 void RunWebGCM(string InputFilename,string OutputFilename) {
@@ -133,7 +198,7 @@ void CreateStringCode(string InputFilename, string OutputFilename) {
 	delete NewData;
 }
 
-void LoadDatabaseFile(const char* DatabaseFilename) {
+int LoadDatabaseFile(const char* DatabaseFilename) {
 	if (GetParameter("Network output location").compare("none") != 0 && GetParameter("Network output location").length() > 0) {
 		if (GetParameter("os").compare("windows") == 0) {
 			system(("move "+GetDatabaseDirectory(false)+GetParameter("output folder")+" "+GetParameter("Network output location")).data());
@@ -156,10 +221,10 @@ void LoadDatabaseFile(const char* DatabaseFilename) {
 	//Loading data from file
 	if (NewData->LoadSystem(Filename) == FAIL) {
 		delete NewData;
-		return;
+		return FAIL;
 	}
 	//Performing a variety of tasks according to the parameters in the parameters files including KEGG lookup, reaction and compound printing etc.
-	NewData->PerformAllRequestedTasks();
+	int Status = NewData->PerformAllRequestedTasks();
 	// Test for Adjustment of DeltaGs for PH for COMPOUNDS
 	bool TestCpds = 0;
 
@@ -272,6 +337,7 @@ void LoadDatabaseFile(const char* DatabaseFilename) {
 		// FlushErrorFile();
 	}
 	delete NewData;
+	return Status;
 };
 
 void ProcessWebInterfaceModels() {
@@ -613,3 +679,263 @@ void ProcessMolfiles() {
 	}
 	Input.close();
 }
+
+//Moves the output folder to the database directory when a network output location is set; rename is tried first so the copy is only made across file systems
+void MoveNetworkOutput() {
+	if (GetParameter("Network output location").compare("none") == 0 || GetParameter("Network output location").length() == 0) {
+		return;
+	}
+	string OutputPath = FOutputFilepath();
+	OutputPath = OutputPath.substr(0,OutputPath.length()-1);
+	if (GetParameter("os").compare("windows") == 0) {
+		system(("move "+OutputPath+" "+GetDatabaseDirectory(false)).data());
+		return;
+	}
+	string Destination = GetDatabaseDirectory(false)+RemovePath(OutputPath);
+	if (rename(OutputPath.data(),Destination.data()) != 0) {
+		system(("cp -r  "+OutputPath+" "+GetDatabaseDirectory(false)).data());
+		system(("rm -rf "+OutputPath).data());
+	}
+}
+
+//Reads one newline terminated job request from a server connection
+bool ReadJobRequest(int Connection, string& Request) {
+	Request.clear();
+	char Buffer[4096];
+	while (int(Request.length()) < 1048576) {
+		ssize_t Read = read(Connection,Buffer,sizeof(Buffer));
+		if (Read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (Read <= 0) {
+			return false;
+		}
+		Request.append(Buffer,Read);
+		string::size_type End = Request.find('\n');
+		if (End != string::npos) {
+			Request = Request.substr(0,End);
+			if (Request.length() > 0 && Request[Request.length()-1] == '\r') {
+				Request = Request.substr(0,Request.length()-1);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+//Wakes the server's accept call when a job exits so the job is reaped right away
+void JobFinishedHandler(int) {
+}
+
+//Runs one job in a forked copy of the server; stdout and stderr go back to the client and the process exits with a nonzero status if any action failed
+void RunServerJob(int Connection, vector<string>& Arguments) {
+	signal(SIGCHLD,SIG_DFL);
+	cout.flush();
+	cerr.flush();
+	dup2(Connection,STDOUT_FILENO);
+	dup2(Connection,STDERR_FILENO);
+	close(Connection);
+
+	vector<string> ParameterFiles;
+	LoadCommandlineParameters(Arguments,ParameterFiles);
+	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+	int Status = 1;
+	if (InitializeOutputFiles() == SUCCESS && RunCommandlineActions(Arguments) == SUCCESS) {
+		Status = 0;
+	}
+	string OutputPath = FOutputFilepath();
+	Cleanup();
+	MoveNetworkOutput();
+	cout << "JOB " << (Status == 0 ? "COMPLETE" : "FAILED") << "\t" << OutputPath << endl;
+	ExitWorkerProcess(-1,Status);
+}
+
+//Server mode: the biochemistry is loaded once and each job runs in a forked copy of this process, so jobs never see each other's parameters or data
+//A request is one line holding the same arguments as the command line, separated by tabs; the line "shutdown" stops the server
+int RunJobServer(string SocketPath) {
+	static ParameterHandle* MaxJobs = GetParameterHandle("Server concurrent jobs");
+	//Loading every record now so the jobs share the parsed tables instead of each parsing them again
+	//Jobs also must not read table files lazily, because every forked job shares the server's file offsets
+	if (GetStringDB() != NULL) {
+		for (int i=0; i < GetStringDB()->number_of_tables(); i++) {
+			GetStringDB()->get_table(i)->load_all_records();
+		}
+	}
+
+	sockaddr_un Address;
+	memset(&Address,0,sizeof(Address));
+	Address.sun_family = AF_UNIX;
+	if (SocketPath.length() >= sizeof(Address.sun_path)) {
+		FErrorFile() << "Server socket path is too long: " << SocketPath << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+	strcpy(Address.sun_path,SocketPath.data());
+	int Server = socket(AF_UNIX,SOCK_STREAM,0);
+	if (Server < 0) {
+		FErrorFile() << "Could not create server socket: " << strerror(errno) << endl;
+		FlushErrorFile();
+		return FAIL;
+	}
+	//Only a socket left behind by an earlier server is removed; any other file at the path is left alone
+	struct stat Existing;
+	if (lstat(SocketPath.data(),&Existing) == 0) {
+		if (!S_ISSOCK(Existing.st_mode)) {
+			FErrorFile() << "Could not listen on " << SocketPath << ": path exists and is not a socket" << endl;
+			FlushErrorFile();
+			close(Server);
+			return FAIL;
+		}
+		unlink(SocketPath.data());
+	}
+	//Jobs run with the server's access to the database, so only the owner may connect; nobody can connect before listen, and changing the umask instead would affect files other threads create meanwhile
+	if (bind(Server,(sockaddr*)&Address,sizeof(Address)) != 0 || chmod(SocketPath.data(),0600) != 0 || listen(Server,SOMAXCONN) != 0) {
+		FErrorFile() << "Could not listen on " << SocketPath << ": " << strerror(errno) << endl;
+		FlushErrorFile();
+		close(Server);
+		return FAIL;
+	}
+	//A client that disconnects early must not kill its job halfway through writing output
+	signal(SIGPIPE,SIG_IGN);
+	//Installed without SA_RESTART, so a finished job interrupts accept and is reaped at the top of the loop instead of waiting for the next request
+	struct sigaction JobFinished;
+	memset(&JobFinished,0,sizeof(JobFinished));
+	JobFinished.sa_handler = JobFinishedHandler;
+	sigemptyset(&JobFinished.sa_mask);
+	JobFinished.sa_flags = SA_NOCLDSTOP;
+	sigaction(SIGCHLD,&JobFinished,NULL);
+	cout << "Job server listening on " << SocketPath << endl;
+
+	set<pid_t> Jobs;
+	while (true) {
+		int Status;
+		pid_t Finished;
+		while ((Finished = waitpid(-1,&Status,WNOHANG)) > 0) {
+			Jobs.erase(Finished);
+		}
+		int Connection = accept(Server,NULL,NULL);
+		if (Connection < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			FErrorFile() << "Server accept failed: " << strerror(errno) << endl;
+			FlushErrorFile();
+			break;
+		}
+		//A client that connects and never sends its request must not stall the server
+		timeval Timeout;
+		Timeout.tv_sec = 10;
+		Timeout.tv_usec = 0;
+		setsockopt(Connection,SOL_SOCKET,SO_RCVTIMEO,&Timeout,sizeof(Timeout));
+		string Request;
+		if (!ReadJobRequest(Connection,Request)) {
+			close(Connection);
+			continue;
+		}
+		if (Request.compare("shutdown") == 0) {
+			WriteToPipe(Connection,"SHUTDOWN\n",9);
+			close(Connection);
+			break;
+		}
+		vector<string>* Strings = StringToStrings(Request,"\t",false);
+		vector<string> Arguments(*Strings);
+		delete Strings;
+
+		while (MaxJobs->Int > 0 && int(Jobs.size()) >= MaxJobs->Int) {
+			Finished = waitpid(-1,&Status,0);
+			if (Finished > 0) {
+				Jobs.erase(Finished);
+			} else if (errno != EINTR) {
+				Jobs.clear();
+			}
+		}
+		//Flushing buffered output so it is not duplicated by the job
+		cout.flush();
+		cerr.flush();
+		FLogFile().flush();
+		FlushErrorFile();
+		SyncErrorLog();
+		pid_t Pid = fork();
+		if (Pid == 0) {
+			close(Server);
+			RunServerJob(Connection,Arguments);
+		} else if (Pid < 0) {
+			string Message = "JOB FAILED\tcould not fork\n";
+			WriteToPipe(Connection,Message.data(),int(Message.length()));
+		} else {
+			Jobs.insert(Pid);
+		}
+		close(Connection);
+	}
+	close(Server);
+	unlink(SocketPath.data());
+	for (set<pid_t>::iterator SetIT = Jobs.begin(); SetIT != Jobs.end(); SetIT++) {
+		int Status;
+		while (waitpid(*SetIT,&Status,0) < 0 && errno == EINTR) {
+		}
+	}
+	signal(SIGCHLD,SIG_DFL);
+	return SUCCESS;
+}
+
+//Client mode: sends one job to a running server and copies its output to stdout; returns 0 only if the job completed
+int RunJobClient(string SocketPath, vector<string>& Arguments) {
+	sockaddr_un Address;
+	memset(&Address,0,sizeof(Address));
+	Address.sun_family = AF_UNIX;
+	if (SocketPath.length() >= sizeof(Address.sun_path)) {
+		cerr << "Server socket path is too long: " << SocketPath << endl;
+		return 1;
+	}
+	strcpy(Address.sun_path,SocketPath.data());
+	int Connection = socket(AF_UNIX,SOCK_STREAM,0);
+	if (Connection < 0 || connect(Connection,(sockaddr*)&Address,sizeof(Address)) != 0) {
+		cerr << "Could not connect to " << SocketPath << ": " << strerror(errno) << endl;
+		if (Connection >= 0) {
+			close(Connection);
+		}
+		return 1;
+	}
+	string Request;
+	for (int i=0; i < int(Arguments.size()); i++) {
+		if (i > 0) {
+			Request.append("\t");
+		}
+		Request.append(Arguments[i]);
+	}
+	Request.append("\n");
+	if (!WriteToPipe(Connection,Request.data(),int(Request.length()))) {
+		close(Connection);
+		return 1;
+	}
+	//The last line of the reply carries the job status
+	string LastLine;
+	string CurrentLine;
+	char Buffer[65536];
+	while (true) {
+		ssize_t Read = read(Connection,Buffer,sizeof(Buffer));
+		if (Read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (Read <= 0) {
+			break;
+		}
+		fwrite(Buffer,1,Read,stdout);
+		for (int i=0; i < int(Read); i++) {
+			if (Buffer[i] == '\n') {
+				if (CurrentLine.length() > 0) {
+					LastLine = CurrentLine;
+				}
+				CurrentLine.clear();
+			} else if (CurrentLine.length() < 4096) {
+				CurrentLine.push_back(Buffer[i]);
+			}
+		}
+	}
+	if (CurrentLine.length() > 0) {
+		LastLine = CurrentLine;
+	}
+	fflush(stdout);
+	close(Connection);
+	return (LastLine.substr(0,12).compare("JOB COMPLETE") == 0) ? 0 : 1;
+}
@@ -2,23 +2,21 @@
 #include "lindo.h"
 
 pLSenv Lindoenv;
-pLSmodel LindoModel;
-int NumberLindoVariables;
-int NumberLindoConstraints;
+
+//Lindo model state held in SolverContext::LINDOModel; the environment is shared by all contexts
+struct LINDOProblemData {
+	pLSmodel LindoModel;
+	int NumberLindoVariables;
+	int NumberLindoConstraints;
+};
 
 int InitializeLINDOVariables() {
 	Lindoenv = NULL;
-	LindoModel = NULL;
-	NumberLindoVariables = 0;
-	NumberLindoConstraints = 0;
 	return SUCCESS;
 }
 
-int LINDOInitialize() {
+int LINDOInitialize(SolverContext* Context) {
 	int Status = 0;
-	
-	NumberLindoVariables = 0;
-	NumberLindoConstraints = 0;
 
 	//First I open the CPLEX environment if it is not already open
 	if (Lindoenv == NULL) {
@@ -58,13 +56,17 @@ int LINDOInitialize() {
 	}
 
 	//Next I clear out any models that currently exist
-	if (LINDOClearSolver() != SUCCESS) {
+	if (LINDOClearSolver(Context) != SUCCESS) {
 		return FAIL; //error message already printed	
 	}
 
 	//Now I create a new Lindo model
-	LindoModel = LScreateModel(Lindoenv, &Status);
-	if (Status || LindoModel == NULL) {
+	LINDOProblemData* Problem = new LINDOProblemData;
+	Problem->NumberLindoVariables = 0;
+	Problem->NumberLindoConstraints = 0;
+	Problem->LindoModel = LScreateModel(Lindoenv, &Status);
+	Context->LINDOModel = Problem;
+	if (Status || Problem->LindoModel == NULL) {
 		FErrorFile() << "Failed to create new Lindo model." << endl;
 		FlushErrorFile();
 		return FAIL;
@@ -73,10 +75,10 @@ int LINDOInitialize() {
 	return SUCCESS;
 }
 
-int LINDOCleanup() {
+int LINDOCleanup(SolverContext* Context) {
 	int Status = 0;
 
-	if (LINDOClearSolver() != SUCCESS) {
+	if (LINDOClearSolver(Context) != SUCCESS) {
 		return FAIL; //error message already printed	
 	}
 
@@ -92,31 +94,37 @@ int LINDOCleanup() {
 	return SUCCESS;
 }
 
-int LINDOClearSolver() {
-	NumberLindoVariables = 0;
-	NumberLindoConstraints = 0;
-	
-	if (LindoModel != NULL) {
-		int Status = LSdeleteModel(&LindoModel);
-		if (Status || LindoModel != NULL) {
+int LINDOClearSolver(SolverContext* Context) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
+	if (Problem == NULL) {
+		return SUCCESS;
+	}
+	Context->LINDOModel = NULL;
+
+	if (Problem->LindoModel != NULL) {
+		int Status = LSdeleteModel(&Problem->LindoModel);
+		if (Status || Problem->LindoModel != NULL) {
+			delete Problem;
 			FErrorFile() << "Failed to delete lindo model." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
 	}
+	delete Problem;
 
 	return SUCCESS;
 }
 
-int LINDOPrintFromSolver() {
-	if (LindoModel == NULL) {
+int LINDOPrintFromSolver(SolverContext* Context) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
+	if (Problem == NULL || Problem->LindoModel == NULL) {
 		FErrorFile() << "Failed to write lindo model to file because model does not exist." << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
 
 	char* Temp = ConvertStringToCString(GetParameter("LP filename"));
-	int Status = LSwriteMPSFile(LindoModel, Temp, LS_FORMATTED_MPS);
+	int Status = LSwriteMPSFile(Problem->LindoModel, Temp, LS_FORMATTED_MPS);
 	delete [] Temp;
 	if (Status) {
 		FErrorFile() << "Failed to write lindo model to file." << endl;
@@ -126,11 +134,12 @@ int LINDOPrintFromSolver() {
 	return SUCCESS;
 }
 
-OptSolutionData* LINDORunSolver(int ProbType) {
+OptSolutionData* LINDORunSolver(SolverContext* Context, int ProbType) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
 	int Status = 0;
 	OptSolutionData* NewSolution = NULL;
 	
-	if (LindoModel == NULL) {
+	if (Problem == NULL || Problem->LindoModel == NULL) {
 		FErrorFile() << "Cannot optimize because model does not exist." << endl;
 		FlushErrorFile();
 		return NULL;
@@ -138,11 +147,11 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 
 	int TempStatus = 0;
 	if (ProbType == MILP || ProbType == MIQP || ProbType == MINP) {
-		Status = LSsolveMIP(LindoModel,&TempStatus);
+		Status = LSsolveMIP(Problem->LindoModel,&TempStatus);
 	} else if (ProbType == LP || ProbType ==  QP) {
-		Status = LSoptimize(LindoModel,LS_METHOD_FREE,&TempStatus);
+		Status = LSoptimize(Problem->LindoModel,LS_METHOD_FREE,&TempStatus);
 	} else if (ProbType == NP) {
-		Status = LSsolveGOP(LindoModel,&TempStatus);
+		Status = LSsolveGOP(Problem->LindoModel,&TempStatus);
 	} else {
 		FErrorFile() << "Unrecognized problem type." << endl;
 		FlushErrorFile();
@@ -177,10 +186,10 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 		NewSolution->Status = SUCCESS;
 	}
 
-	double* VariableValues = new double[NumberLindoVariables];
+	double* VariableValues = new double[Problem->NumberLindoVariables];
 	if (ProbType == MILP || ProbType == MIQP || ProbType == MINP) {
 		double* Objective = new double[1];
-		Status = LSgetInfo(LindoModel,LS_DINFO_MIP_OBJ,Objective);
+		Status = LSgetInfo(Problem->LindoModel,LS_DINFO_MIP_OBJ,Objective);
 		if (Status) {
 			FErrorFile() << "Failed to obtain objective data from Lindo." << endl;
 			FlushErrorFile();
@@ -189,10 +198,10 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 		NewSolution->Objective = Objective[0];
 		delete [] Objective;
 		cout << "Objective = " << NewSolution->Objective << endl;
-		Status = LSgetMIPPrimalSolution(LindoModel, VariableValues);
+		Status = LSgetMIPPrimalSolution(Problem->LindoModel, VariableValues);
 	} else if (ProbType == LP || ProbType ==  QP || ProbType == NP) {
 		double* Objective = new double[1];
-		Status = LSgetInfo(LindoModel,LS_DINFO_POBJ,Objective);
+		Status = LSgetInfo(Problem->LindoModel,LS_DINFO_POBJ,Objective);
 		if (Status) {
 			FErrorFile() << "Failed to obtain objective data from Lindo." << endl;
 			FlushErrorFile();
@@ -201,7 +210,7 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 		NewSolution->Objective = Objective[0];
 		delete [] Objective;
 		cout << "Objective = " << NewSolution->Objective << endl;
-		Status = LSgetPrimalSolution(LindoModel, VariableValues);
+		Status = LSgetPrimalSolution(Problem->LindoModel, VariableValues);
 	} else {
 		FErrorFile() << "Unrecognized problem type." << endl;
 		FlushErrorFile();
@@ -213,9 +222,9 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 		return NULL;
 	}
 
-	NewSolution->NumVariables = NumberLindoVariables;
-	NewSolution->SolutionData.resize(NumberLindoVariables);
-	for (int i=0; i < NumberLindoVariables; i++) {
+	NewSolution->NumVariables = Problem->NumberLindoVariables;
+	NewSolution->SolutionData.resize(Problem->NumberLindoVariables);
+	for (int i=0; i < Problem->NumberLindoVariables; i++) {
 		NewSolution->SolutionData[i] = VariableValues[i];
 	}
 	delete [] VariableValues;
@@ -223,7 +232,8 @@ OptSolutionData* LINDORunSolver(int ProbType) {
 	return NewSolution;
 }
 
-int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int LINDOLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
 	int Status = 0;
 	
 	double* UpperBound = new double[1];
@@ -242,21 +252,21 @@ int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool
 		Type[0] = 'C';
 	}
 
-	if (InVariable->Index >= NumberLindoVariables) {
+	if (InVariable->Index >= Problem->NumberLindoVariables) {
 		double* ObjCoef = new double[1];
 		ObjCoef[0] = 0;
 		int* Columns = new int[2];
 		Columns[0] = 0;
 		Columns[1] = 0;
 
-		Status = LSaddVariables(LindoModel, 1, Type, NULL, NULL,Columns,  NULL,  NULL, ObjCoef,LowerBound, UpperBound);
+		Status = LSaddVariables(Problem->LindoModel, 1, Type, NULL, NULL,Columns,  NULL,  NULL, ObjCoef,LowerBound, UpperBound);
 		if (Status) {
 			FErrorFile() << "Failed to add variable to Lindo model." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
 
-		NumberLindoVariables++;
+		Problem->NumberLindoVariables++;
 		delete [] ObjCoef;
 		delete [] Columns;
 	} else {
@@ -264,13 +274,13 @@ int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool
 		//Modfying variable bounds
 		int* VariableIndex = new int[1];
 		VariableIndex[0] = InVariable->Index;
-		Status = LSmodifyLowerBounds(LindoModel, 1, VariableIndex, LowerBound);	
+		Status = LSmodifyLowerBounds(Problem->LindoModel, 1, VariableIndex, LowerBound);	
 		if (Status) {
 			FErrorFile() << "Failed to modify variable lower bound." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
-		Status = LSmodifyUpperBounds(LindoModel, 1, VariableIndex, UpperBound);	
+		Status = LSmodifyUpperBounds(Problem->LindoModel, 1, VariableIndex, UpperBound);	
 		if (Status) {
 			FErrorFile() << "Failed to modify variable upper bound." << endl;
 			FlushErrorFile();
@@ -278,7 +288,7 @@ int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool
 		}
 
 		//Modfying variable type
-		Status = LSmodifyVariableType(LindoModel, 1, VariableIndex, Type);
+		Status = LSmodifyVariableType(Problem->LindoModel, 1, VariableIndex, Type);
 		if (Status) {
 			FErrorFile() << "Failed to modify variable type." << endl;
 			FlushErrorFile();
@@ -294,7 +304,8 @@ int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool
 	return SUCCESS;
 }
 
-int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
+int LINDOLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
 	if (InEquation->QuadCoeff.size() > 0) {
 		FErrorFile() << "Support for quadratic objectives in LINDO has not yet been added." << endl;
 		FlushErrorFile();
@@ -303,16 +314,16 @@ int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
 
 	int Status = 0;
 
-	if (LindoModel == NULL) {
+	if (Problem == NULL || Problem->LindoModel == NULL) {
 		FErrorFile() << "Failed to add objective because Lindo model does not exist." << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
 
 	if (Max) {
-		Status = LSsetModelIntParameter(LindoModel,LS_IPARAM_OBJSENSE,LS_MAX);
+		Status = LSsetModelIntParameter(Problem->LindoModel,LS_IPARAM_OBJSENSE,LS_MAX);
 	} else {
-		Status = LSsetModelIntParameter(LindoModel,LS_IPARAM_OBJSENSE,LS_MIN);
+		Status = LSsetModelIntParameter(Problem->LindoModel,LS_IPARAM_OBJSENSE,LS_MIN);
 	}
 	if (Status) {
 		FErrorFile() << "Failed to set parameter in Lindo model." << endl;
@@ -321,13 +332,13 @@ int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
 	}
 
 	//Resetting all objective coefficients to zero
-	double* Coeff = new double[NumberLindoVariables];
-	int* Indecies = new int[NumberLindoVariables];
-	for (int i=0; i < NumberLindoVariables; i++) {
+	double* Coeff = new double[Problem->NumberLindoVariables];
+	int* Indecies = new int[Problem->NumberLindoVariables];
+	for (int i=0; i < Problem->NumberLindoVariables; i++) {
 		Coeff[i] = 0;
 		Indecies[i] = i;
 	}
-	Status = LSmodifyObjective(LindoModel, NumberLindoVariables, Indecies, Coeff);
+	Status = LSmodifyObjective(Problem->LindoModel, Problem->NumberLindoVariables, Indecies, Coeff);
 	if (Status) {
 		FErrorFile() << "Failed to set objective coefficients in Lindo model." << endl;
 		FlushErrorFile();
@@ -341,7 +352,7 @@ int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
 	Indecies = new int[InEquation->Variables.size()];
 	for (int i=0; i < int(InEquation->Variables.size()); i++) {
 		Coeff[i] = InEquation->Coefficient[i];
-		if (Indecies[i] = InEquation->Variables[i]->Index < NumberLindoVariables) {
+		if (Indecies[i] = InEquation->Variables[i]->Index < Problem->NumberLindoVariables) {
 			Indecies[i] = InEquation->Variables[i]->Index;
 		} else {
 			FErrorFile() << "Objective index out of the range of variables indecies for model." << endl;
@@ -349,7 +360,7 @@ int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
 			return FAIL;
 		}
 	}
-	Status = LSmodifyObjective(LindoModel, int(InEquation->Variables.size()), Indecies, Coeff);
+	Status = LSmodifyObjective(Problem->LindoModel, int(InEquation->Variables.size()), Indecies, Coeff);
 	if (Status) {
 		FErrorFile() << "Failed to set objective coefficients in Lindo model." << endl;
 		FlushErrorFile();
@@ -361,7 +372,8 @@ int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
 	return SUCCESS;
 }
 
-int LINDOAddConstraint(LinEquation* InEquation) {
+int LINDOAddConstraint(SolverContext* Context, LinEquation* InEquation) {
+	LINDOProblemData* Problem = (LINDOProblemData*)Context->LINDOModel;
 	if (InEquation->QuadCoeff.size() > 0) {
 		FErrorFile() << "Support for quadratic constraints in LINDO has not yet been added." << endl;
 		FlushErrorFile();
@@ -386,7 +398,7 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 	double* RHS = new double[1];
 	RHS[0] = InEquation->RightHandSide;
 	
-	if (InEquation->Index >= NumberLindoConstraints) {
+	if (InEquation->Index >= Problem->NumberLindoConstraints) {
 		if (InEquation->Variables.size() > 0) {
 			double* Coeff = new double[InEquation->Variables.size()];
 			int* Columns = new int[InEquation->Variables.size()];
@@ -394,7 +406,7 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 			Rows[0] = 0;
 			Rows[1] = int(InEquation->Variables.size());
 			for (int i=0; i < int(InEquation->Variables.size()); i++) {
-				if (InEquation->Variables[i]->Index < NumberLindoVariables) {
+				if (InEquation->Variables[i]->Index < Problem->NumberLindoVariables) {
 					Coeff[i] = InEquation->Coefficient[i];
 					Columns[i] = InEquation->Variables[i]->Index;
 				} else {
@@ -404,9 +416,9 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 				}
 			}
 
-			Status = LSaddConstraints(LindoModel, 1, Type, NULL, Rows, Coeff, Columns, RHS);
-			//Status = LSaddConstraints(LindoModel, 1, Type, Names, Rows, Coeff, Columns, RHS);
-			NumberLindoConstraints++;
+			Status = LSaddConstraints(Problem->LindoModel, 1, Type, NULL, Rows, Coeff, Columns, RHS);
+			//Status = LSaddConstraints(Problem->LindoModel, 1, Type, Names, Rows, Coeff, Columns, RHS);
+			Problem->NumberLindoConstraints++;
 
 			delete [] Coeff;
 			delete [] Columns;
@@ -415,8 +427,8 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 	} else {
 		//We are not adding a new constraint but modifying an existing one
 		//First I modify the constraint coefficients
-		for(int i=0; i < NumberLindoVariables; i++) {
-			Status = LSmodifyAij(LindoModel,InEquation->Index,i,0);
+		for(int i=0; i < Problem->NumberLindoVariables; i++) {
+			Status = LSmodifyAij(Problem->LindoModel,InEquation->Index,i,0);
 			if (Status) {
 				FErrorFile() << "Failed to modify constraint coefficient." << endl;
 				FlushErrorFile();
@@ -424,7 +436,7 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 			}
 		}
 		for(int i=0; i < int(InEquation->Variables.size()); i++) {
-			Status = LSmodifyAij(LindoModel,InEquation->Index,InEquation->Variables[i]->Index,InEquation->Coefficient[i]);
+			Status = LSmodifyAij(Problem->LindoModel,InEquation->Index,InEquation->Variables[i]->Index,InEquation->Coefficient[i]);
 			if (Status) {
 				FErrorFile() << "Failed to modify constraint coefficient." << endl;
 				FlushErrorFile();
@@ -435,13 +447,13 @@ int LINDOAddConstraint(LinEquation* InEquation) {
 		//Now I modify the constraint type and the RHS
 		int* ConstraintIndex = new int[1];
 		ConstraintIndex[0] = InEquation->Index;
-		Status = LSmodifyConstraintType(LindoModel, 1, ConstraintIndex, Type);
+		Status = LSmodifyConstraintType(Problem->LindoModel, 1, ConstraintIndex, Type);
 		if (Status) {
 			FErrorFile() << "Failed to modify constraint type." << endl;
 			FlushErrorFile();
 			return FAIL;
 		}
-		Status = LSmodifyRHS(LindoModel, 1, ConstraintIndex,RHS);
+		Status = LSmodifyRHS(Problem->LindoModel, 1, ConstraintIndex,RHS);
 		if (Status) {
 			FErrorFile() << "Failed to modify constraint RHS." << endl;
 			FlushErrorFile();
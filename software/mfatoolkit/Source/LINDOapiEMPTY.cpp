@@ -24,34 +24,34 @@ int InitializeLINDOVariables() {
 	return FAIL;
 }
 
-int LINDOInitialize() {
+int LINDOInitialize(SolverContext*) {
 	return FAIL;
 }
 
-int LINDOCleanup() {
+int LINDOCleanup(SolverContext*) {
 	return FAIL;
 }
 
-int LINDOClearSolver() {
+int LINDOClearSolver(SolverContext*) {
 	return FAIL;
 }
 
-int LINDOPrintFromSolver() {
+int LINDOPrintFromSolver(SolverContext*) {
 	return FAIL;
 }
 
-OptSolutionData* LINDORunSolver(int ProbType) {
+OptSolutionData* LINDORunSolver(SolverContext*, int ProbType) {
 	return NULL;
 }
 
-int LINDOLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int LINDOLoadVariables(SolverContext*, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
 	return FAIL;
 }
 
-int LINDOLoadObjective(LinEquation* InEquation, bool Max) {
+int LINDOLoadObjective(SolverContext*, LinEquation* InEquation, bool Max) {
 	return FAIL;
 }
 
-int LINDOAddConstraint(LinEquation* InEquation) {
+int LINDOAddConstraint(SolverContext*, LinEquation* InEquation) {
 	return FAIL;
 }
\ No newline at end of file
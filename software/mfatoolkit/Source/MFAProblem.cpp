@@ -32,6 +32,9 @@ MFAProblem::MFAProblem() {
 	LoadedRelaxation = false;
 	UseTightBounds = false;
 	ProblemLoaded = false;
+	Context = NewSolverContext();
+	ReferenceBasis = NULL;
+	ReferenceSolution = NULL;
 
 	string Filename(FOutputFilepath());
 	Filename.append(GetParameter("MFA problem report filename"));
@@ -60,6 +63,9 @@ MFAProblem::~MFAProblem() {
 		delete ObjFunct;
 	}
 
+	ClearReferenceBasis();
+	SetReferenceSolution(NULL);
+	DeleteSolverContext(Context);
 	ClearClock(MFAProblemClockIndex);
 }
 
@@ -198,9 +204,10 @@ void MFAProblem::DetermineProbType() {
 	bool Nonlinear = false;
 	bool Quadratic = false;
 
+	static ParameterHandle* AlwaysRelax = GetParameterHandle("Always relax integer variables");
 	for (int i=0; i < FNumVariables(); i++) {
 		if (Variables[i]->Binary || Variables[i]->Integer) {
-			if (!RelaxIntegerVariables && GetParameter("Always relax integer variables").compare("1") != 0) {
+			if (!RelaxIntegerVariables && !AlwaysRelax->Bool) {
 				Integer = true;
 			}
 		}
@@ -498,6 +505,7 @@ LinEquation* MFAProblem::MakeObjectiveConstraint(double Value, int Equality) {
 }
 
 int MFAProblem::BuildMFAProblem(Data* InData,OptimizationParameter*& InParameters) {
+	ScopedTimer Timer("BuildMFAProblem");
 	SourceDatabase = InData;
 	if (InData == NULL) {
 		FErrorFile() << "Failed to build MFA problem: no data was passed in" << endl;
@@ -614,14 +622,18 @@ int MFAProblem::BuildMFAProblem(Data* InData,OptimizationParameter*& InParameter
 	for (int i=0; i < InData->FNumGenes(); i++) {
 		InData->GetGene(i)->SetMark(false);
 	}
+	vector<bool> GeneKO(InData->FNumGenes(),false);
 	for (int i=0; i < int(InParameters->KOGenes.size()); i++) {
 		Gene* Temp = InData->FindGene("DATABASE",InParameters->KOGenes[i].data());
 		if (Temp != NULL) {
 			Temp->SetMark(true);
+			GeneKO[Temp->FIndex()] = true;
 		}
 	}
-	for (int j=0; j < InData->FNumReactions(); j++) {
-		if (InData->GetReaction(j)->CheckForKO()) {
+	vector<bool> ReactionKO;
+	InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+	for (int j=0; j < int(ReactionKO.size()); j++) {
+		if (ReactionKO[j]) {
 			InData->GetReaction(j)->UpdateBounds(FLUX,0,0);
 		}
 	}
@@ -1440,13 +1452,13 @@ LinEquation* MFAProblem::ConvertStringToObjective(string ObjString, Data* InData
 							}
 						} else {
 							FErrorFile() << (*ObjectiveTerms)[Count+1] << " has no " << (*ObjectiveTerms)[Count] << " variable type." << endl;
-							FlushErrorFile();
+							FlushErrorFile(SEVERITY_WARNING);
 							return NULL;
 						}
 					}		
 				} else {
 					FErrorFile() << (*ObjectiveTerms)[Count+1] << " variable not found." << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_WARNING);
 					return NULL;
 				}
 			} else if (VarType == CONC || VarType == LOG_CONC || VarType == DRAIN_FLUX || VarType == FORWARD_DRAIN_FLUX || VarType == REVERSE_DRAIN_FLUX) {
@@ -1499,18 +1511,18 @@ LinEquation* MFAProblem::ConvertStringToObjective(string ObjString, Data* InData
 							}
 						} else {
 							FErrorFile() << (*ObjectiveTerms)[Count+2] << " compartment type not recognized." << endl;
-							FlushErrorFile();
+							FlushErrorFile(SEVERITY_WARNING);
 							return NULL;
 						}
 					}
 					if (NewVariable == NULL) {
 						FErrorFile() << (*ObjectiveTerms)[Count+1] << " has no " << (*ObjectiveTerms)[Count] << " variable type." << endl;
-						FlushErrorFile();
+						FlushErrorFile(SEVERITY_WARNING);
 						return NULL;
 					}		
 				} else {
 					FErrorFile() << (*ObjectiveTerms)[Count+1] << " variable not found." << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_WARNING);
 					return NULL;
 				}
 			}
@@ -1656,7 +1668,7 @@ int MFAProblem::ApplyInputBounds(FileBounds* InBounds, Data* InData, bool ApplyT
 				Temp->UpdateBounds(InBounds->VarType[i],InBounds->VarMin[i],InBounds->VarMax[i],Compartment,ApplyToMinMax);
 			} else {
 				FErrorFile() << "Could not find compound named: " << InBounds->VarName[i] << endl;
-				FlushErrorFile();
+				FlushErrorFile(SEVERITY_WARNING);
 			}
 		} else if (InBounds->VarType[i] == FLUX || InBounds->VarType[i] == FORWARD_FLUX || InBounds->VarType[i] == REVERSE_FLUX || InBounds->VarType[i] == DELTAG || InBounds->VarType[i] == REACTION_DELTAG_ERROR) {
 			Reaction* Temp = InData->FindReaction("KEGG;PALSSON;MINORG;DATABASE;NAME;ENTRY",InBounds->VarName[i].data());
@@ -1664,7 +1676,7 @@ int MFAProblem::ApplyInputBounds(FileBounds* InBounds, Data* InData, bool ApplyT
 				Temp->UpdateBounds(InBounds->VarType[i],InBounds->VarMin[i],InBounds->VarMax[i],ApplyToMinMax);
 			} else {
 				FErrorFile() << "Could not find reaction named: " << InBounds->VarName[i] << endl;
-				FlushErrorFile();
+				FlushErrorFile(SEVERITY_WARNING);
 			}
 		} else if (InBounds->VarType[i] == GENE_USE) {
 			Gene* Temp = InData->FindGene("KEGG;PALSSON;MINORG;DATABASE;NAME;ENTRY",InBounds->VarName[i].data());
@@ -1674,7 +1686,7 @@ int MFAProblem::ApplyInputBounds(FileBounds* InBounds, Data* InData, bool ApplyT
 				TempVar->LowerBound = InBounds->VarMin[i];
 			} else {
 				FErrorFile() << "Could not find reaction named: " << InBounds->VarName[i] << endl;
-				FlushErrorFile();
+				FlushErrorFile(SEVERITY_WARNING);
 			}
 		}
 	}
@@ -1751,7 +1763,7 @@ int MFAProblem::ApplyInputConstraints(ConstraintsToAdd* AddConstraints, Data* In
 					}
 				} else {
 					FErrorFile() << "Could not find compound named: " << AddConstraints->VarName[i][j] << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_WARNING);
 					Pass = false;
 				}
 			} else if (AddConstraints->VarType[i][j] == FLUX || AddConstraints->VarType[i][j] == FORWARD_FLUX || AddConstraints->VarType[i][j] == REVERSE_FLUX || AddConstraints->VarType[i][j] == DELTAG) {
@@ -1792,7 +1804,7 @@ int MFAProblem::ApplyInputConstraints(ConstraintsToAdd* AddConstraints, Data* In
 					}
 				} else {
 					FErrorFile() << "Could not find reaction named: " << AddConstraints->VarName[i][j] << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_WARNING);
 					Pass = false;
 				}
 			}
@@ -1802,7 +1814,7 @@ int MFAProblem::ApplyInputConstraints(ConstraintsToAdd* AddConstraints, Data* In
 		} else {
 			delete NewConstraint;
 			FErrorFile() << "Unable to add user constraint due to missing variable." << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_WARNING);
 		}
 	}
 	return SUCCESS;
@@ -1931,25 +1943,42 @@ string MFAProblem::fluxToString() {
 
 //Solver interaction
 int MFAProblem::LoadSolver(bool PrintFromSolver) {
+	ScopedTimer Timer("LoadSolver");
 	int Status = FAIL;
 	DetermineProbType();	
-	Status = GlobalInitializeSolver(Solver);	
+	Status = GlobalInitializeSolver(Context,Solver);	
 	ProblemLoaded = false;
+	ClearReferenceBasis();
 	LoadedRelaxation = RelaxIntegerVariables;
 	if (Status != SUCCESS) {
 		FErrorFile() << "Failed to load solver because solver could not be cleared." << endl;
 		FlushErrorFile();
 		return FAIL;
 	}
-	if (LoadAllVariables() != SUCCESS) {
-		FErrorFile() << "Failed to load solver because variables could not be loaded." << endl;
-		FlushErrorFile();
-		return FAIL;	
+	//The bulk path covers linear problems on solvers that accept a whole matrix at once
+	bool LoadInBulk = (GetParameter("Load solver in bulk").compare("0") != 0 && Solver != LINDO);
+	for (int i=0; i < FNumConstraints() && LoadInBulk; i++) {
+		if (GetConstraint(i)->ConstraintType != LINEAR || GetConstraint(i)->QuadCoeff.size() > 0) {
+			LoadInBulk = false;
+		}
 	}
-	if (LoadAllConstToSolver() != SUCCESS) {
-		FErrorFile() << "Failed to load solver because constraints could not be loaded." << endl;
-		FlushErrorFile();
-		return FAIL;	
+	if (LoadInBulk) {
+		if (LoadProblemInBulk() != SUCCESS) {
+			FErrorFile() << "Failed to load solver because problem could not be loaded in bulk." << endl;
+			FlushErrorFile();
+			return FAIL;
+		}
+	} else {
+		if (LoadAllVariables() != SUCCESS) {
+			FErrorFile() << "Failed to load solver because variables could not be loaded." << endl;
+			FlushErrorFile();
+			return FAIL;	
+		}
+		if (LoadAllConstToSolver() != SUCCESS) {
+			FErrorFile() << "Failed to load solver because constraints could not be loaded." << endl;
+			FlushErrorFile();
+			return FAIL;	
+		}
 	}
 	if (LoadObjective() != SUCCESS) {
 		FErrorFile() << "Failed to load solver because objective could not be loaded." << endl;
@@ -1964,6 +1993,7 @@ int MFAProblem::LoadSolver(bool PrintFromSolver) {
 }	
 
 OptSolutionData* MFAProblem::RunSolver(bool SaveSolution, bool InInputSolution,bool WriteProblem) {
+	ScopedTimer Timer("RunSolver");
 	DetermineProbType();
 	
 	if (WriteProblem) {
@@ -1973,7 +2003,7 @@ OptSolutionData* MFAProblem::RunSolver(bool SaveSolution, bool InInputSolution,b
 	
 	OptSolutionData* CurrentSolution = NULL;
 
-	CurrentSolution = GlobalRunSolver(Solver,ProbType);
+	CurrentSolution = GlobalRunSolver(Context,Solver,ProbType);
 	
 	if (SaveSolution && CurrentSolution != NULL) {
 		if (CurrentSolution->Status == SUCCESS) {
@@ -1992,10 +2022,11 @@ OptSolutionData* MFAProblem::RunSolver(bool SaveSolution, bool InInputSolution,b
 int MFAProblem::LoadVariable(int InIndex) {
 	GetVariable(InIndex)->Index = InIndex;
 	int Status;
-	if (GetParameter("Always relax integer variables").compare("1") == 1) {
-		Status = GlobalLoadVariable(Solver,GetVariable(InIndex), true,UseTightBounds);
+	static ParameterHandle* AlwaysRelax = GetParameterHandle("Always relax integer variables");
+	if (AlwaysRelax->Bool) {
+		Status = GlobalLoadVariable(Context,Solver,GetVariable(InIndex), true,UseTightBounds);
 	} else {
-		Status = GlobalLoadVariable(Solver,GetVariable(InIndex), RelaxIntegerVariables,UseTightBounds);
+		Status = GlobalLoadVariable(Context,Solver,GetVariable(InIndex), RelaxIntegerVariables,UseTightBounds);
 	}
 	if (Status == SUCCESS) {
 		GetVariable(InIndex)->Loaded = true;
@@ -2023,12 +2054,47 @@ int MFAProblem::ResetSolver() {
 		}
 
 		ObjFunct->Loaded = false;
+		ClearReferenceBasis();
 
-		return GlobalResetSolver(Solver);
+		return GlobalResetSolver(Context,Solver);
 	}
 	return SUCCESS;
 }
 
+//Saves the basis of the last solve so that later solves differing from it only in variable bounds can restart from it
+int MFAProblem::SaveReferenceBasis() {
+	ClearReferenceBasis();
+	if (GetParameter("Warm start from reference basis").compare("1") != 0) {
+		return FAIL;
+	}
+	ReferenceBasis = new SolverBasis;
+	if (GlobalSaveBasis(Context,Solver,ReferenceBasis) != SUCCESS) {
+		ClearReferenceBasis();
+		return FAIL;
+	}
+	return SUCCESS;
+}
+
+int MFAProblem::RestoreReferenceBasis() {
+	if (ReferenceBasis == NULL) {
+		return FAIL;
+	}
+	if (GlobalLoadBasis(Context,Solver,ReferenceBasis) != SUCCESS) {
+		return FAIL;
+	}
+	//Relative to the restored basis only bounds have moved, so the next solve can use dual simplex
+	Context->BoundsChanged = true;
+	Context->ObjectiveChanged = false;
+	return SUCCESS;
+}
+
+void MFAProblem::ClearReferenceBasis() {
+	if (ReferenceBasis != NULL) {
+		delete ReferenceBasis;
+		ReferenceBasis = NULL;
+	}
+}
+
 int MFAProblem::UpdateLoadSolver() {
 	if (ProblemLoaded) {
 		if (LoadedRelaxation != RelaxIntegerVariables) {
@@ -2201,7 +2267,7 @@ int MFAProblem::LoadAllVariables() {
 }
 
 int MFAProblem::LoadObjective() {
-	int Status = GlobalLoadObjective(Solver,GetObjective(), FMax());
+	int Status = GlobalLoadObjective(Context,Solver,GetObjective(), FMax());
 	if (Status == SUCCESS) {
 		GetObjective()->Loaded = true;
 	}
@@ -2209,61 +2275,65 @@ int MFAProblem::LoadObjective() {
 }
 
 int MFAProblem::LoadConstToSolver(int InIndex) {
-	GetConstraint(InIndex)->Index = InIndex;
-	int Status = FAIL;
+	static ParameterHandle* CheckPotential = GetParameterHandle("Check potential constraints feasibility");
+	bool CheckPotentialFeasibility = CheckPotential->Bool;
+	PrepareConstForSolver(InIndex,CheckPotentialFeasibility);
+	int Status = GlobalAddConstraint(Context,Solver, GetConstraint(InIndex));
+	if (Status == SUCCESS) {
+		MarkConstLoaded(InIndex,CheckPotentialFeasibility);
+	}
+	return Status;
+}
 
-	for (int i=0; i < int(GetConstraint(InIndex)->Variables.size()-1); i++) {
-		for (int j=i+1; j < int(GetConstraint(InIndex)->Variables.size()-1); j++) {
-			if (GetConstraint(InIndex)->Variables[i] == GetConstraint(InIndex)->Variables[j]) {
-				GetConstraint(InIndex)->Variables.erase(GetConstraint(InIndex)->Variables.begin()+j,GetConstraint(InIndex)->Variables.begin()+j+1);
-				GetConstraint(InIndex)->Coefficient[i] += GetConstraint(InIndex)->Coefficient[j];
-				GetConstraint(InIndex)->Coefficient.erase(GetConstraint(InIndex)->Coefficient.begin()+j,GetConstraint(InIndex)->Coefficient.begin()+j+1);
+//Merges repeated variables and sets the loaded state the solver interfaces read while the constraint is being added
+void MFAProblem::PrepareConstForSolver(int InIndex, bool CheckPotentialFeasibility) {
+	LinEquation* CurrentConstraint = GetConstraint(InIndex);
+	CurrentConstraint->Index = InIndex;
+
+	for (int i=0; i < int(CurrentConstraint->Variables.size())-1; i++) {
+		for (int j=i+1; j < int(CurrentConstraint->Variables.size()); j++) {
+			if (CurrentConstraint->Variables[i] == CurrentConstraint->Variables[j]) {
+				CurrentConstraint->Variables.erase(CurrentConstraint->Variables.begin()+j,CurrentConstraint->Variables.begin()+j+1);
+				CurrentConstraint->Coefficient[i] += CurrentConstraint->Coefficient[j];
+				CurrentConstraint->Coefficient.erase(CurrentConstraint->Coefficient.begin()+j,CurrentConstraint->Coefficient.begin()+j+1);
 				j--;
 			}
 		}
 	}
 	
 	// if we are checking the feasibilities of the chemical potential we load in relaxed versions
-	if (GetParameter("Check potential constraints feasibility").compare("1") == 0) {
-		if (GetConstraint(InIndex)->ConstraintMeaning.compare("chemical potential constraint") == 0){
-			if (GetConstraint(InIndex)->Loaded == false) {
-				GetConstraint(InIndex)->LoadedEqualityType = LESS;
-				GetConstraint(InIndex)->LoadedRightHandSide = FLAG;
-				Status = GlobalAddConstraint(Solver, GetConstraint(InIndex));
+	if (CheckPotentialFeasibility) {
+		if (CurrentConstraint->ConstraintMeaning.compare("chemical potential constraint") == 0){
+			if (CurrentConstraint->Loaded == false) {
+				CurrentConstraint->LoadedEqualityType = LESS;
+				CurrentConstraint->LoadedRightHandSide = FLAG;
 			} else {
-				GetConstraint(InIndex)->EqualityType = EQUAL;
-				GetConstraint(InIndex)->LoadedEqualityType = EQUAL;
-				GetConstraint(InIndex)->LoadedRightHandSide = GetConstraint(InIndex)->RightHandSide;
-				Status = GlobalAddConstraint(Solver, GetConstraint(InIndex));
-			}
-		} else {
-			Status = GlobalAddConstraint(Solver, GetConstraint(InIndex));
-			if (Status == SUCCESS) {
-				GetConstraint(InIndex)->Loaded = true;
-				GetConstraint(InIndex)->LoadedEqualityType = GetConstraint(InIndex)->EqualityType;
-				GetConstraint(InIndex)->LoadedRightHandSide = GetConstraint(InIndex)->RightHandSide;
+				CurrentConstraint->EqualityType = EQUAL;
+				CurrentConstraint->LoadedEqualityType = EQUAL;
+				CurrentConstraint->LoadedRightHandSide = CurrentConstraint->RightHandSide;
 			}
 		}
 	} else {
 		// we do not add the potential energy constraints for compounds which we have errors in estimating the deltaGFs
 		// these compounds usually have deltaGF energies indicated at 1e07 and also constraints that we have specified in the list of
 		// user constraints to exclude
-		if ((GetConstraint(InIndex)->ConstraintMeaning.compare("chemical potential constraint") == 0) && (GetConstraint(InIndex)->RightHandSide > 0.9*FLAG)){
-			GetConstraint(InIndex)->Loaded = false;
-			GetConstraint(InIndex)->LoadedEqualityType = LESS;
-			GetConstraint(InIndex)->LoadedRightHandSide = FLAG;
-			Status = GlobalAddConstraint(Solver, GetConstraint(InIndex));
-		} else {
-			Status = GlobalAddConstraint(Solver, GetConstraint(InIndex));
-		}
-		if (Status == SUCCESS) {
-			GetConstraint(InIndex)->Loaded = true;
-			GetConstraint(InIndex)->LoadedEqualityType = GetConstraint(InIndex)->EqualityType;
-			GetConstraint(InIndex)->LoadedRightHandSide = GetConstraint(InIndex)->RightHandSide;
+		if ((CurrentConstraint->ConstraintMeaning.compare("chemical potential constraint") == 0) && (CurrentConstraint->RightHandSide > 0.9*FLAG)){
+			CurrentConstraint->Loaded = false;
+			CurrentConstraint->LoadedEqualityType = LESS;
+			CurrentConstraint->LoadedRightHandSide = FLAG;
 		}
 	}
+}
 
-	return Status;
+void MFAProblem::MarkConstLoaded(int InIndex, bool CheckPotentialFeasibility) {
+	LinEquation* CurrentConstraint = GetConstraint(InIndex);
+	//Relaxed chemical potential constraints keep the loaded state set before they were added
+	if (CheckPotentialFeasibility && CurrentConstraint->ConstraintMeaning.compare("chemical potential constraint") == 0) {
+		return;
+	}
+	CurrentConstraint->Loaded = true;
+	CurrentConstraint->LoadedEqualityType = CurrentConstraint->EqualityType;
+	CurrentConstraint->LoadedRightHandSide = CurrentConstraint->RightHandSide;
 }
 
 int MFAProblem::LoadAllConstToSolver() {
@@ -2278,6 +2348,39 @@ int MFAProblem::LoadAllConstToSolver() {
 	return SUCCESS;
 }
 
+//Assembles every variable and constraint into one sparse matrix and hands it to the solver in a single call
+int MFAProblem::LoadProblemInBulk() {
+	static ParameterHandle* AlwaysRelax = GetParameterHandle("Always relax integer variables");
+	static ParameterHandle* CheckPotential = GetParameterHandle("Check potential constraints feasibility");
+	bool RelaxVariables = RelaxIntegerVariables;
+	if (AlwaysRelax->Bool) {
+		RelaxVariables = true;
+	}
+	bool CheckPotentialFeasibility = CheckPotential->Bool;
+
+	for (int i=0; i < FNumVariables(); i++) {
+		GetVariable(i)->Index = i;
+	}
+	for (int i=0; i < FNumConstraints(); i++) {
+		PrepareConstForSolver(i,CheckPotentialFeasibility);
+	}
+
+	if (GlobalLoadProblem(Context,Solver,Variables,Constraints,RelaxVariables,UseTightBounds) != SUCCESS) {
+		return FAIL;
+	}
+
+	for (int i=0; i < FNumVariables(); i++) {
+		GetVariable(i)->Loaded = true;
+		GetVariable(i)->LoadedLowerBound = GetVariable(i)->LowerBound;
+		GetVariable(i)->LoadedUpperBound = GetVariable(i)->UpperBound;
+	}
+	for (int i=0; i < FNumConstraints(); i++) {
+		MarkConstLoaded(i,CheckPotentialFeasibility);
+		ConstraintIndexMap[GetConstraintName(GetConstraint(i)).data()] = i;
+	}
+	return SUCCESS;
+}
+
 //Analysis functions
 //This function calculates the average total concentration, average ionic strength, average std dev, and average average concentration for a set of solutions 
 map<int , vector<double> , std::less<int> >* MFAProblem::CalcConcMeanIonicStrength() { //Average total, Average ionic strength, Average Std dev, Average average conc
@@ -2381,6 +2484,7 @@ void MFAProblem::ProcessSolution(OptSolutionData* InSolution) {
 
 //This function determines the tight bounds on the variables specified in the "tight bounds search variables" parameter and stores the results in file and in the variable data structure
 int MFAProblem::FindTightBounds(Data* InData,OptimizationParameter*& InParameters, bool SaveSolution, bool UseSpecifiedSearchTypes) {
+	ScopedTimer Timer("FindTightBounds");
 	bool First = true;
 	int Status = SUCCESS;
 
@@ -2412,6 +2516,7 @@ int MFAProblem::FindTightBounds(Data* InData,OptimizationParameter*& InParameter
 	}
 
 	int InitialSolutions = FNumSolutions();
+	vector<int> SearchVariables;
 	for (int i=0; i < FNumVariables(); i++) {
 		if (UseSpecifiedSearchTypes) {
 			for (int j=0; j < int(SearchTypes.size()); j++) {
@@ -2422,39 +2527,52 @@ int MFAProblem::FindTightBounds(Data* InData,OptimizationParameter*& InParameter
 			}
 		}
 		if (GetVariable(i)->Mark) {
-			OptSolutionData* NewSolution;
-			SetMin();
-			ObjFunct->Variables[0] = GetVariable(i);
-			if (First) {
-				if (LoadSolver() != SUCCESS) {
-					return FAIL;	
-				}
-				NewSolution = RunSolver(SaveSolution,false,false);
-				First = false;
-			} else {
-				LoadObjective();
-				NewSolution = RunSolver(SaveSolution,false,false);
-			}
-			if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
-				GetVariable(i)->Min = NewSolution->Objective;
-				if (!SaveSolution) {
-					delete NewSolution;
-				}
-			} else {
-				GetVariable(i)->Min = FLAG;
-			}
+			SearchVariables.push_back(i);
+		}
+	}
 
-			SetMax();
+	//Solved solutions cannot be shared between processes, so the workers are only used when solutions are not saved
+	int NumWorkers = atoi(GetParameter("Tight bounds worker processes").data());
+	if (NumWorkers > 1 && !SaveSolution && GlobalSolverAllowsWorkers(Solver) && int(SearchVariables.size()) > 1) {
+		Status = FindTightBoundsInWorkers(SearchVariables,NumWorkers);
+		SaveTightBounds();
+		return Status;
+	}
+
+	for (int k=0; k < int(SearchVariables.size()); k++) {
+		int i = SearchVariables[k];
+		OptSolutionData* NewSolution;
+		SetMin();
+		ObjFunct->Variables[0] = GetVariable(i);
+		if (First) {
+			if (LoadSolver() != SUCCESS) {
+				return FAIL;	
+			}
+			NewSolution = RunSolver(SaveSolution,false,false);
+			First = false;
+		} else {
 			LoadObjective();
 			NewSolution = RunSolver(SaveSolution,false,false);
-			if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
-				GetVariable(i)->Max = NewSolution->Objective;
-				if (!SaveSolution) {
-					delete NewSolution;
-				}
-			} else {
-				GetVariable(i)->Max = FLAG;
+		}
+		if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
+			GetVariable(i)->Min = NewSolution->Objective;
+			if (!SaveSolution) {
+				delete NewSolution;
+			}
+		} else {
+			GetVariable(i)->Min = FLAG;
+		}
+
+		SetMax();
+		LoadObjective();
+		NewSolution = RunSolver(SaveSolution,false,false);
+		if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
+			GetVariable(i)->Max = NewSolution->Objective;
+			if (!SaveSolution) {
+				delete NewSolution;
 			}
+		} else {
+			GetVariable(i)->Max = FLAG;
 		}
 	}
 	
@@ -2468,12 +2586,102 @@ int MFAProblem::FindTightBounds(Data* InData,OptimizationParameter*& InParameter
 	return Status;
 }
 
+//This function splits the tight bound search across forked worker processes that each solve an interleaved share of the variables on their own copy of the loaded problem
+int MFAProblem::FindTightBoundsInWorkers(vector<int>& SearchVariables, int NumWorkers) {
+	SetMin();
+	ObjFunct->Variables[0] = GetVariable(SearchVariables[0]);
+	if (LoadSolver() != SUCCESS) {
+		return FAIL;
+	}
+
+	vector<int> WorkerPids;
+	vector<int> WorkerPipes;
+	int Worker = ForkWorkerProcesses(NumWorkers,WorkerPids,WorkerPipes);
+	if (Worker >= 0) {
+		ClearSolveSummaries();
+		for (int k=Worker; k < int(SearchVariables.size()); k += NumWorkers) {
+			TightBoundResult Result;
+			Result.Position = k;
+			Result.Min = OptimizeTightBound(GetVariable(SearchVariables[k]),false);
+			Result.Max = OptimizeTightBound(GetVariable(SearchVariables[k]),true);
+			if (!WriteToPipe(WorkerPipes[Worker],&Result,sizeof(TightBoundResult))) {
+				ExitWorkerProcess(WorkerPipes[Worker],1);
+			}
+		}
+		//A negative position tells the parent that this worker's solve statistics follow
+		TightBoundResult Done;
+		Done.Position = -1;
+		Done.Min = 0;
+		Done.Max = 0;
+		if (WriteToPipe(WorkerPipes[Worker],&Done,sizeof(TightBoundResult))) {
+			SendSolveSummaries(WorkerPipes[Worker]);
+		}
+		ExitWorkerProcess(WorkerPipes[Worker],0);
+	}
+
+	//Collecting the bounds from whichever worker has results ready, so no worker stalls on a full pipe
+	vector<bool> Found(SearchVariables.size(),false);
+	int Ready;
+	while ((Ready = NextReadyWorkerPipe(WorkerPipes)) != -1) {
+		TightBoundResult Result;
+		if (!ReadFromPipe(WorkerPipes[Ready],&Result,sizeof(TightBoundResult))) {
+			CloseWorkerPipe(WorkerPipes[Ready]);
+			WorkerPipes[Ready] = -1;
+			continue;
+		}
+		if (Result.Position < 0) {
+			ReceiveSolveSummaries(WorkerPipes[Ready]);
+			CloseWorkerPipe(WorkerPipes[Ready]);
+			WorkerPipes[Ready] = -1;
+			continue;
+		}
+		if (Result.Position < int(SearchVariables.size())) {
+			GetVariable(SearchVariables[Result.Position])->Min = Result.Min;
+			GetVariable(SearchVariables[Result.Position])->Max = Result.Max;
+			Found[Result.Position] = true;
+		}
+	}
+	if (WaitForWorkerProcesses(WorkerPids) > 0) {
+		FErrorFile() << "One or more tight bound worker processes failed. Remaining variables will be solved serially." << endl;
+		FlushErrorFile();
+	}
+
+	//Any variable not reported by a worker is solved here so the results are always complete
+	for (int k=0; k < int(SearchVariables.size()); k++) {
+		if (!Found[k]) {
+			GetVariable(SearchVariables[k])->Min = OptimizeTightBound(GetVariable(SearchVariables[k]),false);
+			GetVariable(SearchVariables[k])->Max = OptimizeTightBound(GetVariable(SearchVariables[k]),true);
+		}
+	}
+	return SUCCESS;
+}
+
+//Minimizes or maximizes a single variable using the tight bound objective already loaded in the solver and returns FLAG when no optimum is found
+double MFAProblem::OptimizeTightBound(MFAVariable* InVariable, bool Maximize) {
+	if (Maximize) {
+		SetMax();
+	} else {
+		SetMin();
+	}
+	ObjFunct->Variables[0] = InVariable;
+	LoadObjective();
+	OptSolutionData* NewSolution = RunSolver(false,false,false);
+	double Result = FLAG;
+	if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
+		Result = NewSolution->Objective;
+	}
+	delete NewSolution;
+	return Result;
+}
+
 int MFAProblem::CalculateFluxSensitivity(Data* InData,vector<MFAVariable*> variables,double objective) {
 	//Checking that the FBA problem has been loaded into the FBA datastructure
 	if (this->FNumVariables() == 0) {
 		cerr << "MFAProblem->CalculateFluxSensitivity(): problem must be initialized before calling CalculateFluxSensitivity()" << endl;
 		return FAIL;
 	}	
+	//The caller has just solved with the objective being perturbed, so its basis is the restart point for every perturbation
+	this->SaveReferenceBasis();
 	//Iterating over all input variables to calculate the shadow price for each variable at its current value
 	double fractionPerturbation = 0.01;
 	vector<double> shadowPrices(variables.size());
@@ -2526,6 +2734,7 @@ int MFAProblem::CalculateFluxSensitivity(Data* InData,vector<MFAVariable*> varia
 			currentVariable->LowerBound = currentVariable->Value + perturbation;
 			//Loading the new bounds into the solver
 			this->LoadVariable(currentVariable->Index);
+			this->RestoreReferenceBasis();
 			//Rerunning the optimization
 			OptSolutionData* newSolution = this->RunSolver(false,false,true);
 			perturbationList[i] = perturbation;
@@ -2594,6 +2803,8 @@ int MFAProblem::CombinatorialKO(int maxDeletions,Data* InData,bool reactions = f
 	}
 	string essentialList;
 	double wildType = newSolution->Objective;
+	SetReferenceSolution(newSolution);
+	SaveReferenceBasis();
 	DataNode* delTree = new DataNode;
 	delTree->data = -1;
 	//Saving growth reduction and KO
@@ -2611,141 +2822,391 @@ int MFAProblem::CombinatorialKO(int maxDeletions,Data* InData,bool reactions = f
 	if (reactions) {
 		numEntities = InData->FNumReactions();
 	}
-	for (int i=0; i < maxDeletions; i++) {
-		//Storing the indecies of the current set of deleted genes
+	int NumWorkers = atoi(GetParameter("Knockout worker processes").data());
+	KnockoutRepresentative.clear();
+	if (!reactions && GetParameter("Group genes by knockout footprint").compare("1") == 0) {
+		GroupGenesByFootprint(InData,KnockoutRepresentative);
+	}
+	for (int i=0; i < maxDeletions && i < numEntities; i++) {
+		//The deletion tree only changes between levels, so every combination in this level can be screened independently
+		map<int,double,std::less<int> > Recorded;
+		if (NumWorkers > 1 && GlobalSolverAllowsWorkers(Solver)) {
+			ScreenKnockoutsInWorkers(InData,delTree,wildType,i+1,numEntities,reactions,NumWorkers,Recorded);
+		} else {
+			ScreenKnockouts(InData,delTree,wildType,i+1,numEntities,reactions,0,1,-1,-1,&Recorded);
+		}
+		//Single knockouts were only simulated for one gene per footprint, so each result is copied to the rest of its group
+		if (i == 0) {
+			for (int j=0; j < int(KnockoutRepresentative.size()); j++) {
+				if (KnockoutRepresentative[j] != j && Recorded.count(KnockoutRepresentative[j]) > 0) {
+					Recorded[j] = Recorded[KnockoutRepresentative[j]];
+				}
+			}
+		}
+		//Recording reduced growth combinations in enumeration order so the output does not depend on the number of workers
 		vector<int> counter(i+1);
 		for (int j=0; j < i+1; j++) {
 			counter[j] = j;
 		}
-		bool complete = false;
-		while (!complete) {
-			//Checking that the current selection involves no lethal combinations
-			double subType = wildType;
-			//Changing the start point
-			for (int j=0; j < int(counter.size());j++) {
-				if (delTree->children.count(counter[j]) > 0) {
-					vector<DataNode*> currNodes(1,delTree->children[counter[j]]);
-					for (int k=j+1; k < int(counter.size());k++) {
-						for (int m=0; m < int(currNodes.size()); m++) {
-							if (currNodes[m]->children.count(counter[k]) > 0) {
-								currNodes.push_back(currNodes[m]->children[counter[k]]);
+		int Position = 0;
+		map<int,double,std::less<int> >::iterator MapIT = Recorded.begin();
+		while (MapIT != Recorded.end()) {
+			if (Position == MapIT->first) {
+				double obj = MapIT->second;
+				DataNode* tempNode = delTree;
+				for (int j=0; j < int(counter.size()); j++) {
+					if (tempNode->children[counter[j]] == NULL) {
+						tempNode->children[counter[j]] = new DataNode;
+						tempNode->children[counter[j]]->data = -1;
+					}
+					tempNode = tempNode->children[counter[j]];
+					if (j > 0) {
+						Output << ",";
+					}
+					if (reactions) {
+						Output << InData->GetReaction(counter[j])->GetData("DATABASE",STRING);
+					} else {
+						if (i == 0 && obj == 0) {
+							if (essentialList.length() > 0) {
+								essentialList.append(";");
 							}
+							essentialList.append(InData->GetGene(counter[j])->GetData("DATABASE",STRING));
+							InData->GetGene(counter[j])->SetData("CLASS","Essential",STRING);
 						}
+						Output << InData->GetGene(counter[j])->GetData("DATABASE",STRING);
 					}
-					for (int k=0; k < int(currNodes.size()); k++) {
-						if (currNodes[k]->data >= 0 && currNodes[k]->data < subType) {
-							subType = currNodes[k]->data;
-						}
-					}
-				}
-				if (subType == 0) {
-					break;
 				}
+				tempNode->data = obj;
+				Output << "\t" << obj << endl;
+				MapIT++;
 			}
-			//Only attempting deletion if the smallest sub-phenotype is still greater than zero
-			if (subType > 0) {
-				//Setting all reaction marks to false
-				for (int j=0; j < InData->FNumReactions(); j++) {
-					InData->GetReaction(j)->SetMark(false);
-				}
-				//Marking reactions to be knocked out in the simulation
-				if (reactions) {
-					for (int j=0; j < i+1; j++) {
-						InData->GetReaction(counter[j])->SetMark(true);
-					}
-				} else {
-					//Setting the specified genes as knocked out
-					for (int j=0; j < i+1; j++) {
-						InData->GetGene(counter[j])->SetMark(true);
-					}
-					//Checking which reactions are knocked out with the genes
-					for (int j=0; j < InData->FNumReactions(); j++) {
-						if (InData->GetReaction(j)->CheckForKO()) {
-							InData->GetReaction(j)->SetMark(true);
-						}
+			if (!NextCombination(counter,numEntities)) {
+				break;
+			}
+			Position++;
+		}
+	}
+	SetParameter("Essential Gene List",essentialList.data());
+	Output.close();
+	SetReferenceSolution(NULL);
+	KnockoutRepresentative.clear();
+	return SUCCESS;
+}
+
+//Returns the lowest growth already recorded in the deletion tree for any subset of the input combination, or the wildtype growth when no subset reduced growth
+double MFAProblem::KnockoutSubPhenotype(DataNode* delTree,vector<int>& counter,double wildType) {
+	double subType = wildType;
+	for (int j=0; j < int(counter.size());j++) {
+		if (delTree->children.count(counter[j]) > 0) {
+			vector<DataNode*> currNodes(1,delTree->children[counter[j]]);
+			for (int k=j+1; k < int(counter.size());k++) {
+				for (int m=0; m < int(currNodes.size()); m++) {
+					if (currNodes[m]->children.count(counter[k]) > 0) {
+						currNodes.push_back(currNodes[m]->children[counter[k]]);
 					}
 				}
-				//Saving the bounds of deleted reactions then setting bounds to zero
-				vector<double> oldMin;
-				vector<double> oldMax;
-				vector<MFAVariable*> entities;
-				for (int j=0; j < this->FNumVariables(); j++) {
-					if (this->GetVariable(j)->Type == FLUX || this->GetVariable(j)->Type == FORWARD_FLUX  || this->GetVariable(j)->Type == REVERSE_FLUX) {
-						if (this->GetVariable(j)->AssociatedReaction != NULL && this->GetVariable(j)->AssociatedReaction->FMark()) {
-							entities.push_back(this->GetVariable(j));
-							oldMin.push_back(this->GetVariable(j)->LowerBound);
-							this->GetVariable(j)->LowerBound = 0;
-							oldMax.push_back(this->GetVariable(j)->UpperBound);
-							this->GetVariable(j)->UpperBound = 0;
-							this->LoadVariable(this->GetVariable(j)->Index);
-						}
-					}
+			}
+			for (int k=0; k < int(currNodes.size()); k++) {
+				if (currNodes[k]->data >= 0 && currNodes[k]->data < subType) {
+					subType = currNodes[k]->data;
 				}
-				//Running optimization
-				OptSolutionData* newSolution = RunSolver(false,false,false);
-				double obj = 0;
-				if (newSolution != NULL && newSolution->Status == SUCCESS && newSolution->Objective > MFA_ZERO_TOLERANCE) {
-					obj = newSolution->Objective;
+			}
+		}
+		if (subType == 0) {
+			break;
+		}
+	}
+	return subType;
+}
+
+//Marks the reactions blocked by the input genes or reactions and collects their flux variables along with the indices of those carrying flux in the reference solution
+void MFAProblem::FindKnockoutVariables(Data* InData,vector<int>& counter,bool reactions,vector<MFAVariable*>& entities,vector<int>& active) {
+	//Setting all reaction marks to false
+	for (int j=0; j < InData->FNumReactions(); j++) {
+		InData->GetReaction(j)->SetMark(false);
+	}
+	//Marking reactions to be knocked out in the simulation
+	if (reactions) {
+		for (int j=0; j < int(counter.size()); j++) {
+			InData->GetReaction(counter[j])->SetMark(true);
+		}
+	} else {
+		//Checking which reactions are knocked out with the specified genes
+		vector<bool> GeneKO(InData->FNumGenes(),false);
+		for (int j=0; j < int(counter.size()); j++) {
+			GeneKO[counter[j]] = true;
+		}
+		vector<bool> ReactionKO;
+		InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+		for (int j=0; j < int(ReactionKO.size()); j++) {
+			if (ReactionKO[j]) {
+				InData->GetReaction(j)->SetMark(true);
+			}
+		}
+	}
+	for (int j=0; j < this->FNumVariables(); j++) {
+		if (this->GetVariable(j)->Type == FLUX || this->GetVariable(j)->Type == FORWARD_FLUX  || this->GetVariable(j)->Type == REVERSE_FLUX) {
+			if (this->GetVariable(j)->AssociatedReaction != NULL && this->GetVariable(j)->AssociatedReaction->FMark()) {
+				entities.push_back(this->GetVariable(j));
+				if (CarriesReferenceFlux(ReferenceSolution,this->GetVariable(j))) {
+					active.push_back(this->GetVariable(j)->Index);
 				}
-				delete newSolution;
-				if ((obj/subType) < 0.95) {
-					DataNode* tempNode = delTree;
-					for (int j=0; j < int(counter.size()); j++) {
-						if (tempNode->children[counter[j]] == NULL) {
-							tempNode->children[counter[j]] = new DataNode;
-							tempNode->children[counter[j]]->data = -1;
-						}
-						tempNode = tempNode->children[counter[j]];
-						if (j > 0) {
-							Output << ",";
-						}
-						if (reactions) {
-							Output << InData->GetReaction(counter[j])->GetData("DATABASE",STRING);
-						} else {
-							if (i == 0 && obj == 0) {
-								if (essentialList.length() > 0) {
-									essentialList.append(";");
-								}
-								essentialList.append(InData->GetGene(counter[j])->GetData("DATABASE",STRING));
-								InData->GetGene(counter[j])->SetData("CLASS","Essential",STRING);
-							}
-							Output << InData->GetGene(counter[j])->GetData("DATABASE",STRING);
-						}
+			}
+		}
+	}
+}
+
+//Knocks out the input genes or reactions, solves from the wildtype basis, restores the original bounds and returns the growth
+//Support receives the variables that are nonzero in the knockout optimum, and is empty when no optimum was found
+double MFAProblem::SimulateKnockout(Data* InData,vector<int>& counter,bool reactions,vector<int>& Support) {
+	vector<MFAVariable*> entities;
+	vector<int> active;
+	FindKnockoutVariables(InData,counter,reactions,entities,active);
+	Support.clear();
+	//Blocking only reactions that are idle in the wildtype optimum leaves that optimum feasible and therefore optimal
+	static ParameterHandle* PruneSilent = GetParameterHandle("Prune silent knockouts");
+	bool Prune = (ReferenceSolution != NULL && PruneSilent->Bool);
+	if (Prune) {
+		if (active.size() == 0) {
+			SolutionSupport(ReferenceSolution,Support);
+			return ReferenceSolution->Objective;
+		}
+		map<vector<int>,KnockoutCacheEntry,std::less<vector<int> > >::iterator MapIT = KnockoutCache.find(active);
+		if (MapIT != KnockoutCache.end() && KnockoutCacheApplies(MapIT->second,entities)) {
+			Support = MapIT->second.Support;
+			return MapIT->second.Objective;
+		}
+	}
+	//Saving the bounds of deleted reactions then setting bounds to zero
+	vector<double> oldMin;
+	vector<double> oldMax;
+	for (int j=0; j < int(entities.size()); j++) {
+		oldMin.push_back(entities[j]->LowerBound);
+		entities[j]->LowerBound = 0;
+		oldMax.push_back(entities[j]->UpperBound);
+		entities[j]->UpperBound = 0;
+		this->LoadVariable(entities[j]->Index);
+	}
+	//Running optimization from the wildtype basis
+	RestoreReferenceBasis();
+	OptSolutionData* newSolution = RunSolver(false,false,false);
+	double obj = 0;
+	if (newSolution != NULL && newSolution->Status == SUCCESS) {
+		SolutionSupport(newSolution,Support);
+		if (newSolution->Objective > MFA_ZERO_TOLERANCE) {
+			obj = newSolution->Objective;
+		}
+	}
+	delete newSolution;
+	//Restoring the original reaction bounds
+	for (int j=0; j < int(entities.size()); j++) {
+		entities[j]->UpperBound = oldMax[j];
+		entities[j]->LowerBound = oldMin[j];
+		this->LoadVariable(entities[j]->Index);
+	}
+	if (Prune && counter.size() == 1) {
+		CacheSingleKnockout(active,entities,obj,Support);
+	}
+	return obj;
+}
+
+//Collects the sorted indices of the variables that are nonzero in the input solution
+void MFAProblem::SolutionSupport(OptSolutionData* InSolution,vector<int>& Support) {
+	Support.clear();
+	for (int i=0; i < int(InSolution->SolutionData.size()); i++) {
+		if (fabs(InSolution->SolutionData[i]) > MFA_ZERO_TOLERANCE) {
+			Support.push_back(i);
+		}
+	}
+}
+
+void MFAProblem::CacheSingleKnockout(vector<int>& active,vector<MFAVariable*>& entities,double Objective,vector<int>& Support) {
+	if (active.size() == 0 || KnockoutCache.count(active) > 0) {
+		return;
+	}
+	KnockoutCacheEntry& Entry = KnockoutCache[active];
+	Entry.Objective = Objective;
+	Entry.Support = Support;
+	for (int i=0; i < int(entities.size()); i++) {
+		Entry.Blocked.push_back(entities[i]->Index);
+	}
+	sort(Entry.Blocked.begin(),Entry.Blocked.end());
+}
+
+//A cached single knockout optimum is the optimum of a knockout that blocks everything the single knockout blocked, which caps the growth,
+//and that blocks nothing carrying flux in the single knockout optimum, which keeps that optimum feasible
+bool MFAProblem::KnockoutCacheApplies(KnockoutCacheEntry& Entry,vector<MFAVariable*>& entities) {
+	vector<int> Blocked;
+	for (int i=0; i < int(entities.size()); i++) {
+		Blocked.push_back(entities[i]->Index);
+	}
+	sort(Blocked.begin(),Blocked.end());
+	if (!includes(Blocked.begin(),Blocked.end(),Entry.Blocked.begin(),Entry.Blocked.end())) {
+		return false;
+	}
+	for (int i=0; i < int(Blocked.size()); i++) {
+		if (binary_search(Entry.Support.begin(),Entry.Support.end(),Blocked[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//Groups genes whose single knockouts disable exactly the same reactions. Representative[i] is set to the first gene with the same footprint as gene i
+void MFAProblem::GroupGenesByFootprint(Data* InData,vector<int>& Representative) {
+	map<vector<int>,int,std::less<vector<int> > > FootprintGenes;
+	Representative.resize(InData->FNumGenes());
+	vector<bool> GeneKO(InData->FNumGenes(),false);
+	vector<bool> ReactionKO;
+	for (int i=0; i < InData->FNumGenes(); i++) {
+		GeneKO[i] = true;
+		InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+		GeneKO[i] = false;
+		vector<int> Footprint;
+		for (int j=0; j < int(ReactionKO.size()); j++) {
+			if (ReactionKO[j]) {
+				Footprint.push_back(j);
+			}
+		}
+		map<vector<int>,int,std::less<vector<int> > >::iterator MapIT = FootprintGenes.find(Footprint);
+		if (MapIT == FootprintGenes.end()) {
+			FootprintGenes[Footprint] = i;
+			Representative[i] = i;
+		} else {
+			Representative[i] = MapIT->second;
+		}
+	}
+}
+
+//Returns false only when the reference solution shows the variable at zero
+bool MFAProblem::CarriesReferenceFlux(OptSolutionData* Reference,MFAVariable* InVariable) {
+	if (Reference == NULL || InVariable->Index < 0 || InVariable->Index >= int(Reference->SolutionData.size())) {
+		return true;
+	}
+	return (fabs(Reference->SolutionData[InVariable->Index]) > MFA_ZERO_TOLERANCE);
+}
+
+//Takes ownership of the optimum that knockouts are compared against and forgets any knockout results derived from the previous one
+void MFAProblem::SetReferenceSolution(OptSolutionData* InSolution) {
+	if (ReferenceSolution != NULL && ReferenceSolution != InSolution) {
+		delete ReferenceSolution;
+	}
+	ReferenceSolution = InSolution;
+	KnockoutCache.clear();
+}
+
+//Simulates every combination of the given size whose enumeration position is Offset modulo Stride and greater than After.
+//Results are written to Pipe when one is given; otherwise combinations that reduce growth below 95% of their sub-phenotype are stored in Recorded
+int MFAProblem::ScreenKnockouts(Data* InData,DataNode* delTree,double wildType,int size,int numEntities,bool reactions,int Offset,int Stride,int After,int Pipe,map<int,double,std::less<int> >* Recorded) {
+	vector<int> counter(size);
+	for (int j=0; j < size; j++) {
+		counter[j] = j;
+	}
+	int Position = 0;
+	do {
+		//Genes that share a knockout footprint with an earlier gene take its single knockout result
+		bool Representative = (size > 1 || Position >= int(KnockoutRepresentative.size()) || KnockoutRepresentative[Position] == Position);
+		if (Position > After && Position % Stride == Offset && Representative) {
+			//Only attempting deletion if the smallest sub-phenotype is still greater than zero
+			double subType = KnockoutSubPhenotype(delTree,counter,wildType);
+			if (subType > 0) {
+				KnockoutResult Result;
+				vector<int> Support;
+				Result.Position = Position;
+				Result.SubType = subType;
+				Result.Objective = SimulateKnockout(InData,counter,reactions,Support);
+				//Only single knockouts are cached, so only their support is needed by the parent
+				Result.SupportSize = 0;
+				if (size == 1) {
+					Result.SupportSize = int(Support.size());
+				}
+				if (Pipe != -1) {
+					if (!WriteToPipe(Pipe,&Result,sizeof(KnockoutResult))) {
+						return FAIL;
 					}
-					tempNode->data = obj;
-					Output << "\t" << obj << endl;
-				}
-				if (!reactions) {
-					//Restoring the specified genes
-					for (int j=0; j < i+1; j++) {
-						InData->GetGene(counter[j])->SetMark(false);
+					if (Result.SupportSize > 0 && !WriteToPipe(Pipe,&Support[0],Result.SupportSize*int(sizeof(int)))) {
+						return FAIL;
 					}
-				}
-				//Restoring the original reaction bounds
-				for (int j=0; j < int(entities.size()); j++) {
-					entities[j]->UpperBound = oldMax[j];
-					entities[j]->LowerBound = oldMin[j];
-					this->LoadVariable(entities[j]->Index);
-				}
-			}
-			//Iterating the counter
-			int index = int(counter.size()-1);
-			while(index >= 0 && (counter[index]+1) >= (numEntities-int(counter.size())+1+index)) {
-				cout << counter[0] << endl;
-				index--;
-			}
-			if (index < 0) {
-				complete = true;
-			} else {
-				counter[index]++;
-				for (int j=index+1;j < int(counter.size()); j++) {
-					counter[j] = counter[j-1]+1;
+				} else if ((Result.Objective/subType) < 0.95) {
+					(*Recorded)[Position] = Result.Objective;
 				}
 			}
 		}
+		Position++;
+	} while (NextCombination(counter,numEntities));
+	return SUCCESS;
+}
+
+//Splits one level of the knockout screen across forked worker processes that each simulate an interleaved share of the combinations on their own copy of the loaded problem
+int MFAProblem::ScreenKnockoutsInWorkers(Data* InData,DataNode* delTree,double wildType,int size,int numEntities,bool reactions,int NumWorkers,map<int,double,std::less<int> >& Recorded) {
+	static ParameterHandle* PruneSilent = GetParameterHandle("Prune silent knockouts");
+	vector<int> WorkerPids;
+	vector<int> WorkerPipes;
+	int Worker = ForkWorkerProcesses(NumWorkers,WorkerPids,WorkerPipes);
+	if (Worker >= 0) {
+		ClearSolveSummaries();
+		if (ScreenKnockouts(InData,delTree,wildType,size,numEntities,reactions,Worker,NumWorkers,-1,WorkerPipes[Worker],NULL) != SUCCESS) {
+			ExitWorkerProcess(WorkerPipes[Worker],1);
+		}
+		//A negative position tells the parent that this worker finished its whole share and that its solve statistics follow
+		KnockoutResult Done;
+		Done.Position = -1;
+		Done.SubType = 0;
+		Done.Objective = 0;
+		Done.SupportSize = 0;
+		if (WriteToPipe(WorkerPipes[Worker],&Done,sizeof(KnockoutResult))) {
+			SendSolveSummaries(WorkerPipes[Worker]);
+		}
+		ExitWorkerProcess(WorkerPipes[Worker],0);
+	}
+
+	//Collecting the knockout results from whichever worker has results ready, so no worker stalls on a full pipe
+	vector<int> LastPosition(NumWorkers,-1);
+	vector<bool> Completed(NumWorkers,false);
+	int Ready;
+	while ((Ready = NextReadyWorkerPipe(WorkerPipes)) != -1) {
+		KnockoutResult Result;
+		if (!ReadFromPipe(WorkerPipes[Ready],&Result,sizeof(KnockoutResult))) {
+			CloseWorkerPipe(WorkerPipes[Ready]);
+			WorkerPipes[Ready] = -1;
+			continue;
+		}
+		if (Result.Position < 0) {
+			Completed[Ready] = true;
+			ReceiveSolveSummaries(WorkerPipes[Ready]);
+			CloseWorkerPipe(WorkerPipes[Ready]);
+			WorkerPipes[Ready] = -1;
+			continue;
+		}
+		vector<int> Support(Result.SupportSize > 0 ? Result.SupportSize : 0);
+		if (Support.size() > 0 && !ReadFromPipe(WorkerPipes[Ready],&Support[0],Result.SupportSize*int(sizeof(int)))) {
+			CloseWorkerPipe(WorkerPipes[Ready]);
+			WorkerPipes[Ready] = -1;
+			continue;
+		}
+		LastPosition[Ready] = Result.Position;
+		//Single knockout results are cached here because the workers' caches are lost when they exit
+		if (size == 1 && ReferenceSolution != NULL && PruneSilent->Bool) {
+			vector<int> counter(1,Result.Position);
+			vector<MFAVariable*> entities;
+			vector<int> active;
+			FindKnockoutVariables(InData,counter,reactions,entities,active);
+			CacheSingleKnockout(active,entities,Result.Objective,Support);
+		}
+		if ((Result.Objective/Result.SubType) < 0.95) {
+			Recorded[Result.Position] = Result.Objective;
+		}
+	}
+	WaitForWorkerProcesses(WorkerPids);
+
+	//Any share a worker did not finish is simulated here, starting after the last combination it reported
+	for (int i=0; i < NumWorkers; i++) {
+		if (!Completed[i]) {
+			FErrorFile() << "Knockout worker process " << i << " failed. Its remaining combinations will be simulated serially." << endl;
+			FlushErrorFile();
+			ScreenKnockouts(InData,delTree,wildType,size,numEntities,reactions,i,NumWorkers,LastPosition[i],-1,&Recorded);
+		}
 	}
-	SetParameter("Essential Gene List",essentialList.data());
-	Output.close();
 	return SUCCESS;
 }
 
@@ -2757,6 +3218,7 @@ int MFAProblem::FindTightBounds(Data* InData,OptimizationParameter*& InParameter
 }
 
 int MFAProblem::RecursiveMILP(Data* InData, OptimizationParameter*& InParameters, vector<int> VariableTypes,bool PrintSolutions) {	
+	ScopedTimer Timer("RecursiveMILP");
 	int Status = SUCCESS;
 
 	//At least one binary variable type must be specified in order to do recursive MILP
@@ -3067,6 +3529,7 @@ vector<OptSolutionData*> MFAProblem::RecursiveMILP(OptimizationParameter* InPara
 	OptSolutionData* NewSolution = NULL;
 	
 	while (1) {
+		ScopedTimer Timer("RecursiveMILP iteration");
 		NewSolution = RunSolver(true,false,true);
 		//Checking if the solution is not viable
 		if (NewSolution == NULL || NewSolution->Status != SUCCESS) {
@@ -3100,14 +3563,14 @@ vector<OptSolutionData*> MFAProblem::RecursiveMILP(OptimizationParameter* InPara
 		//Checking for time out
 		if (TimedOut(ClockIndex)) {
 			FErrorFile() << "Recursive MILP timed out: " << ProblemNote << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_INFO);
 			cout << "Breaking due to time out!!" << endl;
 			break;
 		}
 		//Checking for the solution limit
 		if (InParameters->RecursiveMILPSolutionLimit != -1 && TotalSolutions > InParameters->RecursiveMILPSolutionLimit) {
 			FErrorFile() << "Recursive MILP solution limit hit: " << ProblemNote << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_INFO);
 			cout << "Breaking due to solution limit!!" << endl;
 			break;
 		}
@@ -3116,7 +3579,7 @@ vector<OptSolutionData*> MFAProblem::RecursiveMILP(OptimizationParameter* InPara
 			SolutionSet.pop_back();
 			ClearSolutions(FNumSolutions()-1);
 			FErrorFile() << "Recursive MILP solution interval hit: " << ProblemNote << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_INFO);
 			cout << "Breaking due to solution interval!!" << endl;
 			break;
 		}
@@ -3365,6 +3828,7 @@ int MFAProblem::CheckIndividualMetaboliteProduction(Data* InData, OptimizationPa
 }
 
 int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InParameters) {
+	static int DatabaseKey = Identity::DataKey("DATABASE");
 	SavedBounds* originalBounds = this->saveBounds();
 	//Running expriments
 	vector<string> outputVector;
@@ -3383,13 +3847,13 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 		for (int i=0; i < FNumVariables(); i++) {
 			if ((GetVariable(i)->AssociatedReaction != NULL && GetVariable(i)->Type == FLUX) || (GetVariable(i)->AssociatedSpecies != NULL && GetVariable(i)->Type == DRAIN_FLUX && GetVariable(i)->Compartment == GetCompartment("c")->Index)) {
 				if (GetVariable(i)->AssociatedSpecies != NULL) {
-					compoundsToAssess[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)] = true;
+					compoundsToAssess[GetVariable(i)->AssociatedSpecies->GetData(DatabaseKey,STRING)] = true;
 				}
 				if (fabs(GetVariable(i)->Max) < 1e-7 && fabs(GetVariable(i)->Min) < 1e-7) {
 					if (GetVariable(i)->AssociatedReaction != NULL) {
-						inactiveReactions[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)] = true;
+						inactiveReactions[GetVariable(i)->AssociatedReaction->GetData(DatabaseKey,STRING)] = true;
 					} else {
-						inactiveReactions[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)] = true;
+						inactiveReactions[GetVariable(i)->AssociatedSpecies->GetData(DatabaseKey,STRING)] = true;
 					}
 				}
 			}
@@ -3461,11 +3925,15 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 						}
 					}
 				}
+				vector<bool> GeneKO(InData->FNumGenes(),false);
 				for (int j=0; j < int(KOList.size()); j++) {
 					KOList[j]->SetMark(true);
+					GeneKO[KOList[j]->FIndex()] = true;
 				}
-				for (int j=0; j < InData->FNumReactions(); j++) {
-					if (InData->GetReaction(j)->CheckForKO()) {
+				vector<bool> ReactionKO;
+				InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+				for (int j=0; j < int(ReactionKO.size()); j++) {
+					if (ReactionKO[j]) {
 						KOReactions.push_back(InData->GetReaction(j));
 					}
 				}
@@ -3476,7 +3944,7 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 					} else {
 						KOrxn.append(";");
 					}
-					KOrxn.append(KOReactions[j]->GetData("DATABASE",STRING));
+					KOrxn.append(KOReactions[j]->GetData(DatabaseKey,STRING));
 				}
 				for (int j=0; j < int(KOList.size()); j++) {
 					KOList[j]->SetMark(false);
@@ -3510,9 +3978,9 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 								if (fabs(GetVariable(j)->Max) < 1e-7 && fabs(GetVariable(j)->Min) < 1e-7) {
 									string databaseID;
 									if (GetVariable(j)->AssociatedReaction != NULL) {
-										databaseID = GetVariable(j)->AssociatedReaction->GetData("DATABASE",STRING);
+										databaseID = GetVariable(j)->AssociatedReaction->GetData(DatabaseKey,STRING);
 									} else {
-										databaseID = GetVariable(j)->AssociatedSpecies->GetData("DATABASE",STRING);
+										databaseID = GetVariable(j)->AssociatedSpecies->GetData(DatabaseKey,STRING);
 										if (compoundsToAssess.count(databaseID) == 0) {
 											databaseID = "";
 										}
@@ -3537,7 +4005,20 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 						this->LoadObjective();
 					}
 				} else {
-					NewSolution = RunSolver(false,true,false);
+					//The wildtype optimum stays optimal when every knocked out reaction was idle in it
+					static ParameterHandle* PruneSilent = GetParameterHandle("Prune silent knockouts");
+					bool SilentKO = PruneSilent->Bool;
+					for (int j=0; j < int(KOReactions.size()) && SilentKO; j++) {
+						for (int k=FLUX; k <= REVERSE_FLUX && SilentKO; k++) {
+							MFAVariable* CurrentVariable = KOReactions[j]->GetMFAVar(k);
+							if (CurrentVariable != NULL && CarriesReferenceFlux(NewSolution,CurrentVariable)) {
+								SilentKO = false;
+							}
+						}
+					}
+					if (!SilentKO) {
+						NewSolution = RunSolver(false,true,false);
+					}
 					if (NewSolution != NULL && NewSolution->Status == SUCCESS) {
 						if (NewSolution->Objective/WTgrowth < 0.9) {
 							cout << "Reduced growth" << endl;
@@ -3574,9 +4055,9 @@ int MFAProblem::RunDeletionExperiments(Data* InData,OptimizationParameter* InPar
 										if (fabs(GetVariable(j)->Max) < 1e-7 && fabs(GetVariable(j)->Min) < 1e-7) {
 											string databaseID;
 											if (GetVariable(j)->AssociatedReaction != NULL) {
-												databaseID = GetVariable(j)->AssociatedReaction->GetData("DATABASE",STRING);
+												databaseID = GetVariable(j)->AssociatedReaction->GetData(DatabaseKey,STRING);
 											} else {
-												databaseID = GetVariable(j)->AssociatedSpecies->GetData("DATABASE",STRING);
+												databaseID = GetVariable(j)->AssociatedSpecies->GetData(DatabaseKey,STRING);
 												if (compoundsToAssess.count(databaseID) == 0) {
 													databaseID = "";
 												}
@@ -3826,6 +4307,181 @@ int MFAProblem::RunMediaExperiments(Data* InData, OptimizationParameter* InParam
 	return Status;
 }
 
+//This function runs every job in the batch job file against the one problem built from the model
+//Each job line holds a label, objective, media, KO list, and parameter overrides separated by tabs
+//Bounds are returned to their prestudy values before each job, and only the variables whose bounds differ from what is already in the solver are reloaded
+int MFAProblem::RunBatchJobs(Data* InData, OptimizationParameter* InParameters) {
+	bool OriginalPrint = InParameters->PrintSolutions;
+	bool OriginalClear = InParameters->ClearSolutions;
+	InParameters->PrintSolutions = false;
+	InParameters->ClearSolutions = false;
+
+	int Status = SUCCESS;
+	//First I build the problem from the model if it has not already been built
+	if (FNumVariables() == 0) {
+		if (BuildMFAProblem(InData,InParameters) != SUCCESS) {
+			FErrorFile() << "Failed to build optimization problem." << endl;
+			FlushErrorFile();
+			InParameters->PrintSolutions = OriginalPrint;
+			InParameters->ClearSolutions = OriginalClear;
+			return FAIL;	
+		}
+	}
+
+	ifstream Input;
+	string BatchFilename = GetDatabaseDirectory(true)+GetParameter("Batch job file");
+	if (!OpenInput(Input,BatchFilename)) {
+		InParameters->PrintSolutions = OriginalPrint;
+		InParameters->ClearSolutions = OriginalClear;
+		return FAIL;
+	}
+
+	//Saving the original bounds so they can be restored when the batch is complete
+	SavedBounds* OriginalBounds = saveBounds();
+	//If the user requests it, all drain fluxes are cleared to the default values
+	if (GetParameter("Clear all drain flux bounds before performing media study").compare("1") == 0) {
+		this->clearOldMedia(InParameters);
+	}
+	//Saving the cleared bounds so they can be restored at the start of each job
+	SavedBounds* PrestudyBounds = saveBounds();
+
+	//Now I load the solver once and only once; each job then only pushes its bound changes
+	LoadSolver();
+
+	ofstream BatchOutput;
+	OpenOutput(BatchOutput,FOutputFilepath()+"BatchJobResults.txt");
+	BatchOutput << "Label\tObjective\tMedia\tKO\tParameters\tStatus\tObjective value\tFluxes" << endl;
+	//Skipping the header line
+	GetFileLine(Input);
+	do {
+		string Line = GetFileLine(Input);
+		if (Line.length() == 0) {
+			continue;
+		}
+		vector<string>* Fields = StringToStrings(Line,"\t",false);
+		while (Fields->size() < 5) {
+			Fields->push_back("none");
+		}
+		string Label = (*Fields)[0];
+		string Objective = (*Fields)[1];
+		string Media = (*Fields)[2];
+		string KO = (*Fields)[3];
+		string Overrides = (*Fields)[4];
+		delete Fields;
+		if (ConvertToLower(Objective).compare("none") == 0) {
+			Objective = GetParameter("objective");
+		}
+
+		//Applying the parameter overrides and saving the prior values so they can be restored after the job
+		vector<string> OverrideNames;
+		vector<string> OverrideValues;
+		if (ConvertToLower(Overrides).compare("none") != 0) {
+			vector<string>* Pairs = StringToStrings(Overrides,"|");
+			for (int i=0; i < int(Pairs->size()); i++) {
+				string::size_type Split = (*Pairs)[i].find("=");
+				if (Split == string::npos) {
+					FErrorFile() << "Batch job " << Label << ": could not parse parameter override " << (*Pairs)[i] << endl;
+					FlushErrorFile(SEVERITY_WARNING);
+					continue;
+				}
+				string Name = (*Pairs)[i].substr(0,Split);
+				OverrideNames.push_back(Name);
+				OverrideValues.push_back(GetParameter(Name.data()));
+				SetParameter(Name.data(),(*Pairs)[i].substr(Split+1).data());
+			}
+			delete Pairs;
+		}
+
+		//Returning all variables to their prestudy bounds; nothing is sent to the solver yet
+		loadBounds(PrestudyBounds,false);
+
+		//Applying the job media
+		string JobStatus("SUCCESS");
+		if (ConvertToLower(Media).compare("none") != 0) {
+			if (loadMedia(Media,InData,false) != SUCCESS) {
+				JobStatus = "Media not found";
+			}
+		}
+
+		//Knocking out the listed genes and reactions
+		if (ConvertToLower(KO).compare("none") != 0) {
+			vector<string>* KOList = StringToStrings(KO,",;");
+			vector<bool> GeneKO(InData->FNumGenes(),false);
+			bool GenesKnockedOut = false;
+			for (int i=0; i < int(KOList->size()); i++) {
+				Gene* CurrentGene = InData->FindGene("DATABASE",(*KOList)[i].data());
+				if (CurrentGene != NULL) {
+					GeneKO[CurrentGene->FIndex()] = true;
+					GenesKnockedOut = true;
+					continue;
+				}
+				Reaction* CurrentReaction = InData->FindReaction("DATABASE",(*KOList)[i].data());
+				if (CurrentReaction != NULL) {
+					CurrentReaction->ResetFluxBounds(0,0,NULL);
+				} else {
+					FErrorFile() << "Batch job " << Label << ": knockout " << (*KOList)[i] << " not found in model." << endl;
+					FlushErrorFile(SEVERITY_WARNING);
+				}
+			}
+			delete KOList;
+			if (GenesKnockedOut) {
+				vector<bool> ReactionKO;
+				InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+				for (int i=0; i < int(ReactionKO.size()); i++) {
+					if (ReactionKO[i]) {
+						InData->GetReaction(i)->ResetFluxBounds(0,0,NULL);
+					}
+				}
+			}
+		}
+
+		double ObjectiveValue = 0;
+		string Fluxes("none");
+		if (JobStatus.compare("SUCCESS") == 0) {
+			//Pushing only the bounds that differ from the loaded bounds to the solver
+			if (FProblemLoaded()) {
+				Status = UpdateLoadSolver();
+			} else {
+				Status = LoadSolver();
+			}
+			string Note("Batch job: ");
+			Note.append(Label);
+			if (Status == SUCCESS) {
+				Status = OptimizeSingleObjective(InData,InParameters,Objective,false,false,ObjectiveValue,Note);
+			}
+			if (Status != SUCCESS) {
+				JobStatus = "FAILED";
+			} else {
+				Fluxes = fluxToString();
+			}
+		}
+		BatchOutput << Label << "\t" << Objective << "\t" << Media << "\t" << KO << "\t" << Overrides << "\t" << JobStatus << "\t" << ObjectiveValue << "\t" << Fluxes << endl;
+
+		//Restoring the parameters changed by this job
+		for (int i=int(OverrideNames.size())-1; i >= 0; i--) {
+			SetParameter(OverrideNames[i].data(),OverrideValues[i].data());
+		}
+	} while(!Input.eof());
+	BatchOutput.close();
+	Input.close();
+
+	//Restoring the original bounds and reloading all altered variables to the solver
+	loadBounds(OriginalBounds,FProblemLoaded());
+	delete OriginalBounds;
+	delete PrestudyBounds;
+
+	if (OriginalPrint) {
+		PrintSolutions(-1,-1);
+	}
+	if (OriginalClear) {
+		ClearSolutions();
+	}
+	InParameters->PrintSolutions = OriginalPrint;
+	InParameters->ClearSolutions = OriginalClear;
+
+	return SUCCESS;
+}
+
 //This function determines the minimal additions to the media that must be made in order for growth to occur
 int MFAProblem::DetermineMinimalFeasibleMedia(Data* InData,OptimizationParameter* InParameters) {		
 	//Saving the old objective
@@ -4590,7 +5246,7 @@ int MFAProblem::CheckPotentialConstraints(Data* InData, OptimizationParameter* I
 			string ConstraintName = GetConstraintName(GetConstraint(i));
 
 			FErrorFile() << ConstraintName << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_DEBUG);
 
 			if (GetParameter("Check potential constraints feasibility").compare("1") == 0) {
 				if ((GetConstraint(i)->ConstraintMeaning.compare("chemical potential constraint") == 0) && (GetConstraint(i)->RightHandSide < 0.9*FLAG)) {
@@ -5014,7 +5670,7 @@ int MFAProblem::FluxCouplingAnalysis(Data* InData, OptimizationParameter* InPara
 				}
 			} else {
 				FErrorFile() << "Model infeasible for " << VariableFluxes[i]->AssociatedReaction->GetData("DATABASE",STRING) << " KO" << endl;
-				FlushErrorFile();
+				FlushErrorFile(SEVERITY_INFO);
 			}
 
 			if (OriginalMax[i] > MFA_ZERO_TOLERANCE) {
@@ -5202,7 +5858,7 @@ int MFAProblem::FluxCouplingAnalysis(Data* InData, OptimizationParameter* InPara
 					}
 				} else {
 					FErrorFile() << "Model infeasible for " << VariableFluxes[i]->AssociatedReaction->GetData("DATABASE",STRING) << " MAX " << OriginalMax[i] << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_INFO);
 				}
 			}
 
@@ -5391,7 +6047,7 @@ int MFAProblem::FluxCouplingAnalysis(Data* InData, OptimizationParameter* InPara
 					}
 				} else {
 					FErrorFile() << "Model infeasible for " << VariableFluxes[i]->AssociatedReaction->GetData("DATABASE",STRING) << " MIN " << OriginalMin[i] << endl;
-					FlushErrorFile();
+					FlushErrorFile(SEVERITY_INFO);
 				}
 			}
 
@@ -6045,6 +6701,7 @@ int MFAProblem::LoadGapFillingReactions(Data* InData, OptimizationParameter* InP
 		if (verbose()) {
 			cout << "Loading GapFillingReactions\n";
 		}
+		InData->OpenReactionCache();
 		for (int i=0; i < rxntbl->number_of_objects();i++) {
 			StringDBObject* rxnobj = rxntbl->get_object(i);
 			string RxnId = rxnobj->get("id");
@@ -6069,9 +6726,26 @@ int MFAProblem::LoadGapFillingReactions(Data* InData, OptimizationParameter* InP
 			  AddReaction = false;
 			}
 
+			//Reactions the cache knows are rejected are never built
+			ReactionCacheEntry* Cached = NULL;
+			if (AddReaction) {
+				Cached = InData->FindCachedReaction(RxnId);
+				if (Cached != NULL && Cached->Status != REACTION_CACHE_ACCEPTED) {
+					InData->ReplayCachedReaction(Cached);
+					AddReaction = false;
+				}
+			}
+
 			if(AddReaction){
 
 			        Reaction* NewReaction = new Reaction(RxnId,InData);
+				if (Cached != NULL && InData->RestoreCachedBalance(NewReaction,Cached)) {
+					NewReaction->AddData("FOREIGN","Reaction",STRING);
+					InData->RestoreCachedDirectionality(NewReaction,Cached);
+					InData->AddReaction(NewReaction);
+					continue;
+				}
+				InData->CacheReactionInput(RxnId,NewReaction);
 				
 				//Checking that only approved compartments are involved in the reaction
 				bool ContainsDissapprovedCompartments = false;
@@ -6085,31 +6759,38 @@ int MFAProblem::LoadGapFillingReactions(Data* InData, OptimizationParameter* InP
 					}
 				}
 				
-				if (!ContainsDissapprovedCompartments) {
+				if (ContainsDissapprovedCompartments) {
+					InData->CacheReaction(RxnId,NewReaction,REACTION_CACHE_DISAPPROVED_COMPARTMENT);
+				} else {
 					//Checking if the reaction is balanced
 					if (!NewReaction->BalanceReaction(false,false)) {
 						NewReaction->AddData("UNBALANCED","YES",STRING);
 					}
+					int CacheStatus = REACTION_CACHE_UNBALANCED;
 					if (GetParameter("Balanced reactions in gap filling only").compare("0") == 0 || NewReaction->GetData("UNBALANCED",STRING).length() == 0) {
 						NewReaction->AddData("FOREIGN","Reaction",STRING);
 						NewReaction->SetType(NewReaction->CalculateDirectionalityFromThermo());
 						InData->AddReaction(NewReaction);
+						CacheStatus = REACTION_CACHE_ACCEPTED;
 					} else {
 						for (int j=0; j < int(AllowedUnbalancedReactions->size()); j++) {
 							if (NewReaction->GetData("DATABASE",STRING).compare((*AllowedUnbalancedReactions)[j]) == 0) {
 								NewReaction->AddData("FOREIGN","Reaction",STRING);
 								NewReaction->SetType(NewReaction->CalculateDirectionalityFromThermo());
 								InData->AddReaction(NewReaction);
+								CacheStatus = REACTION_CACHE_ACCEPTED;
 								break;
 							}
 						}
 					}
+					InData->CacheReaction(RxnId,NewReaction,CacheStatus);
 				}
 				if (InData->FindReaction("DATABASE",NewReaction->GetData("DATABASE",STRING).data()) == NULL) {
 					delete NewReaction;
 				}
 			}
 		}
+		InData->SaveReactionCache();
 		delete AllowedUnbalancedReactions;
 		if (DissapprovedCompartments != NULL) {
 			delete DissapprovedCompartments;
@@ -6798,9 +7479,13 @@ int MFAProblem::GapFilling(Data* InData, OptimizationParameter* InParameters,str
 		return FAIL;
 	}
 	
+	//The growth check is always solved directly, so it neither writes an LP job nor consumes a solver output file
 	string originalParam = GetParameter("print lp files rather than solve");
+	string originalOutputParam = GetParameter("use solver output files");
 	SetParameter("print lp files rather than solve","0");
+	SetParameter("use solver output files","0");
 	NewSolution = RunSolver(true,true,true);
+	SetParameter("use solver output files",originalOutputParam.data());
 	if (NewSolution == NULL) {
 		Note.append("Problem failed to return a solution");
 		PrintProblemReport(FLAG,InParameters,Note);
@@ -7077,14 +7762,18 @@ int MFAProblem::GapGeneration(Data* InData, OptimizationParameter* InParameters)
 		for (int i=0; i < InData->FNumGenes(); i++) {
 			InData->GetGene(i)->SetMark(false);
 		}
+		vector<bool> GeneKO(InData->FNumGenes(),false);
 		for (int i=0; i < int(Strings->size()); i++) {
 			Gene* Temp = InData->FindGene("DATABASE",(*Strings)[i].data());
 			if (Temp != NULL) {
 				Temp->SetMark(true);
+				GeneKO[Temp->FIndex()] = true;
 			}
 		}
-		for (int j=0; j < InData->FNumReactions(); j++) {
-			if (InData->GetReaction(j)->CheckForKO()) {
+		vector<bool> ReactionKO;
+		InData->FindKnockedOutReactions(GeneKO,ReactionKO);
+		for (int j=0; j < int(ReactionKO.size()); j++) {
+			if (ReactionKO[j]) {
 				gapgenRxn.push_back(InData->GetReaction(j)->GetData("DATABASE",STRING));
 			}
 		}
@@ -8595,7 +9284,7 @@ void MFAProblem::AddVariableToRegulationConstraint(LinEquation* InEquation,doubl
 			Value = int(InParameters->Conditions[VariableArg]);
 		} else {
 			FErrorFile() << VariableArg << " condition not provided in " << GetParameter("Gene dictionary") << " file." << endl;
-			FlushErrorFile();
+			FlushErrorFile(SEVERITY_WARNING);
 			Value = 0;
 		}
 	} else {
@@ -8670,6 +9359,7 @@ void MFAProblem::AddVariableToRegulationConstraint(LinEquation* InEquation,doubl
 
 //File IO Functions
 void MFAProblem::PrintProblemReport(double SingleObjective,OptimizationParameter* InParameters, string InNote) {
+	ScopedTimer Timer("PrintProblemReport");
 	ofstream Output;
 	string Filename(FOutputFilepath());
 	Filename.append(GetParameter("MFA problem report filename"));
@@ -8987,6 +9677,8 @@ void MFAProblem::SaveTightBounds() {
 }
 
 void MFAProblem::PrintSolutions(int StartIndex, int EndIndex,bool tightbounds) {
+	ScopedTimer Timer("PrintSolutions");
+	static int DatabaseKey = Identity::DataKey("DATABASE");
 	string FilenameSuffix;
 	if (tightbounds) {
 		FilenameSuffix.assign("TB");
@@ -9049,20 +9741,23 @@ void MFAProblem::PrintSolutions(int StartIndex, int EndIndex,bool tightbounds) {
 		} else {
 			Output << "none;" <<  GetVariable(i)->UpperBound << ";" << GetVariable(i)->LowerBound << ";";
 		}
+		const string* VarID = NULL;
 		if (GetVariable(i)->AssociatedReaction != NULL) {
-			if (reactionIndecies.count(GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)+comp) == 0) {
+			VarID = &(GetVariable(i)->AssociatedReaction->GetData(DatabaseKey,STRING));
+			if (reactionIndecies.count(*VarID+comp) == 0) {
 				reactions.push_back(GetVariable(i)->AssociatedReaction);
-				reactionIndecies[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)+comp] = reactionCount;
+				reactionIndecies[*VarID+comp] = reactionCount;
 				reactionCount++;
 			}
-			Output << GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING);
+			Output << *VarID;
 		} else if (GetVariable(i)->AssociatedSpecies != NULL) {
-			if (compoundIndecies.count(GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)+comp) == 0) {
+			VarID = &(GetVariable(i)->AssociatedSpecies->GetData(DatabaseKey,STRING));
+			if (compoundIndecies.count(*VarID+comp) == 0) {
 				compounds.push_back(GetVariable(i)->AssociatedSpecies);
-				compoundIndecies[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)+comp] = compoundCount;
+				compoundIndecies[*VarID+comp] = compoundCount;
 				compoundCount++;
 			}
-			Output << GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING);
+			Output << *VarID;
 		}
 		int index = -1;
 		int compIndex = compartmentIndecies[comp];
@@ -9103,20 +9798,20 @@ void MFAProblem::PrintSolutions(int StartIndex, int EndIndex,bool tightbounds) {
 						if (int(rxnVarTypePresence[j].size()) == 0) {
 							rxnVarTypePresence[j].resize(4);
 						}
-						if (int(rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j].size()) == 0) {
-							rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j].resize(4);
+						if (int(rxnVars[*VarID][j].size()) == 0) {
+							rxnVars[*VarID][j].resize(4);
 						}
 						if (int(rxnVarTypePresence[j][index].size()) <= compartmentIndecies[comp]) {
 							rxnVarTypePresence[j][index].resize(compartments.size(),false);
 						}
-						if (int(rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j][index].size()) <= compartmentIndecies[comp]) {
-							rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j][index].resize(compartments.size(),FLAG);
+						if (int(rxnVars[*VarID][j][index].size()) <= compartmentIndecies[comp]) {
+							rxnVars[*VarID][j][index].resize(compartments.size(),FLAG);
 						}
 						if (i < int(GetSolution(j)->SolutionData.size())) {
-							if (rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] == FLAG) {
-								rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] = sign*GetSolution(j)->SolutionData[i];
+							if (rxnVars[*VarID][j][index][compartmentIndecies[comp]] == FLAG) {
+								rxnVars[*VarID][j][index][compartmentIndecies[comp]] = sign*GetSolution(j)->SolutionData[i];
 							} else {
-								rxnVars[GetVariable(i)->AssociatedReaction->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] += sign*GetSolution(j)->SolutionData[i];
+								rxnVars[*VarID][j][index][compartmentIndecies[comp]] += sign*GetSolution(j)->SolutionData[i];
 							}
 						}
 						rxnVarTypePresence[j][index][compartmentIndecies[comp]] = true;
@@ -9127,19 +9822,19 @@ void MFAProblem::PrintSolutions(int StartIndex, int EndIndex,bool tightbounds) {
 						if (int(cpdVarTypePresence[j][index].size()) <= compartmentIndecies[comp]) {
 							cpdVarTypePresence[j][index].resize(compartments.size(),false);
 						}
-						if (int(cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j].size()) == 0) {
-							cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j].resize(4);
+						if (int(cpdVars[*VarID][j].size()) == 0) {
+							cpdVars[*VarID][j].resize(4);
 						}
-						if (int(cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index].size()) <= compartmentIndecies[comp]) {
-							cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index].resize(compartments.size(),FLAG);
+						if (int(cpdVars[*VarID][j][index].size()) <= compartmentIndecies[comp]) {
+							cpdVars[*VarID][j][index].resize(compartments.size(),FLAG);
 						}
 						if (i < int(GetSolution(j)->SolutionData.size())) {
 							if (GetVariable(i)->Type == LOG_CONC) {
-								cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] = exp(GetSolution(j)->SolutionData[i]);
-							} else if (cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] == FLAG) {
-								cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] = sign*GetSolution(j)->SolutionData[i];
+								cpdVars[*VarID][j][index][compartmentIndecies[comp]] = exp(GetSolution(j)->SolutionData[i]);
+							} else if (cpdVars[*VarID][j][index][compartmentIndecies[comp]] == FLAG) {
+								cpdVars[*VarID][j][index][compartmentIndecies[comp]] = sign*GetSolution(j)->SolutionData[i];
 							} else {
-								cpdVars[GetVariable(i)->AssociatedSpecies->GetData("DATABASE",STRING)][j][index][compartmentIndecies[comp]] += sign*GetSolution(j)->SolutionData[i];
+								cpdVars[*VarID][j][index][compartmentIndecies[comp]] += sign*GetSolution(j)->SolutionData[i];
 							}
 						}
 						cpdVarTypePresence[j][index][compartmentIndecies[comp]] = true;
@@ -9394,6 +10089,6 @@ void MFAProblem::PrintVariableKey() {
 void MFAProblem::WriteLPFile() {
 	PrintVariableKey();
 	if (GetParameter("write LP file").compare("1") == 0) {
-		GlobalWriteLPFile(Solver);
+		GlobalWriteLPFile(Context,Solver);
 	}
 }
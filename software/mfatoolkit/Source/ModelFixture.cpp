@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+//    MFAToolkit: Software for running flux balance analysis on stoichiometric models
+//    Software developer: Christopher Henry (chenry@mcs.anl.gov), MCS Division, Argonne National Laboratory
+//    Copyright (C) 2007  Argonne National Laboratory/University of Chicago. All Rights Reserved.
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//    For more information on MFAToolkit, see <http://bionet.mcs.anl.gov/index.php/Model_analysis>.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MFAToolkit.h"
+#include "ModelFixture.h"
+
+bool WriteFixtureTable(string Filename, string Header, vector<string>& Lines) {
+	ofstream Output;
+	if (!OpenOutput(Output,Filename)) {
+		return false;
+	}
+	Output << Header << endl;
+	for (int i=0; i < int(Lines.size()); i++) {
+		Output << Lines[i] << endl;
+	}
+	Output.close();
+	return true;
+}
+
+string WriteModelFixture(string Directory, ModelFixture& Fixture) {
+	vector<string> Media(1,Fixture.Media);
+	if (!WriteFixtureTable(Directory+"compounds.tbl","id\tname\tabbrev\tformula\tcharge\tdeltaG\tdeltaGErr\tmass",Fixture.Compounds) ||
+		!WriteFixtureTable(Directory+"reactions.tbl","id\tname\tequation\tdeltaG\tdeltaGErr",Fixture.Reactions) ||
+		!WriteFixtureTable(Directory+"Model.tbl","REACTIONS\nLOAD;DIRECTIONALITY;COMPARTMENT;ASSOCIATED PEG",Fixture.ModelReactions) ||
+		!WriteFixtureTable(Directory+"media.tbl","ID\tNAMES\tVARIABLES\tTYPES\tMAX\tMIN\tCOMPARTMENTS",Media)) {
+		return "";
+	}
+
+	vector<string> Tables;
+	Tables.push_back("compound\tid\tSINGLEFILE\t"+Directory+"\t"+Directory+"compounds.tbl\tTAB\tSC\tid");
+	Tables.push_back("reaction\tid\tSINGLEFILE\t"+Directory+"\t"+Directory+"reactions.tbl\tTAB\t|\tid");
+	Tables.push_back("media\tID\tSINGLEFILE\t"+Directory+"\t"+Directory+"media.tbl\tTAB\t|\tID;NAMES");
+	if (!WriteFixtureTable(Directory+"StringDBFile.txt","Name\tID attribute\tType\tPath\tFilename\tDelimiter\tItem delimiter\tIndexed columns",Tables)) {
+		return "";
+	}
+
+	//The database location parameters come first so a fixture can override anything after them
+	ofstream Output;
+	if (!OpenOutput(Output,Directory+Fixture.ParameterFile)) {
+		return "";
+	}
+	Output << "database spec file|" << Directory << "StringDBFile.txt|" << Fixture.ParameterGroup << endl;
+	Output << "database root input directory|" << Directory << "|" << Fixture.ParameterGroup << endl;
+	Output << "use database fields|1|" << Fixture.ParameterGroup << endl;
+	Output << "MFASolver|GLPK|" << Fixture.ParameterGroup << endl;
+	for (int i=0; i < int(Fixture.Parameters.size()); i++) {
+		Output << Fixture.Parameters[i].first << "|" << Fixture.Parameters[i].second << "|" << Fixture.ParameterGroup << endl;
+	}
+	Output.close();
+
+	return Directory+"Model.tbl";
+}
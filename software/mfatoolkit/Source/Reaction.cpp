@@ -419,6 +419,7 @@ int Reaction::ReadFromFileline(vector<string>* InHeaders, string Fileline) {
 int Reaction::AddGene(Gene* InGene, int ComplexIndex) {
 	//Adding the reactions to the gene in case the gene is not being loaded from file
 	InGene->AddReaction(this);
+	MainData->GeneLogicChanged();
 
 	//Checking to see if this gene has already been assigned to this reaction
 	if (GeneIndecies.count(InGene) > 0) {
@@ -595,6 +596,7 @@ int Reaction::ParseGeneString(string InGeneString) {
 			}
 		}
 	}
+	MainData->GeneLogicChanged();
 	//Deleting vector
 	delete Strings;
 	return SUCCESS;
@@ -1620,35 +1622,13 @@ int Reaction::FNumGeneGroups() {
 }
 
 bool Reaction::CheckForKO(GeneLogicNode* InNode) {
-	if (GetParameter("new gene handling").compare("1") == 0) {
-		if (InNode == NULL && GeneRootNode != NULL) {
-			return CheckForKO(GeneRootNode);
-		} else if (InNode != NULL) {
-			if (InNode->Logic == OR) {
-				for (int i=0; i < int(InNode->Genes.size()); i++) {
-					if (InNode->Genes[i] != NULL && !InNode->Genes[i]->FMark()) {
-						return false;
-					}
-				}
-				for (int i=0; i < int(InNode->LogicNodes.size()); i++) {
-					if (InNode->LogicNodes[i] != NULL && !CheckForKO(InNode->LogicNodes[i])) {
-						return false;
-					}
-				}
-				return true;
-			} else {
-				for (int i=0; i < int(InNode->Genes.size()); i++) {
-					if (InNode->Genes[i] != NULL && InNode->Genes[i]->FMark()) {
-						return true;
-					}
-				}
-				for (int i=0; i < int(InNode->LogicNodes.size()); i++) {
-					if (InNode->LogicNodes[i] != NULL && CheckForKO(InNode->LogicNodes[i])) {
-						return true;
-					}
-				}
-				return false;
-			}
+	if (InNode != NULL) {
+		return CheckLogicNodeForKO(InNode);
+	}
+	static ParameterHandle* NewGeneHandling = GetParameterHandle("new gene handling");
+	if (NewGeneHandling->Bool) {
+		if (GeneRootNode != NULL) {
+			return CheckLogicNodeForKO(GeneRootNode);
 		}
 		return false;
 	} else {
@@ -1673,6 +1653,79 @@ bool Reaction::CheckForKO(GeneLogicNode* InNode) {
 	return false;
 }
 
+bool Reaction::CheckLogicNodeForKO(GeneLogicNode* InNode) {
+	if (InNode->Logic == OR) {
+		for (int i=0; i < int(InNode->Genes.size()); i++) {
+			if (InNode->Genes[i] != NULL && !InNode->Genes[i]->FMark()) {
+				return false;
+			}
+		}
+		for (int i=0; i < int(InNode->LogicNodes.size()); i++) {
+			if (InNode->LogicNodes[i] != NULL && !CheckLogicNodeForKO(InNode->LogicNodes[i])) {
+				return false;
+			}
+		}
+		return true;
+	} else {
+		for (int i=0; i < int(InNode->Genes.size()); i++) {
+			if (InNode->Genes[i] != NULL && InNode->Genes[i]->FMark()) {
+				return true;
+			}
+		}
+		for (int i=0; i < int(InNode->LogicNodes.size()); i++) {
+			if (InNode->LogicNodes[i] != NULL && CheckLogicNodeForKO(InNode->LogicNodes[i])) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+//Appends the gene logic of this reaction to a postfix program of (instruction, argument) pairs over gene indices. An empty program means the reaction cannot be knocked out
+void Reaction::CompileGeneLogic(bool NewGeneHandling, vector<int>& Program) {
+	if (NewGeneHandling) {
+		if (GeneRootNode != NULL) {
+			CompileLogicNode(GeneRootNode,Program);
+		}
+	} else if (GeneDependency.size() > 0) {
+		//Each complex is lost when any of its genes is lost, and the reaction is lost when every complex is lost
+		for (int i=0; i < int(GeneDependency.size()); i++) {
+			for (int j=0; j < int(GeneDependency[i].size()); j++) {
+				Program.push_back(GPR_GENE);
+				Program.push_back(GeneDependency[i][j]->FIndex());
+			}
+			Program.push_back(GPR_ANY_KO);
+			Program.push_back(int(GeneDependency[i].size()));
+		}
+		Program.push_back(GPR_ALL_KO);
+		Program.push_back(int(GeneDependency.size()));
+	}
+}
+
+void Reaction::CompileLogicNode(GeneLogicNode* InNode, vector<int>& Program) {
+	int Operands = 0;
+	for (int i=0; i < int(InNode->Genes.size()); i++) {
+		if (InNode->Genes[i] != NULL) {
+			Program.push_back(GPR_GENE);
+			Program.push_back(InNode->Genes[i]->FIndex());
+			Operands++;
+		}
+	}
+	for (int i=0; i < int(InNode->LogicNodes.size()); i++) {
+		if (InNode->LogicNodes[i] != NULL) {
+			CompileLogicNode(InNode->LogicNodes[i],Program);
+			Operands++;
+		}
+	}
+	//An OR node is lost only when all of its members are lost, while an AND node is lost with any member
+	if (InNode->Logic == OR) {
+		Program.push_back(GPR_ALL_KO);
+	} else {
+		Program.push_back(GPR_ANY_KO);
+	}
+	Program.push_back(Operands);
+}
+
 bool Reaction::AllReactantsMarked() {
 	for (int i=0; i < FNumReactants(REACTANT); i++) {
 		if (!GetReactant(i)->FMark()) {
@@ -1857,6 +1910,7 @@ int Reaction::Interpreter(string DataName, string& DataItem, bool Input) {
 							delete StringsTwo;
 							GeneDependency.push_back(TempArray);
 						}
+						MainData->GeneLogicChanged();
 					}
 					delete Strings;
 				}
@@ -2553,6 +2607,7 @@ void Reaction::FormGeneComplexesFromNeighbors() {
 	}
 
 	if (OriginalGeneCount > int(GeneDependency.size())) {
+		MainData->GeneLogicChanged();
 		SetMark(true);
 		FLogFile() << GetData("DATABASE",STRING) << " reaction genes combined from " << OriginalGeneCount << " to " << GeneDependency.size() << endl;
 	}
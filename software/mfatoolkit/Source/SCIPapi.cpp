@@ -24,23 +24,28 @@ int InitializeSCIPVariables() {
 	return SUCCESS;
 }
 
-int SCIPInitialize() {
-	return GLPKInitialize();
+//Every solve runs the SCIP executable on Problem.lp, ScipSettings.txt and ScipOutput.out in the output folder
+bool SCIPSolvesInProcess() {
+	return false;
 }
 
-int SCIPCleanup() {
-	return GLPKCleanup();
+int SCIPInitialize(SolverContext* Context) {
+	return GLPKInitialize(Context);
 }
 
-int SCIPClearSolver() {
-	return GLPKClearSolver();
+int SCIPCleanup(SolverContext* Context) {
+	return GLPKCleanup(Context);
 }
 
-int SCIPPrintFromSolver() {
-	return GLPKPrintFromSolver();
+int SCIPClearSolver(SolverContext* Context) {
+	return GLPKClearSolver(Context);
 }
 
-OptSolutionData* SCIPRunSolver(int ProbType) {
+int SCIPPrintFromSolver(SolverContext* Context) {
+	return GLPKPrintFromSolver(Context);
+}
+
+OptSolutionData* SCIPRunSolver(SolverContext* Context, int ProbType) {
 	//Printing setting file with scip timelimit
 	ofstream Output;
 	if (!OpenOutput(Output,FOutputFilepath()+"ScipSettings.txt")) {
@@ -51,28 +56,40 @@ OptSolutionData* SCIPRunSolver(int ProbType) {
 	//Printing the problem to an LP file in the output directory
 	string CurrentFilename = GetParameter("LP filename");
 	SetParameter("LP filename","Problem.lp");
-	if (GLPKPrintFromSolver() != SUCCESS) {
+	if (GLPKPrintFromSolver(Context) != SUCCESS) {
 		SetParameter("LP filename",CurrentFilename.data());
 		return NULL;	
 	}
 	//Calling the scrip executable
 	system((GetParameter("scip executable")+" -s "+FOutputFilepath()+"ScipSettings.txt -f "+FOutputFilepath()+GetParameter("LP filename")+" > "+FOutputFilepath()+"ScipOutput.out").data());
 	SetParameter("LP filename",CurrentFilename.data());
-	OptSolutionData* NewSolution = ParseSCIPSolution("ScipOutput.out",SolverVariables());
+	OptSolutionData* NewSolution = ParseSCIPSolution("ScipOutput.out",Context->Variables);
 	if (NewSolution != NULL) {
 		cout << "Objective value: " << NewSolution->Objective << endl;
 	}
 	return NewSolution;
 }
 
-int SCIPLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
-	return GLPKLoadVariables(InVariable,RelaxIntegerVariables,UseTightBounds);
+int SCIPLoadVariables(SolverContext* Context, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	return GLPKLoadVariables(Context,InVariable,RelaxIntegerVariables,UseTightBounds);
+}
+
+int SCIPLoadProblem(SolverContext* Context, SolverMatrix* InMatrix) {
+	return GLPKLoadProblem(Context,InMatrix);
+}
+
+int SCIPLoadObjective(SolverContext* Context, LinEquation* InEquation, bool Max) {
+	return GLPKLoadObjective(Context,InEquation,Max);
+}
+
+int SCIPAddConstraint(SolverContext* Context, LinEquation* InEquation) {
+	return GLPKAddConstraint(Context,InEquation);
 }
 
-int SCIPLoadObjective(LinEquation* InEquation, bool Max) {
-	return GLPKLoadObjective(InEquation,Max);
+int SCIPSaveBasis(SolverContext* Context, SolverBasis* OutBasis) {
+	return GLPKSaveBasis(Context,OutBasis);
 }
 
-int SCIPAddConstraint(LinEquation* InEquation) {
-	return GLPKAddConstraint(InEquation);
+int SCIPLoadBasis(SolverContext* Context, SolverBasis* InBasis) {
+	return GLPKLoadBasis(Context,InBasis);
 }
\ No newline at end of file
@@ -4,34 +4,46 @@ int InitializeSCIPVariables() {
 	return FAIL;
 }
 
-int SCIPInitialize() {
+int SCIPInitialize(SolverContext*) {
 	return FAIL;
 }
 
-int SCIPCleanup() {
+int SCIPCleanup(SolverContext*) {
 	return FAIL;
 }
 
-int SCIPClearSolver() {
+int SCIPClearSolver(SolverContext*) {
 	return FAIL;
 }
 
-int SCIPPrintFromSolver() {
+int SCIPPrintFromSolver(SolverContext*) {
 	return FAIL;
 }
 
-OptSolutionData* SCIPRunSolver(int ProbType) {
+OptSolutionData* SCIPRunSolver(SolverContext*, int ProbType) {
 	return NULL;
 }
 
-int SCIPLoadVariables(MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+int SCIPLoadVariables(SolverContext*, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
 	return FAIL;
 }
 
-int SCIPLoadObjective(LinEquation* InEquation, bool Max) {
+int SCIPLoadProblem(SolverContext*, SolverMatrix*) {
 	return FAIL;
 }
 
-int SCIPAddConstraint(LinEquation* InEquation) {
+int SCIPLoadObjective(SolverContext*, LinEquation* InEquation, bool Max) {
+	return FAIL;
+}
+
+int SCIPAddConstraint(SolverContext*, LinEquation* InEquation) {
+	return FAIL;
+}
+
+int SCIPSaveBasis(SolverContext*, SolverBasis*) {
+	return FAIL;
+}
+
+int SCIPLoadBasis(SolverContext*, SolverBasis*) {
 	return FAIL;
 }
\ No newline at end of file
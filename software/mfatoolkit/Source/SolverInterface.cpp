@@ -20,30 +20,62 @@
 
 #include "MFAToolkit.h"
 
-vector<MFAVariable*> Variables;
+//Solve statistics combined by analysis, problem type and problem size
+map<string,SolveStatsSummary> SolveSummaries;
 
-int SolverVariableSize() {
-	return int(Variables.size());
+SolverContext* NewSolverContext() {
+	SolverContext* NewContext = new SolverContext;
+	NewContext->GLPKModel = NULL;
+	NewContext->CPLEXModel = NULL;
+	NewContext->SCIPModel = NULL;
+	NewContext->LINDOModel = NULL;
+	NewContext->BoundsChanged = false;
+	NewContext->ObjectiveChanged = false;
+	return NewContext;
 }
 
-void AddSolverVariable(MFAVariable* InVariable) {
-	if (InVariable->Index < int(Variables.size())) {
-		Variables[InVariable->Index] = InVariable;
+void DeleteSolverContext(SolverContext* Context) {
+	if (Context == NULL) {
+		return;
+	}
+	//Freeing whichever solver models this context still holds
+	if (Context->CPLEXModel != NULL) {
+		CPLEXClearSolver(Context);
+	}
+	if (Context->LINDOModel != NULL) {
+		LINDOClearSolver(Context);
+	}
+	if (Context->SCIPModel != NULL) {
+		SCIPClearSolver(Context);
+	}
+	if (Context->GLPKModel != NULL) {
+		GLPKClearSolver(Context);
+	}
+	delete Context;
+}
+
+int SolverVariableSize(SolverContext* Context) {
+	return int(Context->Variables.size());
+}
+
+void AddSolverVariable(SolverContext* Context, MFAVariable* InVariable) {
+	if (InVariable->Index < int(Context->Variables.size())) {
+		Context->Variables[InVariable->Index] = InVariable;
 	} else {	
-		Variables.push_back(InVariable);
+		Context->Variables.push_back(InVariable);
 	}
 }
 
-vector<MFAVariable*> SolverVariables() {
-	return Variables;
+vector<MFAVariable*>& SolverVariables(SolverContext* Context) {
+	return Context->Variables;
 }
 
-MFAVariable* GetSolverVariable(int index) {
-	return Variables[index];
+MFAVariable* GetSolverVariable(SolverContext* Context, int index) {
+	return Context->Variables[index];
 }
 
-void ClearSolverVariables() {
-	Variables.clear();
+void ClearSolverVariables(SolverContext* Context) {
+	Context->Variables.clear();
 }
 
 int SelectSolver(int ProbType, int CurrentSolver) {
@@ -76,20 +108,22 @@ int SelectSolver(int ProbType, int CurrentSolver) {
 	return GLPK;
 }
 
-int GlobalInitializeSolver(int Solver) {
-	ClearSolverVariables();
+int GlobalInitializeSolver(SolverContext* Context, int Solver) {
+	ClearSolverVariables(Context);
+	Context->BoundsChanged = false;
+	Context->ObjectiveChanged = false;
 	if (Solver == CPLEX) {
-		CPLEXClearSolver();
-		return CPLEXInitialize();
+		CPLEXClearSolver(Context);
+		return CPLEXInitialize(Context);
 	} else if (Solver == LINDO) {
-		LINDOClearSolver();
-		return LINDOInitialize();
+		LINDOClearSolver(Context);
+		return LINDOInitialize(Context);
 	} else if (Solver == GLPK) {
-		GLPKClearSolver();
-		return GLPKInitialize();
+		GLPKClearSolver(Context);
+		return GLPKInitialize(Context);
 	} else if (Solver == SOLVER_SCIP) {
-		SCIPClearSolver();
-		return SCIPInitialize();
+		SCIPClearSolver(Context);
+		return SCIPInitialize(Context);
 	} else {
 		FErrorFile() << "Failed to initialize solver due unrecognized solver." << endl;
 		FlushErrorFile();
@@ -97,7 +131,20 @@ int GlobalInitializeSolver(int Solver) {
 	}
 }
 
-OptSolutionData* GlobalRunSolver(int Solver, int ProbType) {
+bool GlobalSolverAllowsWorkers(int Solver) {
+	//Printed LP files and solver output files are numbered by one counter that workers would each advance from the same value
+	if (GetParameter("print lp files rather than solve").compare("1") == 0 || GetParameter("use solver output files").compare("1") == 0) {
+		return false;
+	}
+	if (Solver == GLPK) {
+		return true;
+	} else if (Solver == SOLVER_SCIP) {
+		return SCIPSolvesInProcess();
+	}
+	return false;
+}
+
+OptSolutionData* GlobalRunSolver(SolverContext* Context, int Solver, int ProbType) {
 	if (GetParameter("print lp files rather than solve").compare("1") == 0) {
 		ofstream JobFileOutput;
 		string LPFilename = GetParameter("LP filename");
@@ -110,121 +157,365 @@ OptSolutionData* GlobalRunSolver(int Solver, int ProbType) {
 			OpenOutput(JobFileOutput,FOutputFilepath()+"MFAOutput/LPFiles/JobFile.txt",true);
 		}
 		int count = atoi(GetParameter("LP file index").data());
-		JobFileOutput << GetParameter("LP solver filename") << " -s " << GetParameter("LP job directory") << "ScipSettings.txt -f " << GetParameter("LP job directory") << "LPFiles/" << count << ".lp > " << GetParameter("LP job directory") << "Output/OutputFile" << count << ".txt" << endl;
+		if (atoi(GetParameter("Local LP job workers").data()) > 0) {
+			//Jobs run on this machine read and write the output directory so ParseSCIPSolution finds the results where it looks for them
+			string LPDirectory = FOutputFilepath()+"MFAOutput/LPFiles/";
+			if (count == 0) {
+				ofstream Settings;
+				if (OpenOutput(Settings,LPDirectory+"ScipSettings.txt")) {
+					Settings << "limits/time = " << GetParameter("CPLEX solver time limit") << endl;
+					Settings.close();
+				}
+			}
+			JobFileOutput << GetParameter("LP solver filename") << " -s " << LPDirectory << "ScipSettings.txt -f " << LPDirectory << count << ".lp > " << LPDirectory << "OutputFile" << count << ".txt" << endl;
+		} else {
+			JobFileOutput << GetParameter("LP solver filename") << " -s " << GetParameter("LP job directory") << "ScipSettings.txt -f " << GetParameter("LP job directory") << "LPFiles/" << count << ".lp > " << GetParameter("LP job directory") << "Output/OutputFile" << count << ".txt" << endl;
+		}
 		JobFileOutput.close();
 		SetParameter("LP file index",itoa(count+1));
 		string Temp("MFAOutput/LPFiles/");
 		SetParameter("LP filename",(Temp+itoa(count)+".lp").data());
-		GlobalWriteLPFile(Solver);
+		GlobalWriteLPFile(Context,Solver);
 		SetParameter("LP filename",LPFilename.data());
+		//Recording which problem each output file belongs to, so a replay can tell when its solves no longer line up with the printed ones
+		ofstream HashOutput;
+		if (OpenOutput(HashOutput,FOutputFilepath()+Temp+"LPFileHashes.txt",count > 0)) {
+			HashOutput << HashFile(FOutputFilepath()+Temp+itoa(count)+".lp") << endl;
+			HashOutput.close();
+		}
 		return NULL;
 	} else if (GetParameter("use solver output files").compare("1") == 0) {
+		static vector<string> PrintedHashes;
+		string Temp("MFAOutput/LPFiles/");
 		if (GetParameter("LP file index").length() == 0) {
 			SetParameter("LP file index","0");
+			PrintedHashes = ReadStringsFromFile(FOutputFilepath()+Temp+"LPFileHashes.txt",false);
 		}
 		int count = atoi(GetParameter("LP file index").data());
-		SetParameter("LP file index",itoa(count+1));
-		string Temp("MFAOutput/LPFiles/");
-		OptSolutionData* NewSolution = ParseSCIPSolution((Temp+"OutputFile"+itoa(count)+".txt").data(),Variables);
+		//Analyses that stopped early in the print pass make extra solves here, so a solve only takes an output file if it is the problem that was printed for it
+		string LPFilename = GetParameter("LP filename");
+		SetParameter("LP filename",(Temp+"Replay.lp").data());
+		GlobalWriteLPFile(Context,Solver);
+		SetParameter("LP filename",LPFilename.data());
+		string Hash = HashFile(FOutputFilepath()+Temp+"Replay.lp");
+		OptSolutionData* NewSolution = NULL;
+		if (Hash.length() > 0 && count < int(PrintedHashes.size()) && Hash.compare(PrintedHashes[count]) == 0) {
+			SetParameter("LP file index",itoa(count+1));
+			NewSolution = ParseSCIPSolution((Temp+"OutputFile"+itoa(count)+".txt").data(),Context->Variables);
+			if (NewSolution == NULL) {
+				FErrorFile() << "Could not read solver output file " << count << "; solving the problem directly." << endl;
+				FlushErrorFile(SEVERITY_WARNING);
+			}
+		} else {
+			FErrorFile() << "Problem does not match printed LP file " << count << "; solving it directly." << endl;
+			FlushErrorFile(SEVERITY_WARNING);
+		}
 		if (NewSolution != NULL) {
+			ClearSolveStats(NewSolution->Stats);
 			cout << "Objective value: " << NewSolution->Objective << endl;
+			return NewSolution;
 		}
-		return NewSolution;
 	}
 
+	OptSolutionData* NewSolution = NULL;
+	ClearSolveStats(Context->Stats);
+	long long StartTime = MonotonicNanoseconds();
 	if (Solver == CPLEX) {
-		return CPLEXRunSolver(ProbType);
+		NewSolution = CPLEXRunSolver(Context,ProbType);
 	} else if (Solver == LINDO) {
-		return LINDORunSolver(ProbType);
+		NewSolution = LINDORunSolver(Context,ProbType);
+	} else if (Solver == GLPK) {
+		NewSolution = GLPKRunSolver(Context,ProbType);
+	} else if (Solver == SOLVER_SCIP) {
+		NewSolution = SCIPRunSolver(Context,ProbType);
+	} else {
+		FErrorFile() << "Could not run solver. Solver no recognized: " << Solver << endl;
+		FlushErrorFile();
+		return NULL;
+	}
+	Context->Stats.SolveTime = 1e-9*double(MonotonicNanoseconds()-StartTime);
+	RecordSolveStats(Context->Stats,ProbType);
+	if (NewSolution != NULL) {
+		NewSolution->Stats = Context->Stats;
+	}
+	Context->BoundsChanged = false;
+	Context->ObjectiveChanged = false;
+	return NewSolution;
+}
+
+void ClearSolveStats(SolveStats& Stats) {
+	Stats.SolveTime = 0;
+	Stats.Iterations = 0;
+	Stats.Nodes = 0;
+	Stats.MIPGap = 0;
+	Stats.NumRows = 0;
+	Stats.NumColumns = 0;
+	Stats.NumNonzeros = 0;
+	Stats.WarmStart = false;
+}
+
+void RecordSolveStats(SolveStats& Stats, int ProbType) {
+	string Key(CallingProfilePhase());
+	Key.append("\t");
+	if (ProbType == LP) {
+		Key.append("LP");
+	} else if (ProbType == MILP) {
+		Key.append("MILP");
+	} else if (ProbType == QP) {
+		Key.append("QP");
+	} else if (ProbType == MIQP) {
+		Key.append("MIQP");
+	} else {
+		Key.append(itoa(ProbType));
+	}
+	Key.append("\t");
+	Key.append(itoa(Stats.NumRows));
+	Key.append("\t");
+	Key.append(itoa(Stats.NumColumns));
+	Key.append("\t");
+	Key.append(itoa(Stats.NumNonzeros));
+	map<string,SolveStatsSummary>::iterator MapIT = SolveSummaries.find(Key);
+	if (MapIT == SolveSummaries.end()) {
+		SolveStatsSummary NewSummary;
+		memset(&NewSummary,0,sizeof(NewSummary));
+		MapIT = SolveSummaries.insert(pair<string,SolveStatsSummary>(Key,NewSummary)).first;
+	}
+	SolveStatsSummary& Summary = MapIT->second;
+	Summary.Solves++;
+	if (Stats.WarmStart) {
+		Summary.WarmStarts++;
+	}
+	Summary.TotalTime += Stats.SolveTime;
+	if (Stats.SolveTime > Summary.MaxTime) {
+		Summary.MaxTime = Stats.SolveTime;
+	}
+	Summary.Iterations += Stats.Iterations;
+	Summary.Nodes += Stats.Nodes;
+	//Solvers report an infinite gap when no integer solution was found
+	if (Stats.MIPGap > Summary.MaxMIPGap && Stats.MIPGap < 1e20) {
+		Summary.MaxMIPGap = Stats.MIPGap;
+	}
+	int Bucket = 0;
+	for (double Limit=0.001; Bucket < SOLVE_TIME_BUCKETS-1 && Stats.SolveTime >= Limit; Limit *= 10) {
+		Bucket++;
+	}
+	Summary.TimeBuckets[Bucket]++;
+}
+
+void ClearSolveSummaries() {
+	SolveSummaries.clear();
+}
+
+bool SendSolveSummaries(int Pipe) {
+	int NumSummaries = int(SolveSummaries.size());
+	if (!WriteToPipe(Pipe,&NumSummaries,sizeof(int))) {
+		return false;
+	}
+	for (map<string,SolveStatsSummary>::iterator MapIT = SolveSummaries.begin(); MapIT != SolveSummaries.end(); MapIT++) {
+		int KeyLength = int(MapIT->first.length());
+		if (!WriteToPipe(Pipe,&KeyLength,sizeof(int)) || !WriteToPipe(Pipe,MapIT->first.data(),KeyLength) || !WriteToPipe(Pipe,&(MapIT->second),sizeof(SolveStatsSummary))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ReceiveSolveSummaries(int Pipe) {
+	int NumSummaries;
+	if (!ReadFromPipe(Pipe,&NumSummaries,sizeof(int))) {
+		return false;
+	}
+	for (int i=0; i < NumSummaries; i++) {
+		int KeyLength;
+		if (!ReadFromPipe(Pipe,&KeyLength,sizeof(int)) || KeyLength < 0 || KeyLength > 65536) {
+			return false;
+		}
+		string Key(KeyLength,' ');
+		SolveStatsSummary Received;
+		if ((KeyLength > 0 && !ReadFromPipe(Pipe,&Key[0],KeyLength)) || !ReadFromPipe(Pipe,&Received,sizeof(SolveStatsSummary))) {
+			return false;
+		}
+		map<string,SolveStatsSummary>::iterator MapIT = SolveSummaries.find(Key);
+		if (MapIT == SolveSummaries.end()) {
+			SolveSummaries.insert(pair<string,SolveStatsSummary>(Key,Received));
+			continue;
+		}
+		SolveStatsSummary& Summary = MapIT->second;
+		Summary.Solves += Received.Solves;
+		Summary.WarmStarts += Received.WarmStarts;
+		Summary.TotalTime += Received.TotalTime;
+		if (Received.MaxTime > Summary.MaxTime) {
+			Summary.MaxTime = Received.MaxTime;
+		}
+		Summary.Iterations += Received.Iterations;
+		Summary.Nodes += Received.Nodes;
+		if (Received.MaxMIPGap > Summary.MaxMIPGap) {
+			Summary.MaxMIPGap = Received.MaxMIPGap;
+		}
+		for (int j=0; j < SOLVE_TIME_BUCKETS; j++) {
+			Summary.TimeBuckets[j] += Received.TimeBuckets[j];
+		}
+	}
+	return true;
+}
+
+int WriteSolveStatistics() {
+	static ParameterHandle* WriteStatistics = GetParameterHandle("Write solve statistics");
+	if (!WriteStatistics->Bool || SolveSummaries.size() == 0) {
+		return SUCCESS;
+	}
+	ofstream Output;
+	if (!OpenOutput(Output,FOutputFilepath()+"SolveStatistics.txt")) {
+		return FAIL;
+	}
+	Output << "Analysis\tProblem type\tRows\tColumns\tNonzeros\tSolves\tWarm starts\tTotal time (s)\tMean time (s)\tMax time (s)\tMean iterations\tMean nodes\tMax MIP gap\t<1ms\t<10ms\t<100ms\t<1s\t<10s\t<100s\t>=100s" << endl;
+	for (map<string,SolveStatsSummary>::iterator MapIT = SolveSummaries.begin(); MapIT != SolveSummaries.end(); MapIT++) {
+		SolveStatsSummary& Summary = MapIT->second;
+		Output << MapIT->first << "\t" << Summary.Solves << "\t" << Summary.WarmStarts << "\t" << Summary.TotalTime << "\t" << Summary.TotalTime/Summary.Solves << "\t" << Summary.MaxTime << "\t" << Summary.Iterations/Summary.Solves << "\t" << Summary.Nodes/Summary.Solves << "\t" << Summary.MaxMIPGap;
+		for (int i=0; i < SOLVE_TIME_BUCKETS; i++) {
+			Output << "\t" << Summary.TimeBuckets[i];
+		}
+		Output << endl;
+	}
+	Output.close();
+	return SUCCESS;
+}
+
+int GlobalLoadProblem(SolverContext* Context, int Solver, vector<MFAVariable*>& InVariables, vector<LinEquation*>& InConstraints, bool RelaxIntegerVariables,bool UseTightBounds) {
+	SolverMatrix Matrix;
+	Matrix.Variables = InVariables;
+	Matrix.Constraints = InConstraints;
+	Matrix.RelaxIntegerVariables = RelaxIntegerVariables;
+	Matrix.UseTightBounds = UseTightBounds;
+	
+	int NumNonzeros = 0;
+	for (int i=0; i < int(InConstraints.size()); i++) {
+		NumNonzeros += int(InConstraints[i]->Variables.size());
+	}
+	Matrix.RowStart.resize(InConstraints.size()+1);
+	Matrix.Columns.reserve(NumNonzeros);
+	Matrix.Coefficients.reserve(NumNonzeros);
+	for (int i=0; i < int(InConstraints.size()); i++) {
+		Matrix.RowStart[i] = int(Matrix.Columns.size());
+		for (int j=0; j < int(InConstraints[i]->Variables.size()); j++) {
+			if (InConstraints[i]->Variables[j]->Index < 0 || InConstraints[i]->Variables[j]->Index >= int(InVariables.size())) {
+				FErrorFile() << "Variable index found in constraint " << i << " is out of the range of the variables being loaded." << endl;
+				FlushErrorFile();
+				return FAIL;
+			}
+			Matrix.Columns.push_back(InConstraints[i]->Variables[j]->Index);
+			Matrix.Coefficients.push_back(InConstraints[i]->Coefficient[j]);
+		}
+	}
+	Matrix.RowStart[InConstraints.size()] = int(Matrix.Columns.size());
+
+	ClearSolverVariables(Context);
+	for (int i=0; i < int(InVariables.size()); i++) {
+		AddSolverVariable(Context,InVariables[i]);
+	}
+
+	if (Solver == CPLEX) {
+		return CPLEXLoadProblem(Context,&Matrix);
 	} else if (Solver == GLPK) {
-		return GLPKRunSolver(ProbType);
+		return GLPKLoadProblem(Context,&Matrix);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPRunSolver(ProbType);
+		return SCIPLoadProblem(Context,&Matrix);
 	}
-	FErrorFile() << "Could not run solver. Solver no recognized: " << Solver << endl;
+	FErrorFile() << "Could not load problem in bulk. Solver not supported: " << Solver << endl;
 	FlushErrorFile();
-	return NULL;
+	return FAIL;
 }
 
-int GlobalLoadVariable(int Solver, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
-	AddSolverVariable(InVariable);
+int GlobalLoadVariable(SolverContext* Context, int Solver, MFAVariable* InVariable, bool RelaxIntegerVariables,bool UseTightBounds) {
+	if (InVariable->Index < SolverVariableSize(Context)) {
+		Context->BoundsChanged = true;
+	}
+	AddSolverVariable(Context,InVariable);
 	if (Solver == CPLEX) {
-		return CPLEXLoadVariables(InVariable, RelaxIntegerVariables, UseTightBounds);
+		return CPLEXLoadVariables(Context,InVariable, RelaxIntegerVariables, UseTightBounds);
 	} else if (Solver == LINDO) {
-		return LINDOLoadVariables(InVariable, RelaxIntegerVariables, UseTightBounds);
+		return LINDOLoadVariables(Context,InVariable, RelaxIntegerVariables, UseTightBounds);
 	} else if (Solver == GLPK) {
-		return GLPKLoadVariables(InVariable, RelaxIntegerVariables, UseTightBounds);
+		return GLPKLoadVariables(Context,InVariable, RelaxIntegerVariables, UseTightBounds);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPLoadVariables(InVariable, RelaxIntegerVariables, UseTightBounds);
+		return SCIPLoadVariables(Context,InVariable, RelaxIntegerVariables, UseTightBounds);
 	}
 	FErrorFile() << "Could not load variable. Solver no recognized: " << Solver << endl;
 	FlushErrorFile();
 	return FAIL;
 }
 
-int GlobalResetSolver(int Solver) {
-	ClearSolverVariables();
+int GlobalResetSolver(SolverContext* Context, int Solver) {
+	ClearSolverVariables(Context);
+	Context->BoundsChanged = false;
+	Context->ObjectiveChanged = false;
 	if (Solver == CPLEX) {
-		return CPLEXClearSolver();
+		return CPLEXClearSolver(Context);
 	} else if (Solver == LINDO) {
-		return LINDOClearSolver();
+		return LINDOClearSolver(Context);
 	} else if (Solver == GLPK) {
-		return GLPKClearSolver();
+		return GLPKClearSolver(Context);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPClearSolver();
+		return SCIPClearSolver(Context);
 	}
 	FErrorFile() << "Could not clear solver. Solver no recognized: " << Solver << endl;
 	FlushErrorFile();
 	return FAIL;
 }
 
-int GlobalLoadObjective(int Solver, LinEquation* InEquation, bool Max) {
+int GlobalLoadObjective(SolverContext* Context, int Solver, LinEquation* InEquation, bool Max) {
+	Context->ObjectiveChanged = true;
 	if (Solver == CPLEX) {
-		return CPLEXLoadObjective(InEquation, Max);
+		return CPLEXLoadObjective(Context,InEquation, Max);
 	} else if (Solver == LINDO) {
-		return LINDOLoadObjective(InEquation, Max);
+		return LINDOLoadObjective(Context,InEquation, Max);
 	} else if (Solver == GLPK) {
-		return GLPKLoadObjective(InEquation, Max);
+		return GLPKLoadObjective(Context,InEquation, Max);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPLoadObjective(InEquation, Max);
+		return SCIPLoadObjective(Context,InEquation, Max);
 	}
 	FErrorFile() << "Could not load objective. Solver no recognized: " << Solver << endl;
 	FlushErrorFile();
 	return FAIL;
 }
 
-int GlobalWriteLPFile(int Solver) {
+int GlobalWriteLPFile(SolverContext* Context, int Solver) {
 	if (Solver == CPLEX) {
-		return CPLEXPrintFromSolver();
+		return CPLEXPrintFromSolver(Context);
 	} else if (Solver == LINDO) {
-		return LINDOPrintFromSolver();
+		return LINDOPrintFromSolver(Context);
 	} else if (Solver == GLPK) {
-		return GLPKPrintFromSolver();
+		return GLPKPrintFromSolver(Context);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPPrintFromSolver();
+		return SCIPPrintFromSolver(Context);
 	} else {
 		return FAIL;
 	}
 }
 
-int GlobalAddConstraint(int Solver, LinEquation* InConstraint) {
+int GlobalAddConstraint(SolverContext* Context, int Solver, LinEquation* InConstraint) {
+	//Row changes can break both primal and dual feasibility of the previous basis
+	Context->BoundsChanged = true;
+	Context->ObjectiveChanged = true;
 	if (Solver == CPLEX) {
-		return CPLEXAddConstraint(InConstraint);
+		return CPLEXAddConstraint(Context,InConstraint);
 	} else if (Solver == LINDO) {
-		return LINDOAddConstraint(InConstraint);
+		return LINDOAddConstraint(Context,InConstraint);
 	} else if (Solver == GLPK) {
-		return GLPKAddConstraint(InConstraint);
+		return GLPKAddConstraint(Context,InConstraint);
 	} else if (Solver == SOLVER_SCIP) {
-		return SCIPAddConstraint(InConstraint);
+		return SCIPAddConstraint(Context,InConstraint);
 	}
 	FErrorFile() << "Could not load constraint. Solver not recognized: " << Solver << endl;
 	FlushErrorFile();
 	return FAIL;
 }
 
-int GlobalRemoveConstraint(int Solver, LinEquation* InConstraint) {
+int GlobalRemoveConstraint(SolverContext* Context, int Solver, LinEquation* InConstraint) {
+	Context->BoundsChanged = true;
+	Context->ObjectiveChanged = true;
 	if (Solver == CPLEX) {
-		return CPLEXDelConstraint(InConstraint);
+		return CPLEXDelConstraint(Context,InConstraint);
 	} else if (Solver == LINDO) {
 		cout << "GlobalRemoveConstraint not implemented for LINDO yet." << endl;
 		return FAIL;
@@ -239,3 +530,25 @@ int GlobalRemoveConstraint(int Solver, LinEquation* InConstraint) {
 	FlushErrorFile();
 	return FAIL;
 }
+
+int GlobalSaveBasis(SolverContext* Context, int Solver, SolverBasis* OutBasis) {
+	if (Solver == CPLEX) {
+		return CPLEXSaveBasis(Context,OutBasis);
+	} else if (Solver == GLPK) {
+		return GLPKSaveBasis(Context,OutBasis);
+	} else if (Solver == SOLVER_SCIP) {
+		return SCIPSaveBasis(Context,OutBasis);
+	}
+	return FAIL;
+}
+
+int GlobalLoadBasis(SolverContext* Context, int Solver, SolverBasis* InBasis) {
+	if (Solver == CPLEX) {
+		return CPLEXLoadBasis(Context,InBasis);
+	} else if (Solver == GLPK) {
+		return GLPKLoadBasis(Context,InBasis);
+	} else if (Solver == SOLVER_SCIP) {
+		return SCIPLoadBasis(Context,InBasis);
+	}
+	return FAIL;
+}
@@ -778,9 +778,9 @@ double Species::GetMaxConcentration(const char* Compartment) {
 
 	vector<string> Names = GetAllData("NAME",STRING);
 	for (int i=0; i < int(Names.size()); i++) {
-		double* Range = Temp->SpecialConcRanges[Names[i]];
-		if (Range != NULL) {
-			return Range[1];
+		map<string, double*, std::less<string> >::iterator MapIT = Temp->SpecialConcRanges.find(Names[i]);
+		if (MapIT != Temp->SpecialConcRanges.end() && MapIT->second != NULL) {
+			return MapIT->second[1];
 		}
 	}
 
@@ -796,9 +796,9 @@ double Species::GetMinConcentration(const char* Compartment) {
 
 	vector<string> Names = GetAllData("NAME",STRING);
 	for (int i=0; i < int(Names.size()); i++) {
-		double* Range = Temp->SpecialConcRanges[Names[i]];
-		if (Range != NULL) {
-			return Range[0];
+		map<string, double*, std::less<string> >::iterator MapIT = Temp->SpecialConcRanges.find(Names[i]);
+		if (MapIT != Temp->SpecialConcRanges.end() && MapIT->second != NULL) {
+			return MapIT->second[0];
 		}
 	}
 
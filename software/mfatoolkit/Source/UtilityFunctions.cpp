@@ -19,26 +19,36 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MFAToolkit.h"
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <errno.h>
 
-string itoaString;
+//Per thread so numbers can be formatted on worker threads; the result is valid until the next itoa or dtoa call on the same thread
+__thread char itoaBuffer[64];
 
 vector<double> TimeOutTime;
 vector<double> StartTime;
+vector<ProfileEvent> ProfileEvents;
+int OpenProfileEvent = -1;
 
 map<string, vector<string>, std::less<string> > FileLineData;
 
 const char* itoa(int InNum) {
 	ostringstream strout;
 	strout << InNum;
-	itoaString = strout.str();
-	return itoaString.data();
+	strncpy(itoaBuffer,strout.str().data(),sizeof(itoaBuffer)-1);
+	itoaBuffer[sizeof(itoaBuffer)-1] = 0;
+	return itoaBuffer;
 }
 
 const char* dtoa(double InNum) {
 	ostringstream strout;
 	strout << InNum;
-	itoaString = strout.str();
-	return itoaString.data();
+	strncpy(itoaBuffer,strout.str().data(),sizeof(itoaBuffer)-1);
+	itoaBuffer[sizeof(itoaBuffer)-1] = 0;
+	return itoaBuffer;
 }
 
 string FDate() {
@@ -89,32 +99,126 @@ vector<string>* GetStringsFileline(ifstream &Input, const char* Delim, bool Trea
 }
 
 vector<string>* StringToStrings(string FullString, const char* Delim, bool TreatConsecutiveDelimAsOne) {
-	vector<string>* NewVect = new vector<string>;
-	string Buff(FullString);
+	vector<StringField> Fields;
+	SplitFields(FullString,Delim,Fields,TreatConsecutiveDelimAsOne);
+	vector<string>* NewVect = new vector<string>(Fields.size());
+	for (int i=0; i < int(Fields.size()); i++) {
+		(*NewVect)[i].assign(Fields[i].Data,Fields[i].Length);
+	}
+	return NewVect;
+}
 
-	int Location;
-	do {
-		Location = int(Buff.find_first_of(Delim));
-		if (Location != -1) {
-			if (Location == 0) {
-				if (!TreatConsecutiveDelimAsOne) {
-					string NewString;
-					NewVect->push_back(NewString);
-				}
-				Buff = Buff.substr(Location+1, Buff.length()-(Location+1));
-			} else {
-				string NewString = Buff.substr(0, Location);
-				NewVect->push_back(NewString);
-				Buff = Buff.substr(Location+1, Buff.length()-(Location+1));
+int SplitFields(const char* Line, int Length, const char* Delim, vector<StringField>& Fields, bool TreatConsecutiveDelimAsOne) {
+	bool IsDelimiter[256] = {false};
+	for (const char* Current = Delim; *Current != 0; Current++) {
+		IsDelimiter[(unsigned char)(*Current)] = true;
+	}
+	Fields.clear();
+	int Start = 0;
+	for (int i=0; i <= Length; i++) {
+		if (i == Length || IsDelimiter[(unsigned char)(Line[i])]) {
+			if (i > Start || !TreatConsecutiveDelimAsOne) {
+				StringField NewField = {Line+Start,i-Start};
+				Fields.push_back(NewField);
 			}
+			Start = i+1;
 		}
-	} while(Location != -1);
-	
-	if (Buff.length() != 0 || !TreatConsecutiveDelimAsOne) {
-		NewVect->push_back(Buff);
 	}
-	
-	return NewVect;
+	return int(Fields.size());
+}
+
+int SplitFields(const string& Line, const char* Delim, vector<StringField>& Fields, bool TreatConsecutiveDelimAsOne) {
+	return SplitFields(Line.data(),int(Line.length()),Delim,Fields,TreatConsecutiveDelimAsOne);
+}
+
+string FieldToString(const StringField& Field) {
+	return string(Field.Data,Field.Length);
+}
+
+bool FieldEquals(const StringField& Field, const char* Text) {
+	return strncmp(Field.Data,Text,Field.Length) == 0 && Text[Field.Length] == 0;
+}
+
+double FieldToDouble(const StringField& Field) {
+	char Buffer[64];
+	if (Field.Length >= int(sizeof(Buffer))) {
+		return atof(FieldToString(Field).data());
+	}
+	memcpy(Buffer,Field.Data,Field.Length);
+	Buffer[Field.Length] = 0;
+	return atof(Buffer);
+}
+
+bool OpenLineReader(FileLineReader& Reader, string Filename, int BufferSize) {
+	Filename = CheckFilename(Filename);
+	Reader.Buffer = NULL;
+	Reader.Capacity = 0;
+	Reader.Start = 0;
+	Reader.End = 0;
+	Reader.Finished = true;
+	Reader.Input = fopen(Filename.data(),"rb");
+	if (Reader.Input == NULL) {
+		cout << "Could not open " << Filename << endl;
+		FErrorFile() << "Could not open " << Filename << endl;
+		return false;
+	}
+	Reader.Capacity = BufferSize;
+	Reader.Buffer = new char[BufferSize+1];
+	Reader.Finished = false;
+	return true;
+}
+
+bool ReadLine(FileLineReader& Reader, StringField& Line) {
+	if (Reader.Buffer == NULL) {
+		return false;
+	}
+	while (true) {
+		char* Newline = (char*)memchr(Reader.Buffer+Reader.Start,'\n',Reader.End-Reader.Start);
+		if (Newline != NULL) {
+			*Newline = 0;
+			Line.Data = Reader.Buffer+Reader.Start;
+			Line.Length = int(Newline-Line.Data);
+			Reader.Start = int(Newline-Reader.Buffer)+1;
+			return true;
+		}
+		if (Reader.Finished) {
+			if (Reader.Start == Reader.End) {
+				return false;
+			}
+			Reader.Buffer[Reader.End] = 0;
+			Line.Data = Reader.Buffer+Reader.Start;
+			Line.Length = Reader.End-Reader.Start;
+			Reader.Start = Reader.End;
+			return true;
+		}
+		//The partial line is moved to the front of the buffer, which doubles only when a single line fills it
+		if (Reader.Start > 0) {
+			memmove(Reader.Buffer,Reader.Buffer+Reader.Start,Reader.End-Reader.Start);
+			Reader.End -= Reader.Start;
+			Reader.Start = 0;
+		}
+		if (Reader.End == Reader.Capacity) {
+			char* NewBuffer = new char[2*Reader.Capacity+1];
+			memcpy(NewBuffer,Reader.Buffer,Reader.End);
+			delete [] Reader.Buffer;
+			Reader.Buffer = NewBuffer;
+			Reader.Capacity *= 2;
+		}
+		size_t Count = fread(Reader.Buffer+Reader.End,1,Reader.Capacity-Reader.End,Reader.Input);
+		Reader.End += int(Count);
+		if (Count == 0) {
+			Reader.Finished = true;
+		}
+	}
+}
+
+void CloseLineReader(FileLineReader& Reader) {
+	if (Reader.Input != NULL) {
+		fclose(Reader.Input);
+		Reader.Input = NULL;
+	}
+	delete [] Reader.Buffer;
+	Reader.Buffer = NULL;
 }
 
 void findandreplace(string &source, string find, string replace) {
@@ -342,6 +446,23 @@ bool OpenInput(ifstream& Input, string Filename) {
 	}
 }
 
+string HashFile(string Filename) {
+	ifstream Input(CheckFilename(Filename).data(),ios::in | ios::binary);
+	if (!Input.is_open()) {
+		return "";
+	}
+	unsigned long long Hash = 14695981039346656037ULL;
+	char Buffer[65536];
+	while (Input.read(Buffer,sizeof(Buffer)) || Input.gcount() > 0) {
+		for (int i=0; i < int(Input.gcount()); i++) {
+			Hash = (Hash^(unsigned char)Buffer[i])*1099511628211ULL;
+		}
+	}
+	ostringstream Output;
+	Output << std::hex << Hash;
+	return Output.str();
+}
+
 bool OpenOutput(ofstream& Output, string Filename, bool Append) {
 	Filename = CheckFilename(Filename);
 	
@@ -547,12 +668,12 @@ int StartClock(int ClockIndex) {
 		}
 	}
 	
-	StartTime[ClockIndex] = double(time(NULL));
+	StartTime[ClockIndex] = 1e-9*double(MonotonicNanoseconds());
 	return ClockIndex;
 }
 
 bool TimedOut(int ClockIndex) {
-	if (ClockIndex < int(StartTime.size()) && ClockIndex < int(TimeOutTime.size()) && (time(NULL)-StartTime[ClockIndex]) > TimeOutTime[ClockIndex] && TimeOutTime[ClockIndex] != -1) {
+	if (ClockIndex < int(StartTime.size()) && ClockIndex < int(TimeOutTime.size()) && (1e-9*double(MonotonicNanoseconds())-StartTime[ClockIndex]) > TimeOutTime[ClockIndex] && TimeOutTime[ClockIndex] != -1) {
 		return true;
 	} else {
 		return false;
@@ -577,7 +698,148 @@ double ElapsedTime(int ClockIndex) {
 	if (ClockIndex >= int(StartTime.size())) {
 		return FLAG;
 	}
-	return double(time(NULL)-StartTime[ClockIndex]);
+	return 1e-9*double(MonotonicNanoseconds())-StartTime[ClockIndex];
+}
+
+long long MonotonicNanoseconds() {
+	timespec Now;
+	clock_gettime(CLOCK_MONOTONIC,&Now);
+	return (long long)(Now.tv_sec)*1000000000LL+(long long)(Now.tv_nsec);
+}
+
+ScopedTimer::ScopedTimer(const char* Name) {
+	static ParameterHandle* WriteRunProfile = GetParameterHandle("Write run profile");
+	//Solve statistics are grouped by the open phases, so they are tracked for either report
+	static ParameterHandle* WriteSolveStatistics = GetParameterHandle("Write solve statistics");
+	Event = -1;
+	if (!WriteRunProfile->Bool && !WriteSolveStatistics->Bool) {
+		return;
+	}
+	ProfileEvent NewEvent;
+	NewEvent.Name = Name;
+	NewEvent.Parent = OpenProfileEvent;
+	NewEvent.Duration = -1;
+	NewEvent.Start = MonotonicNanoseconds();
+	ProfileEvents.push_back(NewEvent);
+	Event = int(ProfileEvents.size())-1;
+	OpenProfileEvent = Event;
+}
+
+ScopedTimer::~ScopedTimer() {
+	if (Event == -1) {
+		return;
+	}
+	ProfileEvents[Event].Duration = MonotonicNanoseconds()-ProfileEvents[Event].Start;
+	OpenProfileEvent = ProfileEvents[Event].Parent;
+}
+
+const char* CallingProfilePhase() {
+	if (OpenProfileEvent == -1 || ProfileEvents[OpenProfileEvent].Parent == -1) {
+		return "none";
+	}
+	return ProfileEvents[ProfileEvents[OpenProfileEvent].Parent].Name;
+}
+
+//Phases with the same name under the same parent phase are combined into one row of the table
+int WriteProfile() {
+	static ParameterHandle* WriteRunProfile = GetParameterHandle("Write run profile");
+	if (!WriteRunProfile->Bool || ProfileEvents.size() == 0) {
+		return SUCCESS;
+	}
+	vector<string> NodeName;
+	vector<int> NodeCalls;
+	vector<long long> NodeTotal;
+	vector<long long> NodeSelf;
+	vector<long long> NodeMax;
+	vector<vector<int> > NodeChildren(1);
+	map<pair<int,string>,int> NodeIndex;
+	vector<int> EventNode(ProfileEvents.size(),-1);
+	NodeName.push_back("Run");
+	NodeCalls.push_back(0);
+	NodeTotal.push_back(0);
+	NodeSelf.push_back(0);
+	NodeMax.push_back(0);
+	//Events are stored in start order, so a parent is always placed before its children
+	for (int i=0; i < int(ProfileEvents.size()); i++) {
+		if (ProfileEvents[i].Duration < 0) {
+			continue;
+		}
+		int Parent = 0;
+		if (ProfileEvents[i].Parent != -1) {
+			Parent = EventNode[ProfileEvents[i].Parent];
+			if (Parent == -1) {
+				continue;
+			}
+			NodeSelf[Parent] -= ProfileEvents[i].Duration;
+		}
+		pair<int,string> Key(Parent,ProfileEvents[i].Name);
+		map<pair<int,string>,int>::iterator MapIT = NodeIndex.find(Key);
+		int Node;
+		if (MapIT == NodeIndex.end()) {
+			Node = int(NodeName.size());
+			NodeIndex[Key] = Node;
+			NodeName.push_back(ProfileEvents[i].Name);
+			NodeCalls.push_back(0);
+			NodeTotal.push_back(0);
+			NodeSelf.push_back(0);
+			NodeMax.push_back(0);
+			NodeChildren.push_back(vector<int>());
+			NodeChildren[Parent].push_back(Node);
+		} else {
+			Node = MapIT->second;
+		}
+		EventNode[i] = Node;
+		NodeCalls[Node]++;
+		NodeTotal[Node] += ProfileEvents[i].Duration;
+		NodeSelf[Node] += ProfileEvents[i].Duration;
+		if (ProfileEvents[i].Duration > NodeMax[Node]) {
+			NodeMax[Node] = ProfileEvents[i].Duration;
+		}
+	}
+
+	ofstream Output;
+	if (!OpenOutput(Output,FOutputFilepath()+"Profile.txt")) {
+		return FAIL;
+	}
+	Output << "Phase\tCalls\tTotal (s)\tSelf (s)\tMean (ms)\tMax (ms)" << endl;
+	//Printing the phase tree depth first with children in the order they first ran
+	vector<pair<int,int> > Stack;
+	for (int i=int(NodeChildren[0].size())-1; i >= 0; i--) {
+		Stack.push_back(pair<int,int>(NodeChildren[0][i],0));
+	}
+	while (Stack.size() > 0) {
+		int Node = Stack.back().first;
+		int Depth = Stack.back().second;
+		Stack.pop_back();
+		Output << string(2*Depth,' ') << NodeName[Node] << "\t" << NodeCalls[Node] << "\t" << 1e-9*double(NodeTotal[Node]) << "\t" << 1e-9*double(NodeSelf[Node]) << "\t" << 1e-6*double(NodeTotal[Node])/NodeCalls[Node] << "\t" << 1e-6*double(NodeMax[Node]) << endl;
+		for (int i=int(NodeChildren[Node].size())-1; i >= 0; i--) {
+			Stack.push_back(pair<int,int>(NodeChildren[Node][i],Depth+1));
+		}
+	}
+	Output.close();
+	Output.clear();
+
+	//Writing complete events in the Chrome trace format, with times in microseconds from the first phase
+	if (!OpenOutput(Output,FOutputFilepath()+"ProfileTrace.json")) {
+		return FAIL;
+	}
+	long long Origin = ProfileEvents[0].Start;
+	Output.precision(15);
+	Output << "{\"traceEvents\":[";
+	bool First = true;
+	for (int i=0; i < int(ProfileEvents.size()); i++) {
+		if (EventNode[i] == -1) {
+			continue;
+		}
+		if (!First) {
+			Output << ",";
+		}
+		First = false;
+		Output << endl << "{\"name\":\"" << ProfileEvents[i].Name << "\",\"ph\":\"X\",\"pid\":" << getpid() << ",\"tid\":1,\"ts\":" << 1e-3*double(ProfileEvents[i].Start-Origin) << ",\"dur\":" << 1e-3*double(ProfileEvents[i].Duration) << "}";
+	}
+	Output << endl << "],\"displayTimeUnit\":\"ms\"}" << endl;
+	Output.close();
+	return SUCCESS;
 }
 
 int GetNumberOfLinesInFile(string Filename) {
@@ -610,6 +872,10 @@ bool FileExists(string InFilename) {
 }
 
 void AddLineToFile(const char* Filename,string InLine) {
+	if (FThreadOutput() != NULL) {
+		FThreadOutput()->FileLines.push_back(pair<string, string>(Filename,InLine));
+		return;
+	}
 	FileLineData[Filename].push_back(InLine);
 }
 
@@ -661,3 +927,223 @@ void ClearDirectory(string Filename) {
 	Command << GetParameter("perl directory") << " " << GetParameter("scripts directory") << "ClearDirectory.pl " <<  Filename;
 	system(Command.str().data());
 }
+
+bool NextCombination(vector<int>& Counter, int NumEntities) {
+	int Index = int(Counter.size())-1;
+	while (Index >= 0 && (Counter[Index]+1) >= (NumEntities-int(Counter.size())+1+Index)) {
+		Index--;
+	}
+	if (Index < 0) {
+		return false;
+	}
+	Counter[Index]++;
+	for (int j=Index+1; j < int(Counter.size()); j++) {
+		Counter[j] = Counter[j-1]+1;
+	}
+	return true;
+}
+
+int ForkWorkerProcesses(int NumWorkers, vector<int>& WorkerPids, vector<int>& WorkerPipes) {
+	//Flushing buffered output so it is not duplicated by the workers
+	cout.flush();
+	cerr.flush();
+	FLogFile().flush();
+	FlushErrorFile();
+	SyncErrorLog();
+
+	WorkerPids.assign(NumWorkers,-1);
+	WorkerPipes.assign(NumWorkers,-1);
+	for (int i=0; i < NumWorkers; i++) {
+		int Pipe[2];
+		if (pipe(Pipe) != 0) {
+			FErrorFile() << "Could not create pipe for worker process " << i << endl;
+			FlushErrorFile();
+			continue;
+		}
+		pid_t Pid = fork();
+		if (Pid == 0) {
+			close(Pipe[0]);
+			for (int j=0; j < i; j++) {
+				if (WorkerPipes[j] != -1) {
+					close(WorkerPipes[j]);
+				}
+			}
+			WorkerPids.assign(NumWorkers,-1);
+			WorkerPipes.assign(NumWorkers,-1);
+			WorkerPipes[i] = Pipe[1];
+			return i;
+		}
+		close(Pipe[1]);
+		if (Pid < 0) {
+			close(Pipe[0]);
+			FErrorFile() << "Could not fork worker process " << i << endl;
+			FlushErrorFile();
+			continue;
+		}
+		WorkerPids[i] = int(Pid);
+		WorkerPipes[i] = Pipe[0];
+	}
+	return -1;
+}
+
+bool WriteToPipe(int Pipe, const void* Buffer, int Length) {
+	const char* Current = (const char*)Buffer;
+	while (Length > 0) {
+		ssize_t Written = write(Pipe,Current,Length);
+		if (Written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		Current += Written;
+		Length -= int(Written);
+	}
+	return true;
+}
+
+bool ReadFromPipe(int Pipe, void* Buffer, int Length) {
+	char* Current = (char*)Buffer;
+	while (Length > 0) {
+		ssize_t Read = read(Pipe,Current,Length);
+		if (Read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (Read <= 0) {
+			return false;
+		}
+		Current += Read;
+		Length -= int(Read);
+	}
+	return true;
+}
+
+int NextReadyWorkerPipe(vector<int>& WorkerPipes) {
+	vector<pollfd> Descriptors;
+	vector<int> Workers;
+	for (int i=0; i < int(WorkerPipes.size()); i++) {
+		if (WorkerPipes[i] != -1) {
+			pollfd Descriptor;
+			Descriptor.fd = WorkerPipes[i];
+			Descriptor.events = POLLIN;
+			Descriptor.revents = 0;
+			Descriptors.push_back(Descriptor);
+			Workers.push_back(i);
+		}
+	}
+	if (Workers.size() == 0) {
+		return -1;
+	}
+	while (true) {
+		int Ready = poll(&Descriptors[0],nfds_t(Descriptors.size()),-1);
+		if (Ready < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			//A blocking read on the first open pipe still makes progress if poll itself fails
+			return Workers[0];
+		}
+		for (int i=0; i < int(Descriptors.size()); i++) {
+			if (Descriptors[i].revents != 0) {
+				return Workers[i];
+			}
+		}
+	}
+}
+
+void CloseWorkerPipe(int Pipe) {
+	if (Pipe != -1) {
+		close(Pipe);
+	}
+}
+
+int WaitForWorkerProcesses(vector<int>& WorkerPids) {
+	int Failures = 0;
+	for (int i=0; i < int(WorkerPids.size()); i++) {
+		if (WorkerPids[i] <= 0) {
+			Failures++;
+			continue;
+		}
+		int Status = 0;
+		while (waitpid(pid_t(WorkerPids[i]),&Status,0) < 0 && errno == EINTR);
+		if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0) {
+			Failures++;
+		}
+	}
+	return Failures;
+}
+
+int RunCommandFile(string Filename, int NumWorkers) {
+	vector<string> Commands;
+	FileLineReader Input;
+	if (!OpenLineReader(Input,Filename)) {
+		return -1;
+	}
+	StringField Line;
+	while (ReadLine(Input,Line)) {
+		if (Line.Length > 0) {
+			Commands.push_back(FieldToString(Line));
+		}
+	}
+	CloseLineReader(Input);
+	if (NumWorkers < 1) {
+		NumWorkers = 1;
+	}
+
+	//Flushing buffered output so it is not duplicated by the children
+	cout.flush();
+	cerr.flush();
+	FLogFile().flush();
+	FlushErrorFile();
+	SyncErrorLog();
+
+	int Failures = 0;
+	int Running = 0;
+	int Next = 0;
+	while (Next < int(Commands.size()) || Running > 0) {
+		//Starting commands until every worker slot is busy
+		while (Next < int(Commands.size()) && Running < NumWorkers) {
+			pid_t Pid = fork();
+			if (Pid == 0) {
+				execl("/bin/sh","sh","-c",Commands[Next].data(),(char*)NULL);
+				_exit(127);
+			}
+			if (Pid < 0) {
+				FErrorFile() << "Could not fork process for command: " << Commands[Next] << endl;
+				FlushErrorFile();
+				Failures++;
+			} else {
+				Running++;
+			}
+			Next++;
+		}
+		if (Running == 0) {
+			break;
+		}
+		int Status = 0;
+		pid_t Finished = waitpid(-1,&Status,0);
+		if (Finished < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		Running--;
+		if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0) {
+			Failures++;
+		}
+	}
+	return Failures;
+}
+
+void ExitWorkerProcess(int Pipe, int Status) {
+	cout.flush();
+	cerr.flush();
+	FLogFile().flush();
+	FlushErrorFile();
+	SyncErrorLog();
+	if (Pipe != -1) {
+		close(Pipe);
+	}
+	_exit(Status);
+}
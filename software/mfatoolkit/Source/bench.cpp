@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+//    MFAToolkit: Software for running flux balance analysis on stoichiometric models
+//    Software developer: Christopher Henry (chenry@mcs.anl.gov), MCS Division, Argonne National Laboratory
+//    Copyright (C) 2007  Argonne National Laboratory/University of Chicago. All Rights Reserved.
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//    For more information on MFAToolkit, see <http://bionet.mcs.anl.gov/index.php/Model_analysis>.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MFAToolkit.h"
+#include "ModelFixture.h"
+#include <sys/resource.h>
+
+using namespace std;
+
+//Benchmark driver built by "make bench". Each case runs in a fresh forked process so repeats do not share caches, and memory is reported as the growth over the fork-time footprint
+//Usage: mfatoolkit_bench <results file> [parameterfile <file>]... [model <Model.tbl>] [synthetic <reactions>] [repeats <count>] [cases <case;case...>]
+
+#define BENCHMARK_NUTRIENTS 10
+#define BENCHMARK_BIOMASS_COMPONENTS 20
+
+//Linear congruential generator, so a synthetic model depends only on its seed and size
+int BenchmarkRandom(unsigned int& State, int Range) {
+	State = State*1103515245+12345;
+	return int((State >> 16) & 0x7fff) % Range;
+}
+
+string BenchmarkCompound(int Index) {
+	char Buffer[32];
+	sprintf(Buffer,"cpdS%05d",Index);
+	return Buffer;
+}
+
+string BenchmarkReaction(int Index) {
+	char Buffer[32];
+	sprintf(Buffer,"rxnS%05d",Index);
+	return Buffer;
+}
+
+//Writes a synthetic biochemistry, model, media and parameter file into Directory and returns the model filename
+//Every compound has the same formula and every reaction converts as many molecules as it makes, so all reactions except biomass are mass balanced
+//Compound j is always made by a reaction from lower numbered compounds, so the whole network can be reached from the nutrients
+//About one reaction in fifty is left out of the model but kept in the database so gap filling has work to do
+string GenerateSyntheticModel(string Directory, int NumReactions, unsigned int Seed) {
+	unsigned int State = Seed;
+	int NumCompounds = NumReactions*6/10;
+	if (NumCompounds < BENCHMARK_NUTRIENTS+BENCHMARK_BIOMASS_COMPONENTS) {
+		NumCompounds = BENCHMARK_NUTRIENTS+BENCHMARK_BIOMASS_COMPONENTS;
+	}
+	if (NumReactions < NumCompounds) {
+		NumReactions = NumCompounds;
+	}
+
+	ModelFixture Fixture;
+	for (int i=0; i < NumCompounds; i++) {
+		ostringstream Line;
+		Line << BenchmarkCompound(i) << "\tSynthetic compound " << i << "\t" << BenchmarkCompound(i) << "\tC6H12O6\t0\t" << -100-BenchmarkRandom(State,200) << "\t2\t180";
+		Fixture.Compounds.push_back(Line.str());
+	}
+	Fixture.Compounds.push_back("cpdSbiomass\tBiomass\tcpdSbiomass\tC6H12O6\t0\t0\t0\t180");
+
+	vector<string> Equations(NumReactions);
+	vector<bool> Reversible(NumReactions,false);
+	//Transporters for the nutrients come first
+	for (int i=0; i < BENCHMARK_NUTRIENTS; i++) {
+		Equations[i] = "(1) "+BenchmarkCompound(i)+"[e] <=> (1) "+BenchmarkCompound(i)+"[c]";
+		Reversible[i] = true;
+	}
+	for (int i=BENCHMARK_NUTRIENTS; i < NumReactions; i++) {
+		int Product = i;
+		if (i >= NumCompounds) {
+			Product = BENCHMARK_NUTRIENTS+BenchmarkRandom(State,NumCompounds-BENCHMARK_NUTRIENTS);
+		}
+		int ReactantOne = BenchmarkRandom(State,Product);
+		Equations[i] = "(1) "+BenchmarkCompound(ReactantOne)+"[c]";
+		string Products = "(1) "+BenchmarkCompound(Product)+"[c]";
+		if (Product > 1 && BenchmarkRandom(State,2) == 0) {
+			int ReactantTwo = BenchmarkRandom(State,Product);
+			if (ReactantTwo != ReactantOne) {
+				Equations[i].append(" + (1) "+BenchmarkCompound(ReactantTwo)+"[c]");
+				Products.append(" + (1) "+BenchmarkCompound(BenchmarkRandom(State,Product))+"[c]");
+			}
+		}
+		Reversible[i] = (BenchmarkRandom(State,10) < 3);
+		Equations[i].append(Reversible[i] ? " <=> " : " => ");
+		Equations[i].append(Products);
+	}
+	string BiomassEquation;
+	for (int i=0; i < BENCHMARK_BIOMASS_COMPONENTS; i++) {
+		if (i > 0) {
+			BiomassEquation.append(" + ");
+		}
+		BiomassEquation.append("(1) "+BenchmarkCompound(NumCompounds-1-i*(NumCompounds-BENCHMARK_NUTRIENTS)/BENCHMARK_BIOMASS_COMPONENTS)+"[c]");
+	}
+	BiomassEquation.append(" => (1) cpdSbiomass[c]");
+
+	for (int i=0; i < NumReactions; i++) {
+		ostringstream Line;
+		Line << BenchmarkReaction(i) << "\tSynthetic reaction " << i << "\t" << Equations[i] << "\t" << (Reversible[i] ? 0 : -10) << "\t2";
+		Fixture.Reactions.push_back(Line.str());
+	}
+	Fixture.Reactions.push_back("bio00001\tBiomass\t"+BiomassEquation+"\t0\t0");
+
+	for (int i=0; i < NumReactions; i++) {
+		if (i >= BENCHMARK_NUTRIENTS && BenchmarkRandom(State,50) == 0) {
+			continue;
+		}
+		ostringstream Line;
+		Line << BenchmarkReaction(i) << ";" << (Reversible[i] ? "<=>" : "=>") << ";c;";
+		if (BenchmarkRandom(State,10) == 0) {
+			Line << "(peg." << i << " or peg." << i+NumReactions << ")";
+		} else {
+			Line << "peg." << i;
+		}
+		Fixture.ModelReactions.push_back(Line.str());
+	}
+	Fixture.ModelReactions.push_back("bio00001;=>;c;UNIVERSAL");
+
+	const char* MediaColumns[] = {NULL,"DRAIN_FLUX","100","-100","e"};
+	Fixture.Media = "BenchmarkMedia\tBenchmarkMedia";
+	for (int j=0; j < 5; j++) {
+		Fixture.Media.append("\t");
+		for (int i=0; i < BENCHMARK_NUTRIENTS; i++) {
+			if (i > 0) {
+				Fixture.Media.append("|");
+			}
+			Fixture.Media.append(MediaColumns[j] == NULL ? BenchmarkCompound(i) : string(MediaColumns[j]));
+		}
+	}
+
+	Fixture.ParameterFile = "BenchmarkParameters.txt";
+	Fixture.ParameterGroup = "Benchmark parameters";
+	Fixture.Parameters.push_back(pair<string,string>("Network output location",Directory));
+	Fixture.Parameters.push_back(pair<string,string>("output folder","Benchmark/"));
+	Fixture.Parameters.push_back(pair<string,string>("user bounds filename","BenchmarkMedia"));
+	Fixture.Parameters.push_back(pair<string,string>("objective","MAX;FLUX;bio00001;none;1"));
+	Fixture.Parameters.push_back(pair<string,string>("exchange species","cpdSbiomass[c]:-10000:0"));
+	Fixture.Parameters.push_back(pair<string,string>("Balanced reactions in gap filling only","1"));
+	Fixture.Parameters.push_back(pair<string,string>("Recursive MILP solution limit","5"));
+	Fixture.Parameters.push_back(pair<string,string>("pathway starting compounds",BenchmarkCompound(0)));
+	Fixture.Parameters.push_back(pair<string,string>("pathway target compounds",BenchmarkCompound(NumCompounds-1)));
+	Fixture.Parameters.push_back(pair<string,string>("max search time","60"));
+	Fixture.Parameters.push_back(pair<string,string>("Print overall reaction data","0"));
+	return WriteModelFixture(Directory,Fixture);
+}
+
+//Runs the setup for one case untimed and returns the time spent in the phase being measured
+//The case runs in a process that exits right after, so nothing built here is freed
+int RunBenchmarkCase(string Case, string ModelFilename, long long& Elapsed) {
+	long long Start = 0;
+	if (Case.compare("stringdb") == 0) {
+		Start = MonotonicNanoseconds();
+		if (LoadStringDB() != SUCCESS) {
+			return FAIL;
+		}
+		for (int i=0; i < GetStringDB()->number_of_tables(); i++) {
+			GetStringDB()->get_table(i);
+		}
+		Elapsed = MonotonicNanoseconds()-Start;
+		return SUCCESS;
+	}
+
+	Data* Model = new Data(0);
+	Model->ClearData("NAME",STRING);
+	Model->AddData("NAME",RemoveExtension(RemovePath(ModelFilename)).data(),STRING);
+	Start = MonotonicNanoseconds();
+	if (Model->LoadSystem(ModelFilename) == FAIL) {
+		return FAIL;
+	}
+	Elapsed = MonotonicNanoseconds()-Start;
+	if (Case.compare("load") == 0) {
+		return SUCCESS;
+	}
+
+	if (Case.compare("pathways") == 0) {
+		Start = MonotonicNanoseconds();
+		Model->SearchForPathways();
+		Elapsed = MonotonicNanoseconds()-Start;
+		return SUCCESS;
+	}
+
+	OptimizationParameter* Parameters = ReadParameters();
+	MFAProblem* Problem = new MFAProblem();
+	if (Case.compare("gapfill") == 0) {
+		Start = MonotonicNanoseconds();
+		int Status = Problem->GapFilling(Model,Parameters,"Benchmark");
+		Elapsed = MonotonicNanoseconds()-Start;
+		return Status;
+	}
+
+	Start = MonotonicNanoseconds();
+	if (Problem->BuildMFAProblem(Model,Parameters) != SUCCESS) {
+		return FAIL;
+	}
+	Elapsed = MonotonicNanoseconds()-Start;
+	if (Case.compare("build") == 0) {
+		return SUCCESS;
+	}
+
+	string Note("Benchmark");
+	if (Case.compare("tightbounds") == 0) {
+		Start = MonotonicNanoseconds();
+		int Status = Problem->FindTightBounds(Model,Parameters,Note);
+		Elapsed = MonotonicNanoseconds()-Start;
+		return Status;
+	}
+
+	if (Problem->ConvertStringToObjective(GetParameter("objective"),Model) == NULL) {
+		return FAIL;
+	}
+	Start = MonotonicNanoseconds();
+	if (Problem->LoadSolver(false) != SUCCESS) {
+		return FAIL;
+	}
+	Elapsed = MonotonicNanoseconds()-Start;
+	if (Case.compare("loadsolver") == 0) {
+		return SUCCESS;
+	}
+
+	if (Case.compare("fba") == 0) {
+		double ObjectiveValue = 0;
+		Start = MonotonicNanoseconds();
+		int Status = Problem->OptimizeSingleObjective(Model,Parameters,GetParameter("objective"),false,false,ObjectiveValue,Note);
+		Elapsed = MonotonicNanoseconds()-Start;
+		return Status;
+	}
+
+	if (Case.compare("geneko") == 0) {
+		//Every gene is knocked out alone through the same screen the knockout analysis runs, so its workers and knockout cache are measured too
+		Start = MonotonicNanoseconds();
+		int Status = Problem->CombinatorialKO(1,Model,false);
+		Elapsed = MonotonicNanoseconds()-Start;
+		return Status;
+	}
+
+	FErrorFile() << "Unrecognized benchmark case: " << Case << endl;
+	FlushErrorFile();
+	return FAIL;
+}
+
+int main(int argc, char **argv) {
+	SetProgramPath(argv[0]);
+	SetParameter("output index","0");
+	SetParameter("Error filename","stderr.log");
+	setVerbose(false);
+	if (argc < 2) {
+		cout << "Insufficient arguments! Usage: mfatoolkit_bench <results file> [parameterfile <file>] [model <Model.tbl>] [synthetic <reactions>] [repeats <count>] [cases <case;case...>]" << endl;
+		return 1;
+	}
+	string ResultsFilename(argv[1]);
+	vector<string> ParameterFiles;
+	string ModelFilename;
+	int SyntheticReactions = 2000;
+	int Repeats = 5;
+	string CaseList("stringdb;load;build;loadsolver;fba;tightbounds;geneko;gapfill;pathways");
+	for (int i=2; i < argc-1; i += 2) {
+		string Argument(argv[i]);
+		if (Argument.compare("parameterfile") == 0) {
+			ParameterFiles.push_back(argv[i+1]);
+		} else if (Argument.compare("model") == 0) {
+			ModelFilename.assign(argv[i+1]);
+		} else if (Argument.compare("synthetic") == 0) {
+			SyntheticReactions = atoi(argv[i+1]);
+		} else if (Argument.compare("repeats") == 0) {
+			Repeats = atoi(argv[i+1]);
+		} else if (Argument.compare("cases") == 0) {
+			CaseList.assign(argv[i+1]);
+		}
+	}
+	if (Repeats < 1) {
+		Repeats = 1;
+	}
+
+	LoadParameterFile("../etc/Defaults.txt");
+	if (ModelFilename.length() == 0) {
+		//The synthetic model and its outputs go to a temporary directory so the database tree is left untouched
+		char Template[] = "/tmp/mfatoolkit_bench.XXXXXX";
+		if (mkdtemp(Template) == NULL) {
+			cout << "Could not create a directory for the synthetic model" << endl;
+			return 1;
+		}
+		string Directory = string(Template)+"/";
+		ModelFilename = GenerateSyntheticModel(Directory,SyntheticReactions,12345);
+		if (ModelFilename.length() == 0) {
+			cout << "Could not write synthetic model to " << Directory << endl;
+			return 1;
+		}
+		LoadParameterFile(Directory+"BenchmarkParameters.txt");
+	}
+	//Parameter files given on the command line are read last so they override the synthetic model settings
+	for (int i=0; i < int(ParameterFiles.size()); i++) {
+		LoadParameterFile(ParameterFiles[i]);
+	}
+	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+	if (Initialize() != SUCCESS) {
+		cout << "Could not initialize the toolkit" << endl;
+		return 1;
+	}
+
+	ofstream Output;
+	if (!OpenOutput(Output,ResultsFilename)) {
+		return 1;
+	}
+	Output << "Case\tModel\tRepeats\tFailures\tMedian (s)\tMin (s)\tMax (s)\tPeak RSS increase (KB)" << endl;
+	vector<string>* Cases = StringToStrings(CaseList,";,");
+	for (int i=0; i < int(Cases->size()); i++) {
+		vector<double> Times;
+		long MaxRSS = 0;
+		int Failures = 0;
+		for (int j=0; j < Repeats; j++) {
+			vector<int> WorkerPids;
+			vector<int> WorkerPipes;
+			int Worker = ForkWorkerProcesses(1,WorkerPids,WorkerPipes);
+			if (Worker == 0) {
+				//The forked process starts with the parent's footprint, including the loaded database, so only the growth past that is reported
+				rusage Usage;
+				getrusage(RUSAGE_SELF,&Usage);
+				long BaselineRSS = Usage.ru_maxrss;
+				long long Elapsed = 0;
+				int Status = RunBenchmarkCase((*Cases)[i],ModelFilename,Elapsed);
+				getrusage(RUSAGE_SELF,&Usage);
+				long RSS = Usage.ru_maxrss-BaselineRSS;
+				WriteToPipe(WorkerPipes[0],&Status,sizeof(Status));
+				WriteToPipe(WorkerPipes[0],&Elapsed,sizeof(Elapsed));
+				WriteToPipe(WorkerPipes[0],&RSS,sizeof(RSS));
+				ExitWorkerProcess(WorkerPipes[0],0);
+			}
+			int Status = FAIL;
+			long long Elapsed = 0;
+			long RSS = 0;
+			if (!ReadFromPipe(WorkerPipes[0],&Status,sizeof(Status)) || !ReadFromPipe(WorkerPipes[0],&Elapsed,sizeof(Elapsed)) || !ReadFromPipe(WorkerPipes[0],&RSS,sizeof(RSS))) {
+				Status = FAIL;
+			}
+			CloseWorkerPipe(WorkerPipes[0]);
+			if (WaitForWorkerProcesses(WorkerPids) > 0 || Status != SUCCESS) {
+				Failures++;
+				continue;
+			}
+			Times.push_back(1e-9*double(Elapsed));
+			if (RSS > MaxRSS) {
+				MaxRSS = RSS;
+			}
+		}
+		Output << (*Cases)[i] << "\t" << ModelFilename << "\t" << Repeats << "\t" << Failures;
+		if (Times.size() > 0) {
+			sort(Times.begin(),Times.end());
+			double Median = Times[Times.size()/2];
+			if (Times.size() % 2 == 0) {
+				Median = 0.5*(Times[Times.size()/2-1]+Times[Times.size()/2]);
+			}
+			Output << "\t" << Median << "\t" << Times[0] << "\t" << Times[Times.size()-1] << "\t" << MaxRSS << endl;
+		} else {
+			Output << "\tNA\tNA\tNA\tNA" << endl;
+		}
+		cout << (*Cases)[i] << " done" << endl;
+	}
+	delete Cases;
+	Output.close();
+
+	Cleanup();
+	return 0;
+}
@@ -24,12 +24,21 @@
 using namespace std;
 
 int main ( int argc, char **argv) {
+	//Client mode hands the job to a running server and skips all initialization
+	if (argc >= 3 && string(argv[1]).compare("client") == 0) {
+		vector<string> Arguments;
+		Arguments.push_back(argv[0]);
+		for (int i=3; i < argc; i++) {
+			Arguments.push_back(argv[i]);
+		}
+		return RunJobClient(argv[2],Arguments);
+	}
 	SetProgramPath(argv[0]);
 	SetParameter("output index","0");
 	SetParameter("Error filename","stderr.log");
 	setVerbose(false);
 	if (argc == 1) {
-		cout << "Insufficient arguments! Usage: mfatoolkit parameterfile <new filename> resetparameter <parameter name> <parameter value> LoadCentralSystem <model name> -verbose" << endl;
+		cout << "Insufficient arguments! Usage: mfatoolkit parameterfile <new filename> resetparameter <parameter name> <parameter value> LoadCentralSystem <model name> -verbose; mfatoolkit ... server <socket>; mfatoolkit client <socket> <job arguments>" << endl;
 	} else {
 		vector<string> Arguments;
 		for (int i=0; i < argc; i++) {
@@ -42,15 +51,6 @@ int main ( int argc, char **argv) {
 	Cleanup();
 
 	//Moving the output
-	string OutputPath = FOutputFilepath();
-	OutputPath = OutputPath.substr(0,OutputPath.length()-1);
-	if (GetParameter("Network output location").compare("none") != 0 && GetParameter("Network output location").length() > 0) {
-		if (GetParameter("os").compare("windows") == 0) {
-			system(("move "+OutputPath+" "+GetDatabaseDirectory(false)).data());
-		} else {
-			system(("cp -r  "+OutputPath+" "+GetDatabaseDirectory(false)).data());
-			system(("rm -rf "+OutputPath).data());
-		}
-	}
+	MoveNetworkOutput();
 	return 0;
 };
@@ -14,6 +14,11 @@
 #include <iomanip>
 #include <functional>
 #include <algorithm>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 //using namespace std;
 using std::fstream;
@@ -55,29 +60,22 @@ namespace STRINGDB {
 			NewVect->push_back(FullString);
 			return NewVect;
 		}
-		string Buff(FullString);
-		int Location;
-		do {
-			Location = int(Buff.find_first_of(Delim));
-			if (Location != -1) {
-				if (Location == 0) {
-					if (!TreatConsecutiveDelimAsOne) {
-						string NewString;
-						NewVect->push_back(NewString);
-					}
-					Buff = Buff.substr(Location+1, Buff.length()-(Location+1));
-				} else {
-					string NewString = Buff.substr(0, Location);
-					NewVect->push_back(NewString);
-					Buff = Buff.substr(Location+1, Buff.length()-(Location+1));
+		//Single pass over the line; each field is copied once
+		bool IsDelimiter[256] = {false};
+		for (const char* Current = Delim; *Current != 0; Current++) {
+			IsDelimiter[(unsigned char)(*Current)] = true;
+		}
+		const char* Data = FullString.data();
+		int Length = int(FullString.length());
+		int Start = 0;
+		for (int i=0; i <= Length; i++) {
+			if (i == Length || IsDelimiter[(unsigned char)(Data[i])]) {
+				if (i > Start || !TreatConsecutiveDelimAsOne) {
+					NewVect->push_back(string(Data+Start,i-Start));
 				}
+				Start = i+1;
 			}
-		} while(Location != -1);
-		
-		if (Buff.length() != 0 || !TreatConsecutiveDelimAsOne) {
-			NewVect->push_back(Buff);
 		}
-		
 		return NewVect;
 	}
 	//DONE
@@ -85,12 +83,56 @@ namespace STRINGDB {
 		string Buff = GetFileLine(Input);
 		return StringToStrings(Buff, Delim, TreatConsecutiveDelimAsOne);
 	}
+	//Extracts a single delimited field without splitting the rest of the line
+	bool GetField(const string& FullString, const char* Delim, int Column, string& Field) {
+		string::size_type Start = 0;
+		for (int i=0; i < Column; i++) {
+			Start = FullString.find_first_of(Delim,Start);
+			if (Start == string::npos) {
+				return false;
+			}
+			Start++;
+		}
+		string::size_type End = FullString.find_first_of(Delim,Start);
+		if (End == string::npos) {
+			Field = FullString.substr(Start);
+		} else {
+			Field = FullString.substr(Start,End-Start);
+		}
+		return true;
+	}
+	//FNV-1a hash used by the snapshot indexes
+	unsigned HashString(const char* data,unsigned length,unsigned hash = 2166136261u) {
+		for (unsigned i=0; i < length; i++) {
+			hash ^= (unsigned char)(data[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+	//Appends a length prefixed, null terminated string to the snapshot pool and returns its offset
+	unsigned AddToPool(vector<char>& pool,map<string,unsigned>& poolOffsets,const string& value) {
+		map<string,unsigned>::iterator IT = poolOffsets.find(value);
+		if (IT != poolOffsets.end()) {
+			return IT->second;
+		}
+		unsigned offset = unsigned(pool.size());
+		unsigned length = unsigned(value.length());
+		pool.insert(pool.end(),(const char*)&length,(const char*)&length+sizeof(unsigned));
+		pool.insert(pool.end(),value.begin(),value.end());
+		pool.push_back(0);
+		while (pool.size() % sizeof(unsigned) != 0) {
+			pool.push_back(0);
+		}
+		poolOffsets[value] = offset;
+		return offset;
+	}
 }
 
 //***************************************************************************************
 //StringDB Objects
-StringDB::StringDB(string INfilename,string INprogramPath) {
+StringDB::StringDB(string INfilename,string INprogramPath,bool INuseSnapshots) {
 	set_programPath(INprogramPath); 
+	useSnapshots = INuseSnapshots;
 	this->loadDatabase(this->checkFilename(INfilename));
 };
 //DONE
@@ -132,13 +174,18 @@ string StringDB::checkFilename(string INfilename) {
 //DONE
 int StringDB::loadDatabase(string INfilename) {
 	filename = INfilename;
+	//The spec file is rewritten for every job, so it is always parsed from text
+	bool snapshots = useSnapshots;
+	useSnapshots = false;
 	int status = this->loadDatabaseTable("DATABASESPECS","SINGLEFILE","Name",filename,"","\t",";",STRINGDB::StringToStrings("Table name","|",false),true);
 	if (status == FAIL) {
 		this->print_error("failed to load database specs","get_attribute");
+		useSnapshots = snapshots;
 		return FAIL;
 	}
+	useSnapshots = snapshots;
+	//Tables are only registered here; each one is read the first time it is requested
 	for (int i=0; i < this->get_table("DATABASESPECS")->number_of_objects(); i++) {
-		cout << "Loading Database File\t"<<this->get_table("DATABASESPECS")->get_object(i)->get("Filename") << endl;
 		this->loadDatabaseTable(this->get_table("DATABASESPECS")->get_object(i));
 	}
 	return SUCCESS;
@@ -156,14 +203,25 @@ StringDBObject* StringDB::get_object(string table,string attribute,string value)
 	return this->get_table(table)->get_object(attribute,value);
 };
 //DONE
-list<StringDBObject*>* StringDB::get_objects(string table,string attribute,string value) {
+StringDBObjectSpan StringDB::get_objects(string table,string attribute,string value) {
 	if (this->get_table(table) == NULL) {
 		this->print_error("requested table not found","get_objects");
-		return NULL;
+		StringDBObjectSpan empty = {NULL,0};
+		return empty;
 	}
 	return this->get_table(table)->get_objects(attribute,value);
 };
 //DONE
+int StringDB::get_objects(string table,string attribute,const vector<string>& values,vector<StringDBObject*>& results) {
+	StringDBTable* currentTable = this->get_table(table);
+	if (currentTable == NULL) {
+		this->print_error("requested table not found","get_objects");
+		results.assign(values.size(),NULL);
+		return FAIL;
+	}
+	return currentTable->get_objects(currentTable->find_attribute(attribute),values,results);
+};
+//DONE
 int StringDB::loadDatabaseTable(StringDBObject* tableObject) {
 	string delimiter = tableObject->get("Delimiter");
 	string itemDelimiter = tableObject->get("Item delimiter");
@@ -199,6 +257,7 @@ StringDBTable* StringDB::get_table(string table) {
 };
 //DONE
 StringDBTable* StringDB::get_table(int table) {
+	this->tables[table]->load_table();
 	return this->tables[table];
 };
 string StringDB::get_programPath() {
@@ -208,22 +267,28 @@ int StringDB::set_programPath(string input) {
 	programPath = input;
 	return SUCCESS;
 };
+bool StringDB::get_useSnapshots() {
+	return useSnapshots;
+};
 //***************************************************************************************
 //StringDBTable Objects
 StringDBTable::StringDBTable(StringDB* INparentDB,string INname,string INtype,string INidColumn,string INfilename,string INpath,string INdelimiter,string INitemDelimiter,vector<string>* INindexedAttributes,bool unique) {
 	this->parentDB = INparentDB;
+	this->snapshot = NULL;
 	this->resetIterator();
 	this->set_name(INname);
 	this->set_type(INtype);
 	this->set_id_column(INidColumn);
+	this->set_filename(INfilename);
+	this->set_path(INpath);
+	this->set_delimiter(INdelimiter);
+	this->set_itemDelimiter(INitemDelimiter);
+	this->set_indexed_attributes(INindexedAttributes);
+	this->uniqueData = unique;
+	this->tableLoaded = true;
 	if (INfilename.length() > 0 && INtype.compare("SINGLEFILE") == 0) {
-		loadFromFile(INfilename,INpath,INdelimiter,INitemDelimiter,INindexedAttributes,unique);
+		this->tableLoaded = false;
 	} else {
-		this->set_filename(INfilename);
-		this->set_path(INpath);
-		this->set_delimiter(INdelimiter);
-		this->set_itemDelimiter(INitemDelimiter);
-		this->set_indexed_attributes(INindexedAttributes);
 		this->add_atribute(INidColumn,true);
 	}
 };
@@ -233,12 +298,15 @@ StringDBTable::~StringDBTable() {
 		StringDBObject* newObject = this->get_object(i);
 		delete newObject;
 	}
-	for (map<int,map<string,list<StringDBObject*>*,std::less<string> >*,std::less<int> >::iterator IT = attributeHash.begin(); IT != attributeHash.end(); IT++) {
-		this->clear_attribute_hash(IT->first);
+	for (int i=0; i < int(attributeIndexes.size()); i++) {
+		this->clear_attribute_hash(i);
 	}
 	if (indexed_attributes != NULL) {
 		delete indexed_attributes;
 	}
+	if (snapshot != NULL) {
+		delete snapshot;
+	}
 };
 
 //DONE
@@ -268,12 +336,30 @@ int StringDBTable::loadFromFile(string INfilename,string INpath,string INdelimit
 		INindexedAttributes = this->get_indexed_attributes();
 	}
 	this->set_indexed_attributes(INindexedAttributes);
-	ifstream input(INfilename.data());
-	if (!input.is_open()) {
+	bool useSnapshot = (this->parentDB != NULL && this->parentDB->get_useSnapshots());
+	string snapshotFilename = INfilename+".snapshot";
+	unsigned signature = this->snapshot_signature(unique);
+	if (useSnapshot) {
+		StringDBSnapshot* newSnapshot = new StringDBSnapshot();
+		if (newSnapshot->open_snapshot(snapshotFilename,INfilename,signature) == SUCCESS) {
+			if (this->snapshot != NULL) {
+				delete this->snapshot;
+			}
+			this->snapshot = newSnapshot;
+			return this->loadFromSnapshot();
+		}
+		delete newSnapshot;
+	}
+	if (recordInput.is_open()) {
+		recordInput.close();
+	}
+	recordInput.clear();
+	recordInput.open(INfilename.data());
+	if (!recordInput.is_open()) {
 		this->print_error("could not open table file "+INfilename,"loadFromFile");
 		return FAIL;
 	}
-	string Buff = STRINGDB::GetFileLine(input);
+	string Buff = STRINGDB::GetFileLine(recordInput);
 	if (Buff.length() == 0) {
 		this->print_error("no headers in file","loadFromFile");
 		return FAIL;
@@ -290,28 +376,201 @@ int StringDBTable::loadFromFile(string INfilename,string INpath,string INdelimit
 		this->add_atribute((*strings)[i],indexed);
 	}
 	delete strings;
-	while (!input.eof()) {
-		string Buff = STRINGDB::GetFileLine(input);
+	//Only the id column is read now; each line's offset is kept so its body can be parsed when first used
+	int idAttribute = this->find_attribute(this->get_id_column());
+	for (int i=0; i < this->number_of_attributes(); i++) {
+		if (i != idAttribute && this->get_attribute_index(i) != NULL) {
+			this->deferredAttributes.insert(i);
+		}
+	}
+	while (!recordInput.eof()) {
+		long long offset = (long long)(recordInput.tellg());
+		string Buff = STRINGDB::GetFileLine(recordInput);
 		if (Buff.length() > 0) {
-			strings = STRINGDB::StringToStrings(Buff, delimiter.data(), false);
-			StringDBObject* newObject = new StringDBObject(this);
-			int maxIndex = int(strings->size());
-			if (maxIndex > this->number_of_attributes()) {
-				maxIndex = this->number_of_attributes();
-			}
-			for (int i=0; i < maxIndex; i++) {
-				vector<string>* stringsTwo = STRINGDB::StringToStrings((*strings)[i],itemDelimiter.data(),false);
+			StringDBObject* newObject = new StringDBObject(this,int(records.size()));
+			records.push_back(newObject);
+			recordOffsets.push_back(offset);
+			string field;
+			if (idAttribute != -1 && STRINGDB::GetField(Buff,delimiter.data(),idAttribute,field)) {
+				vector<string>* stringsTwo = STRINGDB::StringToStrings(field,itemDelimiter.data(),false);
 				for (int j=0; j < int(stringsTwo->size()); j++) {
-					newObject->set(i,(*stringsTwo)[j],-1,unique);
+					this->add_object_data_to_hash(idAttribute,(*stringsTwo)[j],newObject);
 				}
 				delete stringsTwo;
 			}
-			delete strings;
-			newObject->set_loaded(true);
-			this->add_object(newObject);
+			objects.push_back(newObject);
 		}
 	}
-	input.close();
+	recordInput.clear();
+	this->resetIterator();
+	if (useSnapshot) {
+		StringDBSnapshot::write_snapshot(this,snapshotFilename,INfilename,signature);
+	}
+	return SUCCESS;
+};
+//DONE
+int StringDBTable::load_table() {
+	if (this->tableLoaded) {
+		return SUCCESS;
+	}
+	this->tableLoaded = true;
+	cout << "Loading Database File\t" << this->get_filename() << endl;
+	return this->loadFromFile(this->get_filename(),this->get_path(),this->get_delimiter(),this->get_itemDelimiter(),this->get_indexed_attributes(),this->uniqueData);
+};
+//DONE
+int StringDBTable::load_record(StringDBObject* object,int record) {
+	if (record < 0 || record >= int(records.size())) {
+		return FAIL;
+	}
+	object->sync_with_attributes();
+	object->set_loaded(true);
+	if (this->snapshot != NULL) {
+		for (int j=0; j < int(snapshotColumns.size()); j++) {
+			vector<string>* objectData = object->getAll(snapshotColumns[j]);
+			int count = snapshot->number_of_values(record,j);
+			objectData->reserve(objectData->size()+count);
+			for (int k=0; k < count; k++) {
+				unsigned length = 0;
+				const char* value = snapshot->get_value(record,j,k,length);
+				objectData->push_back(string(value,length));
+			}
+		}
+		return SUCCESS;
+	}
+	recordInput.clear();
+	recordInput.seekg(std::streamoff(recordOffsets[record]));
+	string Buff = STRINGDB::GetFileLine(recordInput);
+	vector<string>* strings = STRINGDB::StringToStrings(Buff, delimiter.data(), false);
+	int maxIndex = int(strings->size());
+	if (maxIndex > this->number_of_attributes()) {
+		maxIndex = this->number_of_attributes();
+	}
+	for (int i=0; i < maxIndex; i++) {
+		vector<string>* objectData = object->getAll(i);
+		vector<string>* stringsTwo = STRINGDB::StringToStrings((*strings)[i],itemDelimiter.data(),false);
+		for (int j=0; j < int(stringsTwo->size()); j++) {
+			bool add = true;
+			for (int k=0; uniqueData && k < int(objectData->size()); k++) {
+				if ((*objectData)[k].compare((*stringsTwo)[j]) == 0) {
+					add = false;
+					break;
+				}
+			}
+			if (add) {
+				objectData->push_back((*stringsTwo)[j]);
+			}
+		}
+		delete stringsTwo;
+	}
+	delete strings;
+	return SUCCESS;
+};
+//Parses every record body and completes every deferred index, then closes the table file so no later read depends on its shared offset
+int StringDBTable::load_all_records() {
+	if (this->load_table() != SUCCESS) {
+		return FAIL;
+	}
+	vector<int> attributes(deferredAttributes.begin(),deferredAttributes.end());
+	for (int i=0; i < int(attributes.size()); i++) {
+		this->complete_attribute_hash(attributes[i]);
+	}
+	for (int i=0; i < int(records.size()); i++) {
+		records[i]->load_body();
+	}
+	if (recordInput.is_open()) {
+		recordInput.close();
+	}
+	return SUCCESS;
+};
+//DONE
+StringDBIndex* StringDBTable::get_attribute_index(int attribute) {
+	if (attribute < 0 || attribute >= int(attributeIndexes.size())) {
+		return NULL;
+	}
+	return attributeIndexes[attribute];
+};
+//DONE
+StringDBIndexEntry* StringDBTable::load_deferred_key(int attribute,const string& value) {
+	StringDBIndex* index = this->get_attribute_index(attribute);
+	StringDBIndexEntry* entry = index->find(value.data(),unsigned(value.length()));
+	if (entry != NULL || this->deferredAttributes.count(attribute) == 0) {
+		return entry;
+	}
+	if (this->snapshot != NULL) {
+		for (int i=0; i < int(snapshotColumns.size()); i++) {
+			if (snapshotColumns[i] != attribute) {
+				continue;
+			}
+			const unsigned* objectIDs = NULL;
+			const char* key = NULL;
+			int count = snapshot->find_objects(i,value,objectIDs,key);
+			if (count == -1) {
+				break;
+			}
+			//Misses are recorded as empty entries so the snapshot is probed once per key
+			if (key != NULL) {
+				entry = index->insert(key,unsigned(value.length()),true);
+			} else {
+				entry = index->insert(value.data(),unsigned(value.length()));
+			}
+			entry->objects.resize(count);
+			for (int j=0; j < count; j++) {
+				entry->objects[j] = records[objectIDs[j]];
+			}
+			return entry;
+		}
+	}
+	this->complete_attribute_hash(attribute);
+	return this->get_attribute_index(attribute)->find(value.data(),unsigned(value.length()));
+};
+//DONE
+int StringDBTable::complete_attribute_hash(int attribute) {
+	this->deferredAttributes.erase(attribute);
+	for (int i=0; i < this->number_of_objects(); i++) {
+		this->get_object(i)->load_body();
+	}
+	return this->reset_attribute_hash(attribute);
+};
+//DONE
+unsigned StringDBTable::snapshot_signature(bool unique) {
+	string settings = this->get_delimiter()+"\n"+this->get_itemDelimiter()+"\n";
+	settings.append(unique ? "1" : "0");
+	vector<string>* indexed = this->get_indexed_attributes();
+	if (indexed != NULL) {
+		for (int i=0; i < int(indexed->size()); i++) {
+			settings.append("\n"+(*indexed)[i]);
+		}
+	}
+	return STRINGDB::HashString(settings.data(),unsigned(settings.length()));
+};
+//DONE
+int StringDBTable::loadFromSnapshot() {
+	vector<string>* INindexedAttributes = this->get_indexed_attributes();
+	snapshotColumns.resize(snapshot->number_of_attributes());
+	for (int i=0; i < snapshot->number_of_attributes(); i++) {
+		string attribute = snapshot->get_attribute(i);
+		bool indexed = false;
+		for (int j=0; INindexedAttributes != NULL && j < int(INindexedAttributes->size()); j++) {
+			if ((*INindexedAttributes)[j].compare(attribute) == 0) {
+				indexed = true;
+				break;
+			}
+		}
+		this->add_atribute(attribute,indexed);
+		snapshotColumns[i] = this->find_attribute(attribute);
+	}
+	//Objects start as empty shells; lookups go through the mapped indexes and bodies are copied out of the pool on first use
+	for (int i=0; i < this->number_of_attributes(); i++) {
+		if (this->get_attribute_index(i) != NULL) {
+			this->deferredAttributes.insert(i);
+		}
+	}
+	records.resize(snapshot->number_of_objects());
+	for (int i=0; i < snapshot->number_of_objects(); i++) {
+		records[i] = new StringDBObject(this,i);
+		objects.push_back(records[i]);
+	}
+	this->resetIterator();
 	return SUCCESS;
 };
 //DONE
@@ -418,11 +677,11 @@ int StringDBTable::set_attribute_index(string attribute,bool indexed) {
 //DONE
 int StringDBTable::set_attribute_index(int attributeIndex,bool indexed) {
 	if (indexed) {
-		if (this->attributeHash[attributeIndex] != NULL) {
+		if (this->get_attribute_index(attributeIndex) != NULL) {
 			return SUCCESS;
 		}
 		return this->reset_attribute_hash(attributeIndex);
-	} else if (this->attributeHash[attributeIndex] != NULL) {
+	} else if (this->get_attribute_index(attributeIndex) != NULL) {
 		this->clear_attribute_hash(attributeIndex);
 	}
 	return SUCCESS;
@@ -430,13 +689,16 @@ int StringDBTable::set_attribute_index(int attributeIndex,bool indexed) {
 //DONE
 int StringDBTable::reset_attribute_hash(int attributeIndex) {
 	this->clear_attribute_hash(attributeIndex);
-	this->attributeHash[attributeIndex] = new map<string,list<StringDBObject*>*,std::less<string> >;
+	if (attributeIndex >= int(this->attributeIndexes.size())) {
+		this->attributeIndexes.resize(attributeIndex+1,NULL);
+	}
+	this->attributeIndexes[attributeIndex] = new StringDBIndex();
 	for (int i=0; i < this->number_of_objects(); i++) {
 		StringDBObject* object = this->get_object(i);
-		vector<string>* objectData = object->getAll(i);
+		vector<string>* objectData = object->getAll(attributeIndex);
 		if (objectData != NULL) {
 			for (int j=0; j < int(objectData->size()); j++) {
-				add_object_data_to_hash(i,(*objectData)[j],object);
+				add_object_data_to_hash(attributeIndex,(*objectData)[j],object);
 			}
 		}
 	}
@@ -444,12 +706,9 @@ int StringDBTable::reset_attribute_hash(int attributeIndex) {
 };
 //DONE
 int StringDBTable::clear_attribute_hash(int attributeIndex) {
-	if (this->attributeHash[attributeIndex] != NULL) {
-		for (map<string,list<StringDBObject*>*,std::less<string> >::iterator IT = this->attributeHash[attributeIndex]->begin();IT != this->attributeHash[attributeIndex]->end();IT++) {
-			delete IT->second;
-		}
-		delete this->attributeHash[attributeIndex];
-		this->attributeHash[attributeIndex] = NULL;
+	if (this->get_attribute_index(attributeIndex) != NULL) {
+		delete this->attributeIndexes[attributeIndex];
+		this->attributeIndexes[attributeIndex] = NULL;
 	}
 	return SUCCESS;
 };
@@ -481,36 +740,31 @@ int StringDBTable::add_object_data_to_hash(int attribute,string inData,StringDBO
 		this->print_error("attribute out of range","add_object_data_to_hash");
 		return FAIL;
 	}
-	if (attributeHash[attribute] == NULL) {
+	if (this->get_attribute_index(attribute) == NULL) {
 		return FAIL;
 	}
-	if ((*attributeHash[attribute])[inData] == NULL) {
-		(*attributeHash[attribute])[inData] = new list<StringDBObject*>;
+	StringDBIndexEntry* entry = this->load_deferred_key(attribute,inData);
+	if (entry == NULL) {
+		entry = this->get_attribute_index(attribute)->insert(inData.data(),unsigned(inData.length()));
 	}
-	list<StringDBObject*>* hashObjects = (*attributeHash[attribute])[inData];
-	for (list<StringDBObject*>::iterator IT = hashObjects->begin();IT != hashObjects->end(); IT++) {
-		if ((*IT) == inObject) {
+	for (int i=0; i < int(entry->objects.size()); i++) {
+		if (entry->objects[i] == inObject) {
 			return SUCCESS;
 		}
 	}
-	hashObjects->push_back(inObject);
+	entry->objects.push_back(inObject);
 	return SUCCESS;
 };
 //DONE
 int StringDBTable::remove_object_data_from_hash(int attribute,string inData,StringDBObject* inObject) {
-	if (attribute < 0 || attribute >= this->number_of_attributes() || attributeHash[attribute] == NULL || (*attributeHash[attribute])[inData] == NULL) {
+	if (attribute < 0 || attribute >= this->number_of_attributes() || this->get_attribute_index(attribute) == NULL) {
 		return FAIL;
 	}
-	list<StringDBObject*>* hashObjects = this->get_objects(attribute,inData);
-	for (list<StringDBObject*>::iterator IT = hashObjects->begin();IT != hashObjects->end(); IT++) {
-		if ((*IT) == inObject) {
-			hashObjects->erase(IT);
-		}
-	}
-	if (hashObjects->size() == 0) {
-		delete hashObjects;
-		(*this->attributeHash[attribute])[inData] = NULL;
+	StringDBIndexEntry* entry = this->load_deferred_key(attribute,inData);
+	if (entry == NULL || entry->objects.size() == 0) {
+		return FAIL;
 	}
+	entry->objects.erase(std::remove(entry->objects.begin(),entry->objects.end(),inObject),entry->objects.end());
 	return SUCCESS;
 };
 //DONE
@@ -519,33 +773,63 @@ StringDBObject* StringDBTable::get_object(string attribute,string value) {
 };
 //DONE
 StringDBObject* StringDBTable::get_object(int attribute,string value) {
-	list<StringDBObject*>* resultList = this->get_objects(attribute,value);
-	if (resultList != NULL && resultList->size() > 0) {
-		return (*resultList->begin());
+	StringDBObjectSpan result = this->get_objects(attribute,value);
+	if (result.count > 0) {
+		return result.objects[0];
 	}
 	return NULL;
 };
 //DONE
-list<StringDBObject*>* StringDBTable::get_objects(string attribute,string value) {
+StringDBObjectSpan StringDBTable::get_objects(string attribute,string value) {
 	return this->get_objects(this->find_attribute(attribute),value);
 };
 //DONE
-list<StringDBObject*>* StringDBTable::get_objects(int attribute,string value) {
-	if (this->attributeHash[attribute] == NULL) {
+StringDBObjectSpan StringDBTable::get_objects(int attribute,string value) {
+	StringDBObjectSpan result = {NULL,0};
+	if (this->get_attribute_index(attribute) == NULL) {
 		this->print_error("no hash exists for query attribute","get_object");
-		return NULL;
+		return result;
 	}
-	if ((*this->attributeHash[attribute])[value] == NULL) {
+	StringDBIndexEntry* entry = this->load_deferred_key(attribute,value);
+	if (entry == NULL || entry->objects.size() == 0) {
 		if (this->get_path().length() > 0 && this->get_id_column().compare(this->get_attribute(attribute)) == 0) {
 			StringDBObject* newObject = new StringDBObject(this);
 			newObject->load_object_from_file(value);
 			this->add_object(newObject);
-			return (*this->attributeHash[attribute])[value];
+			entry = this->get_attribute_index(attribute)->find(value.data(),unsigned(value.length()));
+		}
+		if (entry == NULL || entry->objects.size() == 0) {
+			this->print_error("no object exists with input value","get_object");
+			return result;
 		}
-		this->print_error("no object exists with input value","get_object");
-		return NULL;
 	}
-	return (*this->attributeHash[attribute])[value];
+	result.objects = &(entry->objects[0]);
+	result.count = int(entry->objects.size());
+	return result;
+};
+//DONE
+int StringDBTable::get_objects(int attribute,const vector<string>& values,vector<StringDBObject*>& results) {
+	results.assign(values.size(),NULL);
+	if (this->get_attribute_index(attribute) == NULL) {
+		this->print_error("no hash exists for query attribute","get_objects");
+		return FAIL;
+	}
+	vector<pair<int,StringDBObject*> > unread;
+	for (int i=0; i < int(values.size()); i++) {
+		StringDBIndexEntry* entry = this->load_deferred_key(attribute,values[i]);
+		if (entry != NULL && entry->objects.size() > 0) {
+			results[i] = entry->objects[0];
+			if (results[i]->get_record() != -1) {
+				unread.push_back(pair<int,StringDBObject*>(results[i]->get_record(),results[i]));
+			}
+		}
+	}
+	//Deferred bodies are read in file order, so the whole request is one forward pass over the table file
+	sort(unread.begin(),unread.end());
+	for (int i=0; i < int(unread.size()); i++) {
+		unread[i].second->load_body();
+	}
+	return SUCCESS;
 };
 //DONE
 int StringDBTable::number_of_objects() {
@@ -574,6 +858,7 @@ StringDBObject* StringDBTable::get_object(int index) {
 //StringDBObject Objects
 StringDBObject::StringDBObject(StringDBTable* parent) {
 	this->loaded = false;
+	this->record = -1;
 	this->parentTable = parent;
 	this->data.resize(parentTable->number_of_attributes());
 	for (int i=0; i < int(this->data.size()); i++) {
@@ -581,6 +866,12 @@ StringDBObject::StringDBObject(StringDBTable* parent) {
 	}
 };
 //DONE
+StringDBObject::StringDBObject(StringDBTable* parent,int inRecord) {
+	this->loaded = false;
+	this->record = inRecord;
+	this->parentTable = parent;
+};
+//DONE
 StringDBObject::~StringDBObject() {
 	for (int i=0; i < int(this->data.size()); i++) {
 		delete this->data[i];
@@ -625,10 +916,23 @@ int StringDBObject::load_object_from_file(string filename) {
 	return SUCCESS;
 };
 //DONE
+int StringDBObject::load_body() {
+	if (this->record == -1) {
+		return SUCCESS;
+	}
+	int currentRecord = this->record;
+	this->record = -1;
+	return this->get_table()->load_record(this,currentRecord);
+};
+//DONE
 bool StringDBObject::objectLoaded() {
 	return loaded;
 };
 //DONE
+int StringDBObject::get_record() {
+	return record;
+};
+//DONE
 int StringDBObject::set_loaded(bool input) {
 	loaded = input;
 	return SUCCESS;
@@ -647,6 +951,7 @@ vector<string>* StringDBObject::getAll(string attribute) {
 };
 //DONE
 vector<string>* StringDBObject::getAll(int attribute) {
+	this->load_body();
 	if (attribute < 0 || int(this->data.size()) <= attribute) {
 		this->print_error("attribute out of range","getAll");
 		return NULL;
@@ -672,6 +977,7 @@ int StringDBObject::get_data_index(string attribute,string value) {
 };
 //DONE
 int StringDBObject::get_data_index(int attribute,string value) {
+	this->load_body();
 	if (attribute < 0 || attribute >= int(this->data.size())) {
 		this->print_error("attribute not found in object","get_data_index");
 		return -1;
@@ -692,6 +998,7 @@ int StringDBObject::set(string attribute,string indata,int index,bool unique) {
 };
 //DONE
 int StringDBObject::set(int attribute,string indata,int index,bool unique) {
+	this->load_body();
 	if (attribute < 0) {
 		this->print_error("attribute not found in object","set");
 		return FAIL;
@@ -727,6 +1034,7 @@ int StringDBObject::setAll(string attribute,vector<string>* indata) {
 };
 //DONE
 int StringDBObject::setAll(int attribute,vector<string>* indata) {
+	this->load_body();
 	if (attribute < 0) {
 		this->print_error("attribute not found in object","setAll");
 		return FAIL;
@@ -756,6 +1064,7 @@ int StringDBObject::remove(string attribute,int value,string replacement) {
 };
 //DONE
 int StringDBObject::remove(int attribute,int value,string replacement) {
+	this->load_body();
 	if (attribute < 0 || attribute >= int(this->data.size())) {
 		this->print_error("attribute not found in object","remove");
 		return FAIL;
@@ -779,6 +1088,7 @@ int StringDBObject::removeAll(string attribute,vector<string>* replacement) {
 };
 //DONE
 int StringDBObject::removeAll(int attribute,vector<string>* replacement) {
+	this->load_body();
 	if (attribute < 0 || attribute >= int(this->data.size())) {
 		this->print_error("attribute not found in object","removeAll");
 		return FAIL;
@@ -811,3 +1121,423 @@ int StringDBObject::sync_with_attributes() {
 	}
 	return SUCCESS;
 };
+
+//***************************************************************************************
+//StringDBSnapshot Objects
+StringDBSnapshot::StringDBSnapshot() {
+	mapped = NULL;
+	mappedSize = 0;
+	header = NULL;
+	attributeNames = NULL;
+	objectStarts = NULL;
+	values = NULL;
+	indexes = NULL;
+	pool = NULL;
+};
+//DONE
+StringDBSnapshot::~StringDBSnapshot() {
+	this->close_snapshot();
+};
+//DONE
+int StringDBSnapshot::open_snapshot(string filename,string sourceFilename,unsigned signature) {
+	this->close_snapshot();
+	struct stat sourceStat;
+	if (stat(sourceFilename.data(),&sourceStat) != 0) {
+		return FAIL;
+	}
+	int descriptor = open(filename.data(),O_RDONLY);
+	if (descriptor == -1) {
+		return FAIL;
+	}
+	struct stat snapshotStat;
+	if (fstat(descriptor,&snapshotStat) != 0 || snapshotStat.st_size < off_t(sizeof(StringDBSnapshotHeader))) {
+		close(descriptor);
+		return FAIL;
+	}
+	void* region = mmap(NULL,size_t(snapshotStat.st_size),PROT_READ,MAP_SHARED,descriptor,0);
+	close(descriptor);
+	if (region == MAP_FAILED) {
+		return FAIL;
+	}
+	mapped = (const char*)region;
+	mappedSize = size_t(snapshotStat.st_size);
+	header = (const StringDBSnapshotHeader*)mapped;
+	//A snapshot is only used if it was compiled from the current source file with the current table settings
+	unsigned long long total = mappedSize;
+	if (memcmp(header->magic,"SDBSNAP",8) != 0 || header->version != STRINGDB_SNAPSHOT_VERSION || header->totalSize != total || header->signature != signature ||
+		header->sourceSize != (long long)(sourceStat.st_size) || header->sourceModified != (long long)(sourceStat.st_mtime) ||
+		header->attributeOffset+4ULL*header->attributeCount > total ||
+		header->objectOffset+4ULL*((unsigned long long)(header->objectCount)*header->attributeCount+1) > total ||
+		header->valueOffset+4ULL*header->valueCount > total ||
+		header->indexOffset+(unsigned long long)(sizeof(StringDBSnapshotIndex))*header->indexCount > total ||
+		header->poolOffset+(unsigned long long)(header->poolSize) > total) {
+		this->close_snapshot();
+		return FAIL;
+	}
+	attributeNames = (const unsigned*)(mapped+header->attributeOffset);
+	objectStarts = (const unsigned*)(mapped+header->objectOffset);
+	values = (const unsigned*)(mapped+header->valueOffset);
+	indexes = (const StringDBSnapshotIndex*)(mapped+header->indexOffset);
+	pool = mapped+header->poolOffset;
+	for (unsigned i=0; i < header->indexCount; i++) {
+		if (indexes[i].attribute >= header->attributeCount || indexes[i].slotCount == 0 || (indexes[i].slotCount & (indexes[i].slotCount-1)) != 0 || indexes[i].slotOffset+(unsigned long long)(sizeof(StringDBSnapshotSlot))*indexes[i].slotCount > total || indexes[i].postingOffset > total) {
+			this->close_snapshot();
+			return FAIL;
+		}
+	}
+	return SUCCESS;
+};
+//DONE
+void StringDBSnapshot::close_snapshot() {
+	if (mapped != NULL) {
+		munmap((void*)mapped,mappedSize);
+	}
+	mapped = NULL;
+	mappedSize = 0;
+	header = NULL;
+};
+//DONE
+int StringDBSnapshot::write_snapshot(StringDBTable* table,string filename,string sourceFilename,unsigned signature) {
+	struct stat sourceStat;
+	if (stat(sourceFilename.data(),&sourceStat) != 0) {
+		return FAIL;
+	}
+	vector<char> stringPool;
+	map<string,unsigned> poolOffsets;
+	vector<unsigned> attributeData;
+	vector<unsigned> objectData;
+	vector<unsigned> valueData;
+	int attributeCount = table->number_of_attributes();
+	int objectCount = table->number_of_objects();
+	for (int i=0; i < attributeCount; i++) {
+		attributeData.push_back(STRINGDB::AddToPool(stringPool,poolOffsets,table->get_attribute(i)));
+	}
+	objectData.reserve((unsigned long long)(objectCount)*attributeCount+1);
+	for (int i=0; i < objectCount; i++) {
+		StringDBObject* object = table->get_object(i);
+		for (int j=0; j < attributeCount; j++) {
+			objectData.push_back(unsigned(valueData.size()));
+			vector<string>* data = object->getAll(j);
+			for (int k=0; data != NULL && k < int(data->size()); k++) {
+				valueData.push_back(STRINGDB::AddToPool(stringPool,poolOffsets,(*data)[k]));
+			}
+		}
+	}
+	objectData.push_back(unsigned(valueData.size()));
+	//Each indexed attribute gets an open addressing table whose slots point at contiguous runs of object numbers
+	vector<StringDBSnapshotIndex> indexData;
+	vector<vector<StringDBSnapshotSlot> > slotData;
+	vector<vector<unsigned> > postingData;
+	vector<string>* indexed = table->get_indexed_attributes();
+	for (int i=0; indexed != NULL && i < int(indexed->size()); i++) {
+		int attribute = table->find_attribute((*indexed)[i]);
+		if (attribute == -1) {
+			continue;
+		}
+		map<unsigned,vector<unsigned> > keyObjects;
+		for (int j=0; j < objectCount; j++) {
+			for (unsigned k=objectData[j*attributeCount+attribute]; k < objectData[j*attributeCount+attribute+1]; k++) {
+				vector<unsigned>& current = keyObjects[valueData[k]];
+				if (current.size() == 0 || current.back() != unsigned(j)) {
+					current.push_back(unsigned(j));
+				}
+			}
+		}
+		unsigned slotCount = 2;
+		while (slotCount < 2*keyObjects.size()) {
+			slotCount *= 2;
+		}
+		StringDBSnapshotSlot empty = {STRINGDB_SNAPSHOT_EMPTY,0,0,0};
+		StringDBSnapshotIndex newIndex = {unsigned(attribute),slotCount,0,0};
+		indexData.push_back(newIndex);
+		slotData.push_back(vector<StringDBSnapshotSlot>(slotCount,empty));
+		postingData.push_back(vector<unsigned>());
+		vector<StringDBSnapshotSlot>& slots = slotData.back();
+		vector<unsigned>& postings = postingData.back();
+		for (map<unsigned,vector<unsigned> >::iterator IT = keyObjects.begin(); IT != keyObjects.end(); IT++) {
+			unsigned length = *((const unsigned*)(&stringPool[IT->first]));
+			unsigned hash = STRINGDB::HashString(&stringPool[IT->first+sizeof(unsigned)],length);
+			unsigned slot = hash & (slotCount-1);
+			while (slots[slot].key != STRINGDB_SNAPSHOT_EMPTY) {
+				slot = (slot+1) & (slotCount-1);
+			}
+			slots[slot].key = IT->first;
+			slots[slot].hash = hash;
+			slots[slot].start = unsigned(postings.size());
+			slots[slot].count = unsigned(IT->second.size());
+			postings.insert(postings.end(),IT->second.begin(),IT->second.end());
+		}
+	}
+	StringDBSnapshotHeader newHeader;
+	memset(&newHeader,0,sizeof(StringDBSnapshotHeader));
+	memcpy(newHeader.magic,"SDBSNAP",8);
+	newHeader.sourceSize = (long long)(sourceStat.st_size);
+	newHeader.sourceModified = (long long)(sourceStat.st_mtime);
+	newHeader.version = STRINGDB_SNAPSHOT_VERSION;
+	newHeader.signature = signature;
+	newHeader.attributeCount = unsigned(attributeCount);
+	newHeader.objectCount = unsigned(objectCount);
+	newHeader.valueCount = unsigned(valueData.size());
+	newHeader.indexCount = unsigned(indexData.size());
+	newHeader.poolSize = unsigned(stringPool.size());
+	unsigned long long offset = sizeof(StringDBSnapshotHeader);
+	newHeader.attributeOffset = unsigned(offset);
+	offset += sizeof(unsigned)*attributeData.size();
+	newHeader.objectOffset = unsigned(offset);
+	offset += sizeof(unsigned)*objectData.size();
+	newHeader.valueOffset = unsigned(offset);
+	offset += sizeof(unsigned)*valueData.size();
+	newHeader.indexOffset = unsigned(offset);
+	offset += sizeof(StringDBSnapshotIndex)*indexData.size();
+	for (int i=0; i < int(indexData.size()); i++) {
+		indexData[i].slotOffset = unsigned(offset);
+		offset += sizeof(StringDBSnapshotSlot)*slotData[i].size();
+		indexData[i].postingOffset = unsigned(offset);
+		offset += sizeof(unsigned)*postingData[i].size();
+	}
+	newHeader.poolOffset = unsigned(offset);
+	offset += stringPool.size();
+	if (offset >= STRINGDB_SNAPSHOT_EMPTY) {
+		return FAIL;
+	}
+	newHeader.totalSize = unsigned(offset);
+	//The snapshot is written under a temporary name and renamed so concurrent jobs never map a partial file
+	ostringstream temporaryFilename;
+	temporaryFilename << filename << "." << getpid() << ".tmp";
+	ofstream output(temporaryFilename.str().data(),ios::out | ios::binary | ios::trunc);
+	if (!output.is_open()) {
+		return FAIL;
+	}
+	output.write((const char*)&newHeader,sizeof(StringDBSnapshotHeader));
+	if (attributeData.size() > 0) {
+		output.write((const char*)&attributeData[0],sizeof(unsigned)*attributeData.size());
+	}
+	output.write((const char*)&objectData[0],sizeof(unsigned)*objectData.size());
+	if (valueData.size() > 0) {
+		output.write((const char*)&valueData[0],sizeof(unsigned)*valueData.size());
+	}
+	if (indexData.size() > 0) {
+		output.write((const char*)&indexData[0],sizeof(StringDBSnapshotIndex)*indexData.size());
+	}
+	for (int i=0; i < int(indexData.size()); i++) {
+		output.write((const char*)&slotData[i][0],sizeof(StringDBSnapshotSlot)*slotData[i].size());
+		if (postingData[i].size() > 0) {
+			output.write((const char*)&postingData[i][0],sizeof(unsigned)*postingData[i].size());
+		}
+	}
+	if (stringPool.size() > 0) {
+		output.write(&stringPool[0],stringPool.size());
+	}
+	output.close();
+	if (output.fail() || rename(temporaryFilename.str().data(),filename.data()) != 0) {
+		remove(temporaryFilename.str().data());
+		return FAIL;
+	}
+	return SUCCESS;
+};
+//DONE
+const char* StringDBSnapshot::get_string(unsigned offset,unsigned& length) {
+	if (header == NULL || offset+4ULL > header->poolSize) {
+		length = 0;
+		return "";
+	}
+	length = *((const unsigned*)(pool+offset));
+	if (offset+4ULL+length > header->poolSize) {
+		length = 0;
+		return "";
+	}
+	return pool+offset+sizeof(unsigned);
+};
+//DONE
+int StringDBSnapshot::number_of_attributes() {
+	if (header == NULL) {
+		return 0;
+	}
+	return int(header->attributeCount);
+};
+//DONE
+string StringDBSnapshot::get_attribute(int attribute) {
+	unsigned length = 0;
+	const char* name = this->get_string(attributeNames[attribute],length);
+	return string(name,length);
+};
+//DONE
+int StringDBSnapshot::number_of_objects() {
+	if (header == NULL) {
+		return 0;
+	}
+	return int(header->objectCount);
+};
+//DONE
+int StringDBSnapshot::number_of_values(int object,int attribute) {
+	unsigned position = unsigned(object)*header->attributeCount+unsigned(attribute);
+	if (objectStarts[position+1] > header->valueCount || objectStarts[position] > objectStarts[position+1]) {
+		return 0;
+	}
+	return int(objectStarts[position+1]-objectStarts[position]);
+};
+//DONE
+const char* StringDBSnapshot::get_value(int object,int attribute,int index,unsigned& length) {
+	unsigned position = unsigned(object)*header->attributeCount+unsigned(attribute);
+	return this->get_string(values[objectStarts[position]+index],length);
+};
+//DONE
+int StringDBSnapshot::number_of_indexes() {
+	if (header == NULL) {
+		return 0;
+	}
+	return int(header->indexCount);
+};
+//DONE
+int StringDBSnapshot::get_index_attribute(int index) {
+	return int(indexes[index].attribute);
+};
+//DONE
+int StringDBSnapshot::number_of_slots(int index) {
+	return int(indexes[index].slotCount);
+};
+//DONE
+const StringDBSnapshotSlot* StringDBSnapshot::get_slots(int index) {
+	return (const StringDBSnapshotSlot*)(mapped+indexes[index].slotOffset);
+};
+//DONE
+const char* StringDBSnapshot::get_slot_key(int index,int slot,unsigned& length) {
+	const StringDBSnapshotSlot& current = this->get_slots(index)[slot];
+	if (current.key == STRINGDB_SNAPSHOT_EMPTY) {
+		length = 0;
+		return NULL;
+	}
+	return this->get_string(current.key,length);
+};
+//DONE
+int StringDBSnapshot::get_slot_objects(int index,int slot,const unsigned*& objectIDs) {
+	const StringDBSnapshotSlot& current = this->get_slots(index)[slot];
+	if (current.key == STRINGDB_SNAPSHOT_EMPTY || indexes[index].postingOffset+4ULL*(current.start+(unsigned long long)(current.count)) > mappedSize) {
+		objectIDs = NULL;
+		return 0;
+	}
+	objectIDs = ((const unsigned*)(mapped+indexes[index].postingOffset))+current.start;
+	return int(current.count);
+};
+//DONE
+int StringDBSnapshot::find_objects(int attribute,const string& value,const unsigned*& objectIDs,const char*& key) {
+	objectIDs = NULL;
+	key = NULL;
+	for (int i=0; i < this->number_of_indexes(); i++) {
+		if (this->get_index_attribute(i) != attribute) {
+			continue;
+		}
+		unsigned hash = STRINGDB::HashString(value.data(),unsigned(value.length()));
+		unsigned mask = indexes[i].slotCount-1;
+		const StringDBSnapshotSlot* slots = this->get_slots(i);
+		for (unsigned slot = hash & mask, probes = 0; probes < indexes[i].slotCount; slot = (slot+1) & mask, probes++) {
+			if (slots[slot].key == STRINGDB_SNAPSHOT_EMPTY) {
+				return 0;
+			}
+			unsigned length = 0;
+			const char* slotKey = this->get_string(slots[slot].key,length);
+			if (slots[slot].hash == hash && length == value.length() && memcmp(slotKey,value.data(),length) == 0) {
+				key = slotKey;
+				return this->get_slot_objects(i,int(slot),objectIDs);
+			}
+		}
+		return 0;
+	}
+	return -1;
+};
+
+//***************************************************************************************
+//StringDBIndex Objects
+StringDBIndex::StringDBIndex() {
+	blockUsed = 0;
+	slots.resize(16,-1);
+};
+//DONE
+StringDBIndex::~StringDBIndex() {
+	for (int i=0; i < int(entries.size()); i++) {
+		delete entries[i];
+	}
+	for (int i=0; i < int(blocks.size()); i++) {
+		delete [] blocks[i];
+	}
+};
+//DONE
+const char* StringDBIndex::intern(const char* key,unsigned length) {
+	const unsigned blockSize = 65536;
+	if (length+1 > blockSize/4) {
+		char* ownBlock = new char[length+1];
+		memcpy(ownBlock,key,length);
+		ownBlock[length] = 0;
+		blocks.insert(blocks.begin(),ownBlock);
+		//With no arena block yet, the next short key must not be packed into this one
+		if (blocks.size() == 1) {
+			blockUsed = blockSize;
+		}
+		return ownBlock;
+	}
+	if (blocks.size() == 0 || blockUsed+length+1 > blockSize) {
+		blocks.push_back(new char[blockSize]);
+		blockUsed = 0;
+	}
+	char* current = blocks.back()+blockUsed;
+	memcpy(current,key,length);
+	current[length] = 0;
+	blockUsed += length+1;
+	return current;
+};
+//DONE
+int StringDBIndex::find_slot(const char* key,unsigned length,unsigned hash) {
+	unsigned mask = unsigned(slots.size())-1;
+	unsigned slot = hash & mask;
+	while (slots[slot] != -1) {
+		StringDBIndexEntry* entry = entries[slots[slot]];
+		if (entry->hash == hash && entry->length == length && memcmp(entry->key,key,length) == 0) {
+			return int(slot);
+		}
+		slot = (slot+1) & mask;
+	}
+	return int(slot);
+};
+//DONE
+StringDBIndexEntry* StringDBIndex::find(const char* key,unsigned length) {
+	int slot = this->find_slot(key,length,STRINGDB::HashString(key,length));
+	if (slots[slot] == -1) {
+		return NULL;
+	}
+	return entries[slots[slot]];
+};
+//DONE
+StringDBIndexEntry* StringDBIndex::insert(const char* key,unsigned length,bool stableKey) {
+	unsigned hash = STRINGDB::HashString(key,length);
+	int slot = this->find_slot(key,length,hash);
+	if (slots[slot] != -1) {
+		return entries[slots[slot]];
+	}
+	StringDBIndexEntry* entry = new StringDBIndexEntry;
+	entry->key = stableKey ? key : this->intern(key,length);
+	entry->length = length;
+	entry->hash = hash;
+	entries.push_back(entry);
+	slots[slot] = int(entries.size()-1);
+	//The table is kept at most half full so probe runs stay short
+	if (2*entries.size() > slots.size()) {
+		slots.assign(2*slots.size(),-1);
+		unsigned mask = unsigned(slots.size())-1;
+		for (int i=0; i < int(entries.size()); i++) {
+			unsigned newSlot = entries[i]->hash & mask;
+			while (slots[newSlot] != -1) {
+				newSlot = (newSlot+1) & mask;
+			}
+			slots[newSlot] = i;
+		}
+	}
+	return entry;
+};
+//DONE
+int StringDBIndex::number_of_entries() {
+	return int(entries.size());
+};
+//DONE
+StringDBIndexEntry* StringDBIndex::get_entry(int entry) {
+	return entries[entry];
+};
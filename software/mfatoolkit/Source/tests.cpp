@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+//    MFAToolkit: Software for running flux balance analysis on stoichiometric models
+//    Software developer: Christopher Henry (chenry@mcs.anl.gov), MCS Division, Argonne National Laboratory
+//    Copyright (C) 2007  Argonne National Laboratory/University of Chicago. All Rights Reserved.
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//    For more information on MFAToolkit, see <http://bionet.mcs.anl.gov/index.php/Model_analysis>.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MFAToolkit.h"
+#include "ModelFixture.h"
+
+using namespace std;
+
+//Regression checks built and run by "make test". Each check returns the number of failed expectations
+
+//Writes a network where A is made into B either directly by peg.1 or through C by peg.2 and peg.3, so peg.1 and peg.2 are a synthetic lethal pair
+string WriteParallelPathwayNetwork(string Directory) {
+	ModelFixture Fixture;
+	Fixture.Compounds.push_back("cpdT00000\tA\tA\tC6H12O6\t0\t-100\t2\t180");
+	Fixture.Compounds.push_back("cpdT00001\tB\tB\tC6H12O6\t0\t-110\t2\t180");
+	Fixture.Compounds.push_back("cpdT00002\tC\tC\tC6H12O6\t0\t-105\t2\t180");
+	Fixture.Compounds.push_back("cpdTbiomass\tBiomass\tcpdTbiomass\tC6H12O6\t0\t0\t0\t180");
+	Fixture.Reactions.push_back("rxnT00000\tA transport\t(1) cpdT00000[e] <=> (1) cpdT00000[c]\t0\t2");
+	Fixture.Reactions.push_back("rxnT00001\tA to B\t(1) cpdT00000[c] => (1) cpdT00001[c]\t-10\t2");
+	Fixture.Reactions.push_back("rxnT00002\tA to C\t(1) cpdT00000[c] => (1) cpdT00002[c]\t-5\t2");
+	Fixture.Reactions.push_back("rxnT00003\tC to B\t(1) cpdT00002[c] => (1) cpdT00001[c]\t-5\t2");
+	Fixture.Reactions.push_back("bio00001\tBiomass\t(1) cpdT00001[c] => (1) cpdTbiomass[c]\t0\t0");
+	Fixture.ModelReactions.push_back("rxnT00000;<=>;c;peg.0");
+	Fixture.ModelReactions.push_back("rxnT00001;=>;c;peg.1");
+	Fixture.ModelReactions.push_back("rxnT00002;=>;c;peg.2");
+	Fixture.ModelReactions.push_back("rxnT00003;=>;c;peg.3");
+	Fixture.ModelReactions.push_back("bio00001;=>;c;peg.4");
+	Fixture.Media = "TestMedia\tTestMedia\tcpdT00000\tDRAIN_FLUX\t100\t-100\te";
+	Fixture.ParameterFile = "TestParameters.txt";
+	Fixture.ParameterGroup = "Test parameters";
+	Fixture.Parameters.push_back(pair<string,string>("output folder","Test/"));
+	Fixture.Parameters.push_back(pair<string,string>("user bounds filename","TestMedia"));
+	Fixture.Parameters.push_back(pair<string,string>("objective","MAX;FLUX;bio00001;none;1"));
+	Fixture.Parameters.push_back(pair<string,string>("exchange species","cpdTbiomass[c]:-10000:0"));
+	Fixture.Parameters.push_back(pair<string,string>("Prune silent knockouts","1"));
+	Fixture.Parameters.push_back(pair<string,string>("Print overall reaction data","0"));
+	return WriteModelFixture(Directory,Fixture);
+}
+
+int Expect(bool Condition, string Description) {
+	if (Condition) {
+		return 0;
+	}
+	cout << "FAILED: " << Description << endl;
+	return 1;
+}
+
+//The wild type optimum uses only one of the two pathways, so one single knockout is silent and the other reroutes through the idle pathway.
+//The double knockout blocks the same active reactions as the rerouted single knockout, but it also blocks the reroute and must not reuse its growth
+int TestSyntheticLethalKnockouts(string ModelFilename) {
+	Data* Model = new Data(0);
+	Model->ClearData("NAME",STRING);
+	Model->AddData("NAME","Model",STRING);
+	if (Model->LoadSystem(ModelFilename) == FAIL) {
+		return Expect(false,"parallel pathway model loads");
+	}
+	OptimizationParameter* Parameters = ReadParameters();
+	MFAProblem* Problem = new MFAProblem();
+	if (Problem->BuildMFAProblem(Model,Parameters) != SUCCESS || Problem->ConvertStringToObjective(GetParameter("objective"),Model) == NULL || Problem->LoadSolver(false) != SUCCESS) {
+		return Expect(false,"parallel pathway problem loads into the solver");
+	}
+	OptSolutionData* WildType = Problem->RunSolver(false,false,false);
+	if (WildType == NULL || WildType->Status != SUCCESS || WildType->Objective < MFA_ZERO_TOLERANCE) {
+		return Expect(false,"wild type grows");
+	}
+	double WildTypeGrowth = WildType->Objective;
+	Problem->SetReferenceSolution(WildType);
+	Problem->SaveReferenceBasis();
+
+	Gene* First = Model->FindGene("DATABASE;NAME","peg.1");
+	Gene* Second = Model->FindGene("DATABASE;NAME","peg.2");
+	if (First == NULL || Second == NULL) {
+		return Expect(false,"pathway genes are loaded");
+	}
+	int Failures = 0;
+	vector<int> Support;
+	vector<int> Knockout(1,First->FIndex());
+	Failures += Expect(Problem->SimulateKnockout(Model,Knockout,false,Support) > 0.99*WildTypeGrowth,"peg.1 knockout reroutes through peg.2 and peg.3");
+	Knockout[0] = Second->FIndex();
+	Failures += Expect(Problem->SimulateKnockout(Model,Knockout,false,Support) > 0.99*WildTypeGrowth,"peg.2 knockout reroutes through peg.1");
+	Knockout[0] = First->FIndex();
+	Knockout.push_back(Second->FIndex());
+	sort(Knockout.begin(),Knockout.end());
+	Failures += Expect(Problem->SimulateKnockout(Model,Knockout,false,Support) < MFA_ZERO_TOLERANCE,"peg.1 and peg.2 double knockout is lethal");
+
+	//The combinatorial screen must record the same synthetic lethal pair
+	Failures += Expect(Problem->CombinatorialKO(2,Model,false) == SUCCESS,"combinatorial knockout screen runs");
+	FileLineReader Input;
+	bool Found = false;
+	if (OpenLineReader(Input,FOutputFilepath()+"MFAOutput/CombinationKO.txt")) {
+		StringField Line;
+		vector<StringField> Fields;
+		while (ReadLine(Input,Line)) {
+			SplitFields(Line.Data,Line.Length,"\t",Fields);
+			if (Fields.size() >= 2 && (FieldEquals(Fields[0],"peg.1,peg.2") || FieldEquals(Fields[0],"peg.2,peg.1")) && FieldToDouble(Fields[1]) < MFA_ZERO_TOLERANCE) {
+				Found = true;
+			}
+		}
+		CloseLineReader(Input);
+	}
+	Failures += Expect(Found,"combinatorial knockout screen reports peg.1 and peg.2 as lethal");
+
+	delete Problem;
+	delete Model;
+	return Failures;
+}
+
+//Compares the compiled knockout program with the node by node gene logic for every knockout of six genes, before and after a rule is extended in place
+int CompareGeneLogic(Data* Model, string Stage) {
+	int Failures = 0;
+	int NumGenes = Model->FNumGenes();
+	for (int Mask=0; Mask < (1 << NumGenes); Mask++) {
+		vector<bool> GeneKO(NumGenes,false);
+		for (int i=0; i < NumGenes; i++) {
+			GeneKO[Model->GetGene(i)->FIndex()] = ((Mask >> i) & 1) != 0;
+			Model->GetGene(i)->SetMark(((Mask >> i) & 1) != 0);
+		}
+		vector<bool> ReactionKO;
+		Model->FindKnockedOutReactions(GeneKO,ReactionKO);
+		for (int j=0; j < Model->FNumReactions(); j++) {
+			bool Expected = Model->GetReaction(j)->CheckForKO();
+			bool Compiled = (j < int(ReactionKO.size()) && ReactionKO[j]);
+			if (Expected != Compiled) {
+				Failures += Expect(false,Stage+": compiled gene logic of "+Model->GetReaction(j)->GetData("DATABASE",STRING)+" matches CheckForKO for knockout mask "+itoa(Mask));
+			}
+		}
+	}
+	for (int i=0; i < NumGenes; i++) {
+		Model->GetGene(i)->SetMark(false);
+	}
+	return Failures;
+}
+
+int TestCompiledGeneLogic() {
+	string OldGeneHandling = GetParameter("new gene handling");
+	SetParameter("new gene handling","1");
+	Data* Model = new Data(0);
+	const char* Rules[] = {"(g1 and (g2 or g3)) or g4","g1 and g2 and (g3 or (g4 and g5))","(g5 or g6) and (g1 or (g2 and g3))","((g1 or g2) and (g3 or g4)) or (g5 and g6)","g6"};
+	for (int i=0; i < 5; i++) {
+		Reaction* NewReaction = new Reaction("",Model);
+		NewReaction->SetData("DATABASE",(string("rxnG0000")+itoa(i)).data(),STRING);
+		NewReaction->ParseGeneString(Rules[i]);
+		Model->AddReaction(NewReaction);
+	}
+	int Failures = Expect(Model->FNumGenes() == 6,"gene rules load six genes");
+	if (Failures == 0) {
+		Failures += CompareGeneLogic(Model,"parsed rules");
+		//Extending a rule keeps the gene and reaction counts, so the compiled program must notice the change itself
+		Model->GetReaction(4)->ParseGeneString("g1 and g2");
+		Failures += CompareGeneLogic(Model,"extended rule");
+	}
+	delete Model;
+	SetParameter("new gene handling",OldGeneHandling.data());
+	return Failures;
+}
+
+//The substr based StringToStrings that SplitFields replaced, kept as the reference for the field tokenizer
+vector<string> ReferenceStringToStrings(string Buff, const char* Delim, bool TreatConsecutiveDelimAsOne) {
+	vector<string> Result;
+	int Location;
+	do {
+		Location = int(Buff.find_first_of(Delim));
+		if (Location != -1) {
+			if (Location > 0 || !TreatConsecutiveDelimAsOne) {
+				Result.push_back(Buff.substr(0,Location));
+			}
+			Buff = Buff.substr(Location+1);
+		}
+	} while (Location != -1);
+	if (Buff.length() != 0 || !TreatConsecutiveDelimAsOne) {
+		Result.push_back(Buff);
+	}
+	return Result;
+}
+
+//Reads the same CRLF file with the line reader and with getline and splits every line both ways; a tiny buffer forces lines across block boundaries
+int TestFieldTokenizer(string Directory) {
+	const char* Lines[] = {"a\tb\tc","\t\ta\t\tb\t","a\t\t","","x;y,,z\r","\r","a line much longer than the eight byte reader buffer\tsecond field\r","last\tline without newline"};
+	const char* Delims[] = {"\t",";,","\t;,"};
+	int NumLines = 8;
+	ofstream Output;
+	if (!OpenOutput(Output,Directory+"Fields.txt")) {
+		return Expect(false,"tokenizer test file is written");
+	}
+	for (int i=0; i < NumLines; i++) {
+		Output << Lines[i];
+		if (i < NumLines-1) {
+			Output << "\n";
+		}
+	}
+	Output.close();
+
+	int Failures = 0;
+	FileLineReader Reader;
+	ifstream Input;
+	if (!OpenLineReader(Reader,Directory+"Fields.txt",8) || !OpenInput(Input,Directory+"Fields.txt")) {
+		return Expect(false,"tokenizer test file opens");
+	}
+	StringField Line;
+	vector<StringField> Fields;
+	for (int i=0; i < NumLines; i++) {
+		string Expected = GetFileLine(Input);
+		if (!ReadLine(Reader,Line)) {
+			Failures += Expect(false,string("line reader returns line ")+itoa(i));
+			break;
+		}
+		Failures += Expect(FieldToString(Line).compare(Expected) == 0 && Expected.compare(Lines[i]) == 0,string("line reader keeps line ")+itoa(i)+" as getline does");
+		for (int j=0; j < 3; j++) {
+			for (int k=0; k < 2; k++) {
+				bool Consecutive = (k == 0);
+				vector<string> Reference = ReferenceStringToStrings(Expected,Delims[j],Consecutive);
+				SplitFields(Line.Data,Line.Length,Delims[j],Fields,Consecutive);
+				vector<string>* Strings = StringToStrings(Expected,Delims[j],Consecutive);
+				bool Same = (Fields.size() == Reference.size() && Strings->size() == Reference.size());
+				for (int m=0; Same && m < int(Reference.size()); m++) {
+					Same = (FieldToString(Fields[m]).compare(Reference[m]) == 0 && (*Strings)[m].compare(Reference[m]) == 0);
+				}
+				delete Strings;
+				Failures += Expect(Same,string("fields of line ")+itoa(i)+" with delimiter set "+itoa(j)+(Consecutive ? " merging" : " keeping")+" empty fields");
+			}
+		}
+	}
+	Failures += Expect(!ReadLine(Reader,Line),"line reader stops after the last line");
+	CloseLineReader(Reader);
+	Input.close();
+	return Failures;
+}
+
+//Picks keys whose hashes share their low eight bits, so they probe from the same slot at every table size the test reaches
+int TestStringDBIndexCollisions() {
+	StringDBIndex Hashes;
+	map<unsigned,vector<string> > KeysBySlot;
+	for (int i=0; i < 20000; i++) {
+		string Key = string("cpd")+itoa(i);
+		KeysBySlot[Hashes.insert(Key.data(),unsigned(Key.length()))->hash & 255].push_back(Key);
+	}
+	vector<string> Colliding = KeysBySlot.begin()->second;
+	int Failures = Expect(Colliding.size() >= 40,"enough colliding keys are generated");
+	if (Failures > 0) {
+		return Failures;
+	}
+	//Keys longer than an arena block are stored separately
+	Colliding.insert(Colliding.begin(),string(20000,'x')+"1");
+	StringDBIndex Index;
+	int Markers[31];
+	vector<StringDBIndexEntry*> Entries;
+	for (int i=0; i < 31; i++) {
+		StringDBIndexEntry* Entry = Index.insert(Colliding[i].data(),unsigned(Colliding[i].length()));
+		Entry->objects.push_back((StringDBObject*)(&Markers[i]));
+		Entries.push_back(Entry);
+	}
+	Failures += Expect(Index.number_of_entries() == 31,"colliding keys are stored once each");
+	for (int i=0; i < 31; i++) {
+		StringDBIndexEntry* Entry = Index.find(Colliding[i].data(),unsigned(Colliding[i].length()));
+		string Label = Colliding[i].substr(0,20);
+		Failures += Expect(Entry == Entries[i],"colliding key "+Label+" finds its own entry after the index grew");
+		Failures += Expect(Entry != NULL && Entry->objects.size() == 1 && Entry->objects[0] == (StringDBObject*)(&Markers[i]) && Colliding[i].compare(string(Entry->key,Entry->length)) == 0,"colliding key "+Label+" keeps its text and objects");
+		Failures += Expect(Index.insert(Colliding[i].data(),unsigned(Colliding[i].length())) == Entries[i],"inserting "+Label+" again returns its entry");
+	}
+	for (int i=31; i < int(Colliding.size()); i++) {
+		Failures += Expect(Index.find(Colliding[i].data(),unsigned(Colliding[i].length())) == NULL,"absent colliding key "+Colliding[i]+" is not found");
+	}
+	string LongKey = string(20000,'x')+"2";
+	Failures += Expect(Index.find(LongKey.data(),unsigned(LongKey.length())) == NULL,"a long key differing in its last character is not found");
+	Failures += Expect(Index.find(Colliding[1].data(),unsigned(Colliding[1].length()-1)) == NULL || Colliding[1].substr(0,Colliding[1].length()-1) == Index.find(Colliding[1].data(),unsigned(Colliding[1].length()-1))->key,"a prefix of a colliding key only finds a key with that exact text");
+	return Failures;
+}
+
+int main(int, char **argv) {
+	SetProgramPath(argv[0]);
+	SetParameter("output index","0");
+	SetParameter("Error filename","stderr.log");
+	setVerbose(false);
+	LoadParameterFile("../etc/Defaults.txt");
+
+	char Template[] = "/tmp/mfatoolkit_test.XXXXXX";
+	if (mkdtemp(Template) == NULL) {
+		cout << "Could not create a test directory" << endl;
+		return 1;
+	}
+	string Directory = string(Template)+"/";
+	string ModelFilename = WriteParallelPathwayNetwork(Directory);
+	if (ModelFilename.length() == 0) {
+		cout << "Could not write the test network to " << Directory << endl;
+		return 1;
+	}
+	LoadParameterFile(Directory+"TestParameters.txt");
+	ClearParameterDependance("CLEAR ALL PARAMETER DEPENDANCE");
+	if (Initialize() != SUCCESS) {
+		cout << "Could not initialize the toolkit" << endl;
+		return 1;
+	}
+
+	int Failures = TestSyntheticLethalKnockouts(ModelFilename);
+	Failures += TestCompiledGeneLogic();
+	Failures += TestFieldTokenizer(Directory);
+	Failures += TestStringDBIndexCollisions();
+	Cleanup();
+	if (Failures > 0) {
+		cout << Failures << " test expectations failed" << endl;
+		return 1;
+	}
+	cout << "All tests passed" << endl;
+	return 0;
+}